@@ -0,0 +1,152 @@
+/*
+ * CryptoMiniSat
+ *
+ * Copyright (c) 2009-2014, Mate Soos. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation
+ * version 2.0 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+*/
+
+#ifndef __BATCHWORKERS_H__
+#define __BATCHWORKERS_H__
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+namespace CMSat {
+
+/**
+@brief A fixed set of threads that works through batches of jobs
+
+The threads are started once and wait between batches, so a pass that runs
+many small batches does not pay for starting threads for each of them. The
+calling thread takes part in every batch as thread 0, hence with one thread
+no threads are started at all.
+*/
+class BatchWorkers
+{
+public:
+    typedef std::function<void(size_t job, size_t thread)> Job;
+
+    explicit BatchWorkers(const size_t num_threads)
+    {
+        for(size_t t = 1; t < num_threads; t++) {
+            threads.push_back(std::thread(&BatchWorkers::worker, this, t));
+        }
+    }
+
+    ~BatchWorkers()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mu);
+            stop = true;
+        }
+        start_cv.notify_all();
+        for(std::thread& thread: threads) {
+            thread.join();
+        }
+    }
+
+    BatchWorkers(const BatchWorkers&) = delete;
+    BatchWorkers& operator=(const BatchWorkers&) = delete;
+
+    size_t num_threads() const
+    {
+        return threads.size() + 1;
+    }
+
+    ///Calls job(i, thread) for every i in [0, num_jobs), returns when all are done
+    void run(const size_t num_jobs, const Job& job)
+    {
+        if (threads.empty() || num_jobs <= 1) {
+            for(size_t i = 0; i < num_jobs; i++) {
+                job(i, 0);
+            }
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mu);
+            cur_job = &job;
+            cur_num_jobs = num_jobs;
+            next = 0;
+            num_busy = threads.size();
+            generation++;
+        }
+        start_cv.notify_all();
+        work(0);
+
+        std::unique_lock<std::mutex> lock(mu);
+        done_cv.wait(lock, [this] { return num_busy == 0; });
+        cur_job = NULL;
+    }
+
+private:
+    void worker(const size_t thread)
+    {
+        uint64_t done_generation = 0;
+        for(;;) {
+            {
+                std::unique_lock<std::mutex> lock(mu);
+                start_cv.wait(lock, [&] {
+                    return stop || generation != done_generation;
+                });
+                if (stop) {
+                    return;
+                }
+                done_generation = generation;
+            }
+
+            work(thread);
+
+            {
+                std::lock_guard<std::mutex> lock(mu);
+                num_busy--;
+            }
+            done_cv.notify_one();
+        }
+    }
+
+    void work(const size_t thread)
+    {
+        size_t i;
+        while((i = next++) < cur_num_jobs) {
+            (*cur_job)(i, thread);
+        }
+    }
+
+    std::vector<std::thread> threads;
+    std::mutex mu;
+    std::condition_variable start_cv;
+    std::condition_variable done_cv;
+    bool stop = false;
+    uint64_t generation = 0;
+    size_t num_busy = 0;
+
+    //Current batch, only written while no thread works on it
+    const Job* cur_job = NULL;
+    size_t cur_num_jobs = 0;
+    std::atomic<size_t> next{0};
+};
+
+} //end namespace
+
+#endif //__BATCHWORKERS_H__
@@ -80,6 +80,13 @@ struct ResolutionTypes
     T redL = 0;
 };
 
+///Tiers of the redundant clause database
+enum RedTier {
+    red_tier_core = 0 ///<Low glue, never cleaned
+    , red_tier_mid = 1 ///<Kept as long as it is used
+    , red_tier_local = 2 ///<Cleaned by activity
+};
+
 struct ClauseStats
 {
     #ifdef STATS_NEEDED
@@ -106,15 +113,17 @@ struct ClauseStats
     #endif
 
     ClauseStats() :
-        glue(0x7fffff)
+        glue(0x3fffff)
         , used_for_uip_creation(0)
         , locked(false)
         , marked_clause(false)
         , ttl(0)
+        , mid_tier(false)
     {}
 
     //Stored data
     double   activity = 0.0;
+    uint32_t last_touched = 0; ///<Conflict number (truncated) it was last used in analysis
     #ifdef STATS_NEEDED
     uint64_t introduced_at_conflict = std::numeric_limits<uint32_t>::max(); ///<At what conflict number the clause  was introduced
     uint32_t conflicts_made = 0; ///<Number of times caused conflict
@@ -123,11 +132,12 @@ struct ClauseStats
     uint64_t visited_literals = 0; ///<Number of literals visited
     uint64_t clause_looked_at = 0; ///<Number of times the clause has been deferenced during propagation
     #endif
-    uint32_t glue:23;
+    uint32_t glue:22;
     uint32_t used_for_uip_creation:6; ///Number of times the claue was using during 1st UIP conflict generation
     uint32_t locked:1;
     uint32_t marked_clause:1;
     uint32_t ttl:1;
+    uint32_t mid_tier:1; ///<In the mid tier unless glue makes it core
 
     ///Number of resolutions it took to make the clause when it was
     ///originally learnt. Only makes sense for redundant clauses
@@ -164,6 +174,8 @@ struct ClauseStats
         #endif
         ret.used_for_uip_creation = first.used_for_uip_creation + second.used_for_uip_creation;
         ret.locked = first.locked | second.locked;
+        ret.mid_tier = first.mid_tier | second.mid_tier;
+        ret.last_touched = std::max(first.last_touched, second.last_touched);
 
         return ret;
     }
@@ -203,6 +215,9 @@ protected:
     uint16_t isFreed:1; ///<Has this clause been marked as freed by the ClauseAllocator ?
     uint16_t is_distilled:1;
     uint16_t occurLinked:1;
+    uint16_t is_imported:1; ///<Imported from another thread, not yet used in conflict analysis
+    uint16_t is_gauss_temp:1; ///<Reason or conflict created by Gaussian elimination, never attached
+    uint16_t alloc_units:9; ///<Size of the slot in ClauseAllocator if it can be reused, 0 otherwise
 
 
     Lit* getData()
@@ -238,6 +253,8 @@ public:
         isRed = false;
         isRemoved = false;
         is_distilled = false;
+        is_imported = false;
+        is_gauss_temp = false;
 
         for (uint32_t i = 0; i < ps.size(); i++) {
             getData()[i] = ps[i];
@@ -378,6 +395,16 @@ public:
         isFreed = true;
     }
 
+    uint32_t get_alloc_units() const
+    {
+        return alloc_units;
+    }
+
+    void set_alloc_units(const uint32_t units)
+    {
+        alloc_units = units;
+    }
+
     void combineStats(const ClauseStats& other)
     {
         stats = ClauseStats::combineStats(stats, other);
@@ -403,6 +430,26 @@ public:
         occurLinked = toset;
     }
 
+    bool imported() const
+    {
+        return is_imported;
+    }
+
+    void set_imported(bool toset)
+    {
+        is_imported = toset;
+    }
+
+    bool gauss_temp_cl() const
+    {
+        return is_gauss_temp;
+    }
+
+    void set_gauss_temp_cl(bool toset)
+    {
+        is_gauss_temp = toset;
+    }
+
     void print_extra_stats() const
     {
         cout
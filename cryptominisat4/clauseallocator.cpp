@@ -23,6 +23,7 @@
 
 #include <string.h>
 #include <limits>
+#include <algorithm>
 #include "assert.h"
 #include "solvertypes.h"
 #include "clause.h"
@@ -30,7 +31,6 @@
 #include "searcher.h"
 #include "time_mem.h"
 #include "simplifier.h"
-#include "completedetachreattacher.h"
 #include "sqlstats.h"
 
 #ifdef USE_VALGRIND
@@ -56,12 +56,22 @@ using std::endl;
 //We shift stuff around in Watched, so not all of 32 bits are useable.
 #define EFFECTIVELY_USEABLE_BITS 30
 #define MAXSIZE ((1 << (EFFECTIVELY_USEABLE_BITS))-1)
+//Freed slots of at most this many BASE_DATA_TYPE-s are handed out again
+#define MAX_REUSED_UNITS 64
+//Consolidation starts at the first segment (of 2^SEGMENT_BITS units) that
+//has at least this ratio of it freed
+#define SEGMENT_BITS 20
+#define SEGMENT_FREED_RATIO 0.3
+//Making freed slots re-usable needs a pass over all watches, so it is only
+//done without compaction once they make up this ratio of the stack
+#define PENDING_FREE_RATIO 0.05
 
 ClauseAllocator::ClauseAllocator() :
     dataStart(NULL)
     , size(0)
     , maxSize(0)
     , currentlyUsedSize(0)
+    , free_slots(MAX_REUSED_UNITS+1)
 {
     assert(MIN_LIST_SIZE < MAXSIZE);
 }
@@ -85,8 +95,10 @@ Clause* ClauseAllocator::Clause_new(
 )
 {
     assert(reconstruct || ps.size() > 3);
-    void* mem = allocEnough(ps.size(), reconstruct);
+    uint32_t alloc_units;
+    void* mem = allocEnough(ps.size(), reconstruct, alloc_units);
     Clause* real= new (mem) Clause(ps, conflictNum);
+    real->set_alloc_units(alloc_units);
 
     return real;
 }
@@ -103,8 +115,10 @@ template Clause* ClauseAllocator::Clause_new(
 Clause* ClauseAllocator::Clause_new(Clause& c)
 {
     assert(c.size() > 3);
-    void* mem = allocEnough(c.size(), false);
+    uint32_t alloc_units;
+    void* mem = allocEnough(c.size(), false, alloc_units);
     memcpy(mem, &c, sizeof(Clause)+sizeof(Lit)*c.size());
+    ((Clause*)mem)->set_alloc_units(alloc_units);
 
     return (Clause*)mem;
 }
@@ -112,6 +126,7 @@ Clause* ClauseAllocator::Clause_new(Clause& c)
 void* ClauseAllocator::allocEnough(
     uint32_t clauseSize
     , bool reconstruct //Are we reconstructing a solution?
+    , uint32_t& alloc_units
 ) {
     assert(reconstruct
         || (clauseSize > 3
@@ -123,6 +138,18 @@ void* ClauseAllocator::allocEnough(
     uint32_t neededbytes = (sizeof(Clause) + sizeof(Lit)*clauseSize);
     uint32_t needed
         = neededbytes/sizeof(BASE_DATA_TYPE) + (bool)(neededbytes % sizeof(BASE_DATA_TYPE));
+    alloc_units = (needed <= MAX_REUSED_UNITS) ? needed : 0;
+
+    //Re-use a freed slot of the same size
+    if (alloc_units != 0 && !free_slots[needed].empty()) {
+        const ClOffset offset = free_slots[needed].back();
+        free_slots[needed].pop_back();
+        segment_freed[offset >> SEGMENT_BITS] -= needed;
+        currentlyUsedSize += needed;
+        stats.slots_reused++;
+
+        return dataStart + offset;
+    }
 
     if (size + needed > maxSize) {
         //Grow by default, but don't go under or over the limits
@@ -203,6 +230,21 @@ void ClauseAllocator::clauseFree(Clause* cl)
     size_t elems_freed = bytes_freed/sizeof(BASE_DATA_TYPE) + (bool)(bytes_freed % sizeof(BASE_DATA_TYPE));
     currentlyUsedSize -= elems_freed;
 
+    //The slot is only re-used once consolidate() is called, as until then
+    //the freed clause may still be referred to
+    const ClOffset offset = get_offset(cl);
+    const size_t segment = offset >> SEGMENT_BITS;
+    if (segment >= segment_freed.size()) {
+        segment_freed.resize(segment+1, 0);
+    }
+    if (cl->get_alloc_units() != 0) {
+        pending_free.push_back(offset);
+        pending_free_units += cl->get_alloc_units();
+        segment_freed[segment] += cl->get_alloc_units();
+    } else {
+        segment_freed[segment] += elems_freed;
+    }
+
     #ifdef VALGRIND_MAKE_MEM_UNDEFINED
     VALGRIND_MAKE_MEM_UNDEFINED(((char*)cl)+sizeof(Clause), cl->size()*sizeof(Lit));
     #endif
@@ -214,13 +256,74 @@ void ClauseAllocator::clauseFree(ClOffset offset)
     clauseFree(cl);
 }
 
+/**
+@brief Finds where compaction should start
+
+This is the first slot in the first segment that has enough freed space in
+it. Everything before it stays in place.
+*/
+ClOffset ClauseAllocator::find_compaction_start(
+    const bool force
+    , size_t& at_slot
+) const {
+    const double min_freed = force ? 0 : SEGMENT_FREED_RATIO*(double)(1ULL << SEGMENT_BITS);
+    size_t segment = 0;
+    while (segment < segment_freed.size()
+        && (segment_freed[segment] == 0 || (double)segment_freed[segment] < min_freed)
+    ) {
+        segment++;
+    }
+    if (segment == segment_freed.size()) {
+        at_slot = origClauseSizes.size();
+        return size;
+    }
+
+    const size_t target = segment << SEGMENT_BITS;
+    size_t pos = 0;
+    at_slot = 0;
+    while (at_slot < origClauseSizes.size() && pos < target) {
+        pos += origClauseSizes[at_slot];
+        at_slot++;
+    }
+
+    return pos;
+}
+
+/**
+@brief Makes the slots freed since the last call available to allocEnough()
+
+Slots at or after 'moved_from' have just been compacted away.
+*/
+void ClauseAllocator::make_freed_slots_reusable(const ClOffset moved_from)
+{
+    if (moved_from < size) {
+        for(vector<ClOffset>& slots: free_slots) {
+            slots.erase(
+                std::remove_if(slots.begin(), slots.end(),
+                    [moved_from](const ClOffset off) { return off >= moved_from; })
+                , slots.end()
+            );
+        }
+    }
+
+    for(const ClOffset offset: pending_free) {
+        if (offset < moved_from) {
+            const uint32_t units = ptr(offset)->get_alloc_units();
+            free_slots[units].push_back(offset);
+        }
+    }
+    pending_free.clear();
+    pending_free_units = 0;
+}
+
 /**
 @brief If needed, compacts stacks, removing unused clauses
 
 Firstly, the algorithm determines if the number of useless slots is large or
-small compared to the problem size. If it is small, it does nothing. If it is
-large, then it allocates new stacks, copies the non-freed clauses to these new
-stacks, updates all pointers and offsets, and frees the original stacks.
+small compared to the problem size. If it is small, it does nothing, apart from
+letting the slots freed since the last call be re-used. If it is large, then it
+compacts the stack from the first fragmented segment onwards, and updates the
+offsets of the clauses that have been moved.
 */
 void ClauseAllocator::consolidate(
     Solver* solver
@@ -239,28 +342,44 @@ void ClauseAllocator::consolidate(
         if (solver->conf.verbosity >= 3) {
             cout << "c Not consolidating memory." << endl;
         }
+
+        //Freed slots can be re-used once nothing refers to them
+        if (solver->decisionLevel() == 0
+            && !pending_free.empty()
+            && (double)pending_free_units >= PENDING_FREE_RATIO*(double)size
+        ) {
+            updateAllOffsetsAndPointers(solver, size, vector<ClOffset>(), vector<ClOffset>());
+            make_freed_slots_reusable(size);
+        }
+        stats.skipped++;
         return;
     }
 
-    //Data for new struct
-    vector<uint32_t> newOrigClauseSizes;
-    vector<ClOffset> newOffsets;
-    uint64_t newSize = 0;
+    size_t at_slot;
+    const ClOffset moved_from = find_compaction_start(force, at_slot);
+    size_t head_freed = 0;
+    for(size_t i = 0; i < (moved_from >> SEGMENT_BITS) && i < segment_freed.size(); i++) {
+        head_freed += segment_freed[i];
+    }
 
-    //Pointers that will be moved along
-    BASE_DATA_TYPE* newDataStart = dataStart;
-    BASE_DATA_TYPE* tmpDataStart = dataStart;
+    //Clauses that are moved
+    vector<ClOffset> old_offsets;
+    vector<ClOffset> new_offsets;
+    size_t newSize = moved_from;
+    size_t oldPos = moved_from;
+    size_t numSlots = at_slot;
 
     assert(sizeof(Clause) % sizeof(BASE_DATA_TYPE) == 0);
     assert(sizeof(BASE_DATA_TYPE) % sizeof(Lit) == 0);
-    for (const size_t sz: origClauseSizes) {
-        Clause* clause = (Clause*)tmpDataStart;
+    for (size_t i = at_slot; i < origClauseSizes.size(); i++) {
+        const size_t sz = origClauseSizes[i];
+        Clause* clause = (Clause*)(dataStart + oldPos);
         //Already freed, so skip entirely
         if (clause->freed()) {
             #ifdef VALGRIND_MAKE_MEM_DEFINED
             VALGRIND_MAKE_MEM_DEFINED(((char*)clause)+sizeof(Clause), clause->size()*sizeof(Lit));
             #endif
-            tmpDataStart += sz;
+            oldPos += sz;
             continue;
         }
 
@@ -268,27 +387,36 @@ void ClauseAllocator::consolidate(
         size_t bytesNeeded = sizeof(Clause) + clause->size()*sizeof(Lit);
         size_t sizeNeeded = bytesNeeded/sizeof(BASE_DATA_TYPE) + (bool)(bytesNeeded % sizeof(BASE_DATA_TYPE));
         assert(sizeNeeded <= sz && "New clause size must not be bigger than orig clause size");
-        memmove(newDataStart, tmpDataStart, sizeNeeded*sizeof(BASE_DATA_TYPE));
+        memmove(dataStart + newSize, dataStart + oldPos, sizeNeeded*sizeof(BASE_DATA_TYPE));
+        ((Clause*)(dataStart + newSize))->set_alloc_units(
+            sizeNeeded <= MAX_REUSED_UNITS ? sizeNeeded : 0);
 
         //Record position
-        newOffsets.push_back(newSize);
+        old_offsets.push_back(oldPos);
+        new_offsets.push_back(newSize);
 
         //Record sizes
-        newOrigClauseSizes.push_back(sizeNeeded);
+        origClauseSizes[numSlots++] = sizeNeeded;
         newSize += sizeNeeded;
-
-        //Move pointers along
-        newDataStart += sizeNeeded;
-        tmpDataStart += sz;
+        oldPos += sz;
     }
+    origClauseSizes.resize(numSlots);
 
     //Update offsets & pointers(?) now, when everything is in memory still
-    updateAllOffsetsAndPointers(solver, newOffsets);
+    updateAllOffsetsAndPointers(solver, moved_from, old_offsets, new_offsets);
+    make_freed_slots_reusable(moved_from);
+    segment_freed.resize(std::min<size_t>(segment_freed.size(), moved_from >> SEGMENT_BITS));
 
     const double time_used = cpuTime() - myTime;
+    stats.consolidations++;
+    stats.cls_moved += old_offsets.size();
+    stats.units_moved += newSize - moved_from;
+    stats.pause_time += time_used;
+    stats.max_pause_time = std::max(stats.max_pause_time, time_used);
     if (solver->conf.verbosity >= 2) {
         cout << "c [mem] Consolidated memory ";
-        cout << " cls"; print_value_kilo_mega(newOrigClauseSizes.size());
+        cout << " moved cls"; print_value_kilo_mega(old_offsets.size());
+        cout << " from"; print_value_kilo_mega(moved_from);
         cout << " old size"; print_value_kilo_mega(size);
         cout << " new size"; print_value_kilo_mega(newSize);
         cout << solver->conf.print_times(time_used)
@@ -304,16 +432,36 @@ void ClauseAllocator::consolidate(
 
     //Update sizes
     size = newSize;
-    currentlyUsedSize = newSize;
-    newOrigClauseSizes.swap(origClauseSizes);
+    currentlyUsedSize = newSize - std::min(head_freed, newSize);
+}
+
+bool ClauseAllocator::update_offset(
+    ClOffset& offset
+    , const ClOffset moved_from
+    , const vector<ClOffset>& old_offsets
+    , const vector<ClOffset>& new_offsets
+) const {
+    if (offset < moved_from) {
+        return true;
+    }
+
+    vector<ClOffset>::const_iterator it =
+        std::lower_bound(old_offsets.begin(), old_offsets.end(), offset);
+    if (it == old_offsets.end() || *it != offset) {
+        return false;
+    }
+    offset = new_offsets[it - old_offsets.begin()];
+
+    return true;
 }
 
 void ClauseAllocator::updateAllOffsetsAndPointers(
     Solver* solver
-    , const vector<ClOffset>& offsets
+    , const ClOffset moved_from
+    , const vector<ClOffset>& old_offsets
+    , const vector<ClOffset>& new_offsets
 ) {
     //Must be at toplevel, otherwise propBy reset will not work
-    //and also, detachReattacher will fail
     assert(solver->decisionLevel() == 0);
 
     //We are at decision level 0, so we can reset all PropBy-s
@@ -321,47 +469,113 @@ void ClauseAllocator::updateAllOffsetsAndPointers(
         vdata.reason = PropBy();
     }
 
-    //Detach long clauses
-    CompleteDetachReatacher detachReattach(solver);
-    detachReattach.detach_nonbins_nontris();
+    //Watches of clauses that have been moved are updated, those of freed
+    //clauses dropped, as their slots may be re-used
+    for(watch_subarray ws: solver->watches) {
+        Watched* i = ws.begin();
+        Watched* j = i;
+        for(Watched* end = ws.end(); i != end; i++) {
+            if (i->isClause()) {
+                ClOffset offset = i->get_offset();
+                if (offset < moved_from) {
+                    if (ptr(offset)->freed()) {
+                        continue;
+                    }
+                } else {
+                    if (!update_offset(offset, moved_from, old_offsets, new_offsets)) {
+                        continue;
+                    }
+                    i->setNormOffset(offset);
+                }
+            }
+            *j++ = *i;
+        }
+        ws.shrink(i-j);
+    }
+    if (moved_from == size) {
+        return;
+    }
 
-    //Make sure all non-freed clauses were accessible from solver
-    const size_t origNumClauses =
-        solver->longIrredCls.size() + solver->longRedCls.size();
-    if (origNumClauses != offsets.size()) {
+    //Make sure all non-freed clauses that moved are accessible from solver
+    size_t num_found = 0;
+    bool all_found = true;
+    for(vector<ClOffset>* cls: {&solver->longIrredCls, &solver->longRedCls}) {
+        for(ClOffset& offset: *cls) {
+            if (offset >= moved_from) {
+                all_found &= update_offset(offset, moved_from, old_offsets, new_offsets);
+                num_found++;
+            }
+        }
+    }
+    if (!all_found || num_found != old_offsets.size()) {
         std::cerr
         << "ERROR: Not all non-freed clauses are accessible from Solver"
         << endl
         << " This usually means that a clause was not freed, i.e. a mem leak"
         << endl
-        << " no. clauses accessible from solver: " << origNumClauses
+        << " no. moved clauses accessible from solver: " << num_found
         << endl
-        << " no. clauses non-freed: " << offsets.size()
+        << " no. moved clauses non-freed: " << old_offsets.size()
         << endl;
 
-        assert(origNumClauses == offsets.size());
+        assert(all_found && num_found == old_offsets.size());
         std::exit(-1);
     }
 
-    //Clear clauses
-    solver->longIrredCls.clear();
-    solver->longRedCls.clear();
+    //Put moved clauses into the right bucket
+    for(int red = 0; red < 2; red++) {
+        vector<ClOffset>& cls = red ? solver->longRedCls : solver->longIrredCls;
+        vector<ClOffset>& other = red ? solver->longIrredCls : solver->longRedCls;
+        size_t j = 0;
+        for(size_t i = 0; i < cls.size(); i++) {
+            const ClOffset offset = cls[i];
+            if (offset >= moved_from && ptr(offset)->red() != (bool)red) {
+                other.push_back(offset);
+                continue;
+            }
+            cls[j++] = offset;
+        }
+        cls.resize(j);
+    }
+}
 
-    //Add back to the solver the correct red & irred clauses
-    for(auto offset: offsets) {
-        Clause* cl = ptr(offset);
-        assert(!cl->freed());
+const ClauseAllocator::Stats& ClauseAllocator::get_stats() const
+{
+    return stats;
+}
 
-        //Put it in the right bucket
-        if (cl->red()) {
-            solver->longRedCls.push_back(offset);
-        } else {
-            solver->longIrredCls.push_back(offset);
-        }
+double ClauseAllocator::fragmentation() const
+{
+    if (size == 0) {
+        return 0;
     }
+    return 1.0 - (double)currentlyUsedSize/(double)size;
+}
 
-    //Finally, reattach long clauses
-    detachReattach.reattachLongs();
+void ClauseAllocator::print_stats() const
+{
+    print_stats_line("c cl-alloc consolidations"
+        , stats.consolidations
+        , stats.skipped
+        , "skipped"
+    );
+    print_stats_line("c cl-alloc pause time"
+        , stats.pause_time
+        , stats.max_pause_time
+        , "s max"
+    );
+    print_stats_line("c cl-alloc moved cls"
+        , stats.cls_moved
+        , (double)(stats.units_moved*sizeof(BASE_DATA_TYPE))/(1024.0*1024.0)
+        , "MB"
+    );
+    print_stats_line("c cl-alloc slots reused"
+        , stats.slots_reused
+    );
+    print_stats_line("c cl-alloc fragmentation"
+        , stats_line_percent(fragmentation(), 1)
+        , "%"
+    );
 }
 
 size_t ClauseAllocator::mem_used() const
@@ -369,6 +583,11 @@ size_t ClauseAllocator::mem_used() const
     uint64_t mem = 0;
     mem += maxSize*sizeof(BASE_DATA_TYPE);
     mem += origClauseSizes.capacity()*sizeof(uint32_t);
+    mem += pending_free.capacity()*sizeof(ClOffset);
+    for(const vector<ClOffset>& slots: free_slots) {
+        mem += slots.capacity()*sizeof(ClOffset);
+    }
+    mem += segment_freed.capacity()*sizeof(size_t);
 
     return mem;
 }
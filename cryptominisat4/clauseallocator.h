@@ -50,6 +50,12 @@ needed. When instructed, it consolidates the unused space (i.e. clauses free()-e
 Essentially, it is a stack-like allocator for clauses. It is useful to have
 this, because this way, we can address clauses according to their number,
 which is 32-bit, instead of their address, which might be 64-bit
+
+Slots of short clauses are size-classed: once a consolidation has made sure
+nothing refers to a freed slot any more, it is handed out again to a new
+clause of the same size. Consolidation only compacts the stack from the
+first segment that is fragmented enough, so clauses before it (and their
+watches) are not touched.
 */
 class ClauseAllocator {
     public:
@@ -80,6 +86,12 @@ class ClauseAllocator {
         void clauseFree(Clause* c); ///Frees memory and associated clause number
         void clauseFree(ClOffset offset);
 
+        /**
+        @brief Compacts the stack, or lets freed slots be re-used
+
+        Only the watches, the reasons in varData and Solver::longIrredCls /
+        longRedCls are remapped. No other ClOffset may be held across a call.
+        */
         void consolidate(
             Solver* solver
             , const bool force = false
@@ -87,11 +99,35 @@ class ClauseAllocator {
 
         size_t mem_used() const;
 
+        struct Stats
+        {
+            uint64_t consolidations = 0;
+            uint64_t skipped = 0;
+            uint64_t slots_reused = 0;
+            uint64_t cls_moved = 0;
+            uint64_t units_moved = 0;
+            double pause_time = 0;
+            double max_pause_time = 0;
+        };
+        const Stats& get_stats() const;
+        double fragmentation() const;
+        void print_stats() const;
+
     private:
         void updateAllOffsetsAndPointers(
             Solver* solver
-            , const vector<ClOffset>& offsets
+            , const ClOffset moved_from
+            , const vector<ClOffset>& old_offsets
+            , const vector<ClOffset>& new_offsets
         );
+        bool update_offset(
+            ClOffset& offset
+            , const ClOffset moved_from
+            , const vector<ClOffset>& old_offsets
+            , const vector<ClOffset>& new_offsets
+        ) const;
+        void make_freed_slots_reusable(const ClOffset moved_from);
+        ClOffset find_compaction_start(const bool force, size_t& at_slot) const;
 
         BASE_DATA_TYPE* dataStart; ///<Stacks start at these positions
         size_t size; ///<The number of BASE_DATA_TYPE datapieces currently used in each stack
@@ -112,7 +148,16 @@ class ClauseAllocator {
         */
         size_t currentlyUsedSize;
 
-        void* allocEnough(const uint32_t size, const bool reconstruct);
+        ///Freed slots that can be handed out again, indexed by their size
+        vector<vector<ClOffset> > free_slots;
+        ///Slots freed since the last consolidation, not yet safe to reuse
+        vector<ClOffset> pending_free;
+        size_t pending_free_units = 0;
+        ///Units freed in each segment of the stack since it was last compacted
+        vector<size_t> segment_freed;
+        Stats stats;
+
+        void* allocEnough(const uint32_t size, const bool reconstruct, uint32_t& alloc_units);
 };
 
 } //end namespace
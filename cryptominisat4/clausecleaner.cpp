@@ -23,6 +23,7 @@
 #include "clauseallocator.h"
 #include "solver.h"
 #include "solvertypesmini.h"
+#include "datasync.h"
 
 using namespace CMSat;
 
@@ -308,6 +309,7 @@ void ClauseCleaner::remove_and_clean_all()
     clean_implicit_clauses();
     clean_clauses(solver->longIrredCls);
     clean_clauses(solver->longRedCls);
+    solver->datasync->remove_stale_imported_tris();
 
     #ifndef NDEBUG
     //Once we have cleaned the watchlists
@@ -275,6 +275,62 @@ void ClauseDumper::dump_clauses(
     }
 }
 
+/**
+@brief Dumps the XORs that are only propagated natively, so have no clauses
+
+Each is cut into XORs of at most 4 variables, linked by fresh variables
+numbered after the solver's, which are then expanded into CNF
+*/
+void ClauseDumper::dump_native_xors()
+{
+    uint32_t next_var = solver->nVarsOuter();
+    vector<Lit> lits;
+    for(const Xor& x: solver->native_xors) {
+        Lit link = lit_Undef;
+        size_t at = 0;
+        for(;;) {
+            lits.clear();
+            if (link != lit_Undef) {
+                lits.push_back(link);
+            }
+            for(; lits.size() < 3 && at < x.vars.size(); at++) {
+                lits.push_back(solver->map_inter_to_outer(Lit(x.vars[at], false)));
+            }
+            if (at + 1 == x.vars.size()) {
+                lits.push_back(solver->map_inter_to_outer(Lit(x.vars[at], false)));
+                at++;
+            }
+
+            if (at == x.vars.size()) {
+                dump_xor_as_cnf(lits, x.rhs);
+                break;
+            }
+            link = Lit(next_var++, false);
+            lits.push_back(link);
+            dump_xor_as_cnf(lits, false);
+        }
+    }
+}
+
+//Forbids every assignment of 'lits' that has the wrong parity
+void ClauseDumper::dump_xor_as_cnf(const vector<Lit>& lits, const bool rhs)
+{
+    for(uint32_t i = 0; i < (1U << lits.size()); i++) {
+        bool parity = false;
+        for(size_t at = 0; at < lits.size(); at++) {
+            parity ^= (i >> at) & 1;
+        }
+        if (parity == rhs) {
+            continue;
+        }
+
+        for(size_t at = 0; at < lits.size(); at++) {
+            *outfile << (lits[at] ^ (bool)((i >> at) & 1)) << " ";
+        }
+        *outfile << "0\n";
+    }
+}
+
 void ClauseDumper::dump_blocked_clauses()
 {
     if (solver->conf.do_bva) {
@@ -330,6 +386,13 @@ void ClauseDumper::dumpIrredClauses()
     << "c ---------------" << endl;
     dump_clauses(solver->longIrredCls);
 
+    *outfile
+    << "c " << endl
+    << "c ---------------" << endl
+    << "c native xor clauses, cut into CNF" << endl
+    << "c ---------------" << endl;
+    dump_native_xors();
+
     *outfile
     << "c " << endl
     << "c -------------------------------" << endl
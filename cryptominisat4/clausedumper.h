@@ -68,6 +68,8 @@ private:
 
     void dump_blocked_clauses();
     void dump_component_clauses();
+    void dump_native_xors();
+    void dump_xor_as_cnf(const vector<Lit>& lits, const bool rhs);
     void dumpIrredClauses();
 
     vector<Lit> tmpCl;
@@ -0,0 +1,156 @@
+/*
+ * CryptoMiniSat
+ *
+ * Copyright (c) 2009-2014, Mate Soos. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation
+ * version 2.0 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+*/
+
+#ifndef CLAUSERING_H
+#define CLAUSERING_H
+
+#include "solvertypesmini.h"
+
+#include <atomic>
+#include <cassert>
+
+namespace CMSat {
+
+/**
+@brief Single-producer, multi-consumer lock-free ring of short clauses
+
+Every thread owns one ring and is the only one pushing into it. Any other
+thread may read it at any time, keeping its own cursor. Slots are protected
+by a sequence number (seqlock): a reader that races with the producer
+overwriting the slot it reads simply drops that clause. Readers that fall
+behind by more than the ring size lose the clauses that were overwritten.
+*/
+class ClauseRing
+{
+public:
+    static const uint32_t max_lits = 16;
+
+    explicit ClauseRing(uint32_t size) :
+        mask(round_up_pow2(size) - 1)
+        , slots(new Slot[mask + 1])
+    {
+        for(uint64_t i = 0; i <= mask; i++) {
+            slots[i].seq.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    ~ClauseRing()
+    {
+        delete[] slots;
+    }
+
+    ClauseRing(const ClauseRing&) = delete;
+    ClauseRing& operator=(const ClauseRing&) = delete;
+
+    //Only to be called by the owner thread
+    void push(const Lit* lits, const uint32_t size, const uint32_t glue)
+    {
+        assert(size <= max_lits);
+        const uint64_t pos = head.load(std::memory_order_relaxed);
+        Slot& slot = slots[pos & mask];
+
+        slot.seq.store(2*pos + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.size.store(size, std::memory_order_relaxed);
+        slot.glue.store(glue, std::memory_order_relaxed);
+        for(uint32_t i = 0; i < size; i++) {
+            slot.lits[i].store(lits[i].toInt(), std::memory_order_relaxed);
+        }
+        slot.seq.store(2*pos + 2, std::memory_order_release);
+        head.store(pos + 1, std::memory_order_release);
+    }
+
+    /**
+    @brief Reads all clauses pushed since 'cursor', calls f(lits, size, glue)
+
+    @returns the new cursor. 'lost' is increased with the number of clauses
+    that have been overwritten before they could be read.
+    */
+    template<class F>
+    uint64_t read_from(uint64_t cursor, F& f, uint32_t& lost) const
+    {
+        const uint64_t h = head.load(std::memory_order_acquire);
+        if (h - cursor > mask + 1) {
+            lost += h - cursor - (mask + 1);
+            cursor = h - (mask + 1);
+        }
+
+        Lit lits[max_lits];
+        for(; cursor < h; cursor++) {
+            const Slot& slot = slots[cursor & mask];
+            const uint64_t seq = slot.seq.load(std::memory_order_acquire);
+            if (seq != 2*cursor + 2) {
+                lost++;
+                continue;
+            }
+
+            const uint32_t size = slot.size.load(std::memory_order_relaxed);
+            const uint32_t glue = slot.glue.load(std::memory_order_relaxed);
+            for(uint32_t i = 0; i < size && i < max_lits; i++) {
+                lits[i] = Lit::toLit(slot.lits[i].load(std::memory_order_relaxed));
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) != seq) {
+                lost++;
+                continue;
+            }
+
+            f(lits, size, glue);
+        }
+
+        return cursor;
+    }
+
+    uint64_t num_pushed() const
+    {
+        return head.load(std::memory_order_relaxed);
+    }
+
+    size_t mem_used() const
+    {
+        return (mask + 1)*sizeof(Slot);
+    }
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> seq;
+        std::atomic<uint32_t> size;
+        std::atomic<uint32_t> glue;
+        std::atomic<uint32_t> lits[max_lits];
+    };
+
+    static uint64_t round_up_pow2(uint32_t size)
+    {
+        uint64_t ret = 1;
+        while(ret < size) {
+            ret <<= 1;
+        }
+        return ret;
+    }
+
+    const uint64_t mask;
+    Slot* slots;
+    std::atomic<uint64_t> head{0};
+};
+
+}
+
+#endif //CLAUSERING_H
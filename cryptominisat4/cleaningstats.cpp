@@ -45,6 +45,17 @@ void CleaningStats::print(const size_t nbReduceDB, const double total_cpu_time)
         );
     }
 
+    print_stats_line("c reduceDB sort time"
+        , sort_time
+        , stats_line_percent(sort_time, cpu_time)
+        , "% reduceDB time"
+    );
+    print_stats_line("c reduceDB cl lookups"
+        , clause_lookups
+        , ratio_for_stat(clause_lookups, origNumClauses)
+        , "per long red cl"
+    );
+
     //-->CLEAN
     print_stats_line("c cleaned cls"
         , removed.num
@@ -80,6 +91,34 @@ void CleaningStats::print(const size_t nbReduceDB, const double total_cpu_time)
     print_stats_line("c remain avg glue"
         , ratio_for_stat(remain.glue, remain.num)
     );
+    print_stats_line("c remain core tier cls"
+        , remain_in_tier[red_tier_core]
+        , stats_line_percent(remain_in_tier[red_tier_core], remain.num)
+        , "% remain cls"
+    );
+    print_stats_line("c remain mid tier cls"
+        , remain_in_tier[red_tier_mid]
+        , stats_line_percent(remain_in_tier[red_tier_mid], remain.num)
+        , "% remain cls"
+    );
+    print_stats_line("c remain local tier cls"
+        , remain_in_tier[red_tier_local]
+        , stats_line_percent(remain_in_tier[red_tier_local], remain.num)
+        , "% remain cls"
+    );
+
+    //--> MID TIER
+    print_stats_line("c mid tier reduces"
+        , mid_tier_reduces
+    );
+    print_stats_line("c mid tier demoted cls"
+        , mid_tier_demoted
+        , ratio_for_stat(mid_tier_demoted, mid_tier_reduces)
+        , "per reduce"
+    );
+    print_stats_line("c mid tier time"
+        , mid_tier_time
+    );
 
     cout << "c ------ REDUCEDB STATS END ---------" << endl;
 }
@@ -118,6 +157,8 @@ CleaningStats& CleaningStats::operator+=(const CleaningStats& other)
 {
     //Time
     cpu_time += other.cpu_time;
+    sort_time += other.sort_time;
+    clause_lookups += other.clause_lookups;
 
     //Before remove
     origNumClauses += other.origNumClauses;
@@ -126,6 +167,14 @@ CleaningStats& CleaningStats::operator+=(const CleaningStats& other)
     //Clause Cleaning data
     removed += other.removed;
     remain += other.remain;
+    for(size_t i = 0; i < 3; i++) {
+        remain_in_tier[i] += other.remain_in_tier[i];
+    }
+
+    //Mid tier
+    mid_tier_reduces += other.mid_tier_reduces;
+    mid_tier_demoted += other.mid_tier_demoted;
+    mid_tier_time += other.mid_tier_time;
 
     return *this;
 }
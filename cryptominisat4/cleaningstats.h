@@ -101,6 +101,10 @@ struct CleaningStats
 
     double cpu_time = 0;
 
+    //Picking the clauses to keep/lock
+    double sort_time = 0;
+    uint64_t clause_lookups = 0;
+
     //Before remove
     uint64_t origNumClauses = 0;
     uint64_t origNumLits = 0;
@@ -108,6 +112,12 @@ struct CleaningStats
     //Clause Cleaning
     Data removed;
     Data remain;
+    uint64_t remain_in_tier[3] = {0, 0, 0}; ///<Indexed by RedTier
+
+    //Mid tier demotion, has its own interval
+    uint64_t mid_tier_reduces = 0;
+    uint64_t mid_tier_demoted = 0;
+    double mid_tier_time = 0;
 };
 
 }
@@ -231,6 +231,46 @@ uint64_t CNF::print_mem_used_longclauses(const size_t totalMem) const
     return mem;
 }
 
+double CNF::time_left() const
+{
+    const double used = conf.maxTimeIsWall ? wallTime() - startWallTime : cpuTime();
+    return conf.maxTime - used;
+}
+
+/**
+@brief Checks the time limit, mostly only reading the coarse wall clock
+
+The CPU time of a thread can't grow faster than the wall clock, so after a
+check, the limit can't be reached before what was left of it passes on the
+wall clock. Until then, cpuTime() is not called at all. This does not hold
+where cpuTime() is that of the whole process, which has many threads.
+*/
+bool CNF::out_of_time() const
+{
+    #ifdef CPU_TIME_IS_PER_THREAD
+    const bool can_skip = true;
+    #else
+    const bool can_skip = conf.maxTimeIsWall;
+    #endif
+
+    const double now = wallTime();
+    if (can_skip
+        && now < nextTimeCheck
+        && conf.maxTime == checkedMaxTime
+    ) {
+        return false;
+    }
+
+    const double used = conf.maxTimeIsWall ? now - startWallTime : cpuTime();
+    if (used > conf.maxTime) {
+        return true;
+    }
+    nextTimeCheck = now + (conf.maxTime - used);
+    checkedMaxTime = conf.maxTime;
+
+    return false;
+}
+
 bool CNF::redundant(const Watched& ws) const
 {
     return (   (ws.isBinary() && ws.red())
@@ -32,6 +32,7 @@
 #include "drup.h"
 #include "clauseallocator.h"
 #include "varupdatehelper.h"
+#include "time_mem.h"
 
 namespace CMSat {
 using namespace CMSat;
@@ -70,6 +71,7 @@ public:
         if (_conf != NULL) {
             conf = *_conf;
         }
+        implCache.set_max_mem((size_t)conf.maxCacheSizeMB*1024UL*1024UL);
         drup = new Drup();
         if (_needToInterrupt != NULL) {
             needToInterrupt = _needToInterrupt;
@@ -105,6 +107,8 @@ public:
     int64_t num_red_cls_reducedb = 0;
     bool red_long_cls_is_reducedb(const Clause& cl) const;
     int64_t count_num_red_cls_reducedb() const;
+    RedTier red_tier(const Clause& cl) const;
+    void promote_to_mid_tier_if_needed(Clause& cl) const;
 
     vector<ClOffset> longRedCls;          ///< List of redundant clauses.
     BinTriStats binTri;
@@ -151,6 +155,10 @@ public:
         return needToInterrupt;
     }
 
+    //Whether conf.maxTime is used up. Cheap enough to be called often
+    bool out_of_time() const;
+    double time_left() const;
+
     bool clause_locked(const Clause& c, const ClOffset offset) const;
     void unmark_all_irred_clauses();
     void unmark_all_red_clauses();
@@ -262,6 +270,9 @@ private:
     void swapVars(const Var which, const int off_by = 0);
 
     bool needToInterrupt_is_foreign;
+    double startWallTime = wallTime();
+    mutable double nextTimeCheck = 0; ///<conf.maxTime can't be used up before this wall time
+    mutable double checkedMaxTime = 0; ///<conf.maxTime that nextTimeCheck was set for
     vector<Var> outerToInterMain;
     vector<Var> interToOuterMain;
     size_t num_bva_vars = 0;
@@ -463,7 +474,23 @@ inline void CNF::renumber_outer_to_inter_lits(vector<Lit>& ps) const
 inline bool CNF::red_long_cls_is_reducedb(const Clause& cl) const
 {
     assert(cl.red());
-    return cl.stats.glue > conf.glue_must_keep_clause_if_below_or_eq && !cl.stats.locked && cl.stats.ttl == 0;
+    return red_tier(cl) == red_tier_local && !cl.stats.locked && cl.stats.ttl == 0;
+}
+
+inline RedTier CNF::red_tier(const Clause& cl) const
+{
+    assert(cl.red());
+    if (cl.stats.glue <= conf.glue_must_keep_clause_if_below_or_eq) {
+        return red_tier_core;
+    }
+    return cl.stats.mid_tier ? red_tier_mid : red_tier_local;
+}
+
+inline void CNF::promote_to_mid_tier_if_needed(Clause& cl) const
+{
+    if (cl.stats.glue <= conf.glue_put_mid_tier_if_below_or_eq) {
+        cl.stats.mid_tier = true;
+    }
 }
 
 inline int64_t CNF::count_num_red_cls_reducedb() const
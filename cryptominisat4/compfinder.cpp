@@ -24,6 +24,7 @@
 #include <map>
 #include <iomanip>
 #include <iostream>
+#include <thread>
 #include "compfinder.h"
 #include "time_mem.h"
 #include "cloffset.h"
@@ -47,26 +48,10 @@ using std::endl;
 //#define PART_FINDING
 
 CompFinder::CompFinder(Solver* _solver) :
-    timedout(false)
-    , seen(_solver->seen)
-    , solver(_solver)
+    solver(_solver)
 {
 }
 
-void CompFinder::time_out_print(const double myTime) const
-{
-    if (solver->conf.verbosity >= 2) {
-        cout
-        << "c [comp] Timed out finding components "
-        << "BP: "
-        << std::setprecision(2) << std::fixed
-        << (double)(orig_bogoprops-bogoprops_remain)/(1000.0*1000.0)
-        << "M"
-        << solver->conf.print_times(cpuTime() - myTime)
-        << endl;
-    }
-}
-
 void CompFinder::print_found_components() const
 {
     size_t notPrinted = 0;
@@ -119,25 +104,24 @@ bool CompFinder::find_components()
     table.clear();
     table.resize(solver->nVars(), std::numeric_limits<uint32_t>::max());
     reverseTable.clear();
-    comp_no = 0;
-    used_comp_no = 0;
-
-    solver->clauseCleaner->remove_and_clean_all();
 
+    //Replacing can set variables, so clean afterwards: assigned variables
+    //must not end up in any component
     if (solver->conf.doFindAndReplaceEqLits
         && !solver->varReplacer->replace_if_enough_is_found()
     ) {
         return false;
     }
+    solver->clauseCleaner->remove_and_clean_all();
+
+    parent = vector<std::atomic<Var> >(solver->nVars());
+    for(size_t var = 0; var < parent.size(); var++) {
+        parent[var].store(var, std::memory_order_relaxed);
+    }
+    link_in_parallel();
+    fill_tables();
+    parent = vector<std::atomic<Var> >();
 
-    //Add the clauses to the sets
-    bogoprops_remain =
-        solver->conf.comp_find_time_limitM*1000ULL*1000ULL
-        *solver->conf.global_timeout_multiplier;
-    orig_bogoprops = bogoprops_remain;
-    timedout = false;
-    add_clauses_to_component(solver->longIrredCls);
-    addToCompImplicits();
     print_and_add_to_sql_result(myTime);
 
     return solver->okay();
@@ -146,240 +130,179 @@ bool CompFinder::find_components()
 void CompFinder::print_and_add_to_sql_result(const double myTime) const
 {
     const double time_used = cpuTime() - myTime;
-    const double time_remain = (double)bogoprops_remain/((double)orig_bogoprops);
-
-    if (timedout) {
-        time_out_print(myTime);
-    } else {
-        assert(reverse_table_is_correct());
+    assert(reverse_table_is_correct());
 
-        if (solver->conf.verbosity >= 2
-            || (solver->conf.verbosity >=1 && used_comp_no > 1)
-        ) {
-            cout
-            << "c [comp] Found component(s): " <<  reverseTable.size()
-            << " BP: "
-            << std::setprecision(2) << std::fixed
-            << (double)(orig_bogoprops-bogoprops_remain)/(1000.0*1000.0)<< "M"
-            << " T-r: " << time_remain*100.0 << "%"
-            << solver->conf.print_times(time_used)
-            << endl;
+    if (solver->conf.verbosity >= 2
+        || (solver->conf.verbosity >=1 && reverseTable.size() > 1)
+    ) {
+        cout
+        << "c [comp] Found component(s): " <<  reverseTable.size()
+        << solver->conf.print_times(time_used)
+        << endl;
 
-            if (reverseTable.size() != 1) {
-                print_found_components();
-            }
+        if (reverseTable.size() != 1) {
+            print_found_components();
         }
     }
 
     if (solver->sqlStats) {
-        solver->sqlStats->time_passed(
+        solver->sqlStats->time_passed_min(
             solver
             , "compfinder"
             , time_used
-            , timedout
-            , time_remain
         );
      }
 }
 
-void CompFinder::add_clauses_to_component(const vector<ClOffset>& cs)
+/**
+@brief Returns the root of the tree of var, halving the path on the way
+
+Parents only ever point to smaller variables, and only roots are re-linked, so
+the tree can be walked and halved while other threads link other roots.
+*/
+Var CompFinder::find_root(Var var)
 {
-    for (ClOffset offset: cs) {
-        if (bogoprops_remain <= 0) {
-            timedout = true;
-            break;
+    Var par = parent[var].load(std::memory_order_relaxed);
+    while(par != var) {
+        const Var grandpar = parent[par].load(std::memory_order_relaxed);
+        if (grandpar != par) {
+            parent[var].store(grandpar, std::memory_order_relaxed);
         }
-        bogoprops_remain -= 10;
-        Clause* cl = solver->cl_alloc.ptr(offset);
-        add_clause_to_component(*cl);
+        var = grandpar;
+        par = parent[var].load(std::memory_order_relaxed);
     }
+
+    return var;
 }
 
-void CompFinder::addToCompImplicits()
+void CompFinder::link(Var a, Var b)
 {
-    vector<Lit> lits;
-    vector<uint16_t>& seen = solver->seen;
-
-    for (size_t var = 0; var < solver->nVars(); var++) {
-        if (bogoprops_remain <= 0) {
-            timedout = true;
-            break;
+    while(true) {
+        a = find_root(a);
+        b = find_root(b);
+        if (a == b) {
+            return;
         }
 
-        bogoprops_remain -= 2;
-        Lit lit(var, false);
-        lits.clear();
-        lits.push_back(lit);
-        for(int sign = 0; sign < 2; sign++) {
-            lit = Lit(var, sign);
-            watch_subarray ws = solver->watches[lit.toInt()];
-
-            //If empty, skip
-            if (ws.empty())
-                continue;
-
-            bogoprops_remain -= ws.size() + 10;
-            for(watch_subarray::const_iterator
-                it2 = ws.begin(), end2 = ws.end()
-                ; it2 != end2
-                ; it2++
-            ) {
-                if (it2->isBinary()
-                    //Only irred
-                    && !it2->red()
-                    //Only do each binary once
-                    && lit < it2->lit2()
-                ) {
-                    if (!seen[it2->lit2().var()]) {
-                        lits.push_back(it2->lit2());
-                        seen[it2->lit2().var()] = 1;
-                    }
-                }
-
-                if (it2->isTri()
-                    //irredundant
-                    && !it2->red()
-                    //Only do each tri once
-                    && lit < it2->lit3()
-                    && it2->lit2() < it2->lit3()
-                ) {
-                    if (!seen[it2->lit2().var()]) {
-                        lits.push_back(it2->lit2());
-                        seen[it2->lit2().var()] = 1;
-                    }
-
-                    if (!seen[it2->lit3().var()]) {
-                        lits.push_back(it2->lit3());
-                        seen[it2->lit3().var()] = 1;
-                    }
-                }
-            }
+        //The larger root goes under the smaller one, so there are no cycles
+        if (a < b) {
+            std::swap(a, b);
         }
-
-        if (lits.size() > 1) {
-            //Clear seen
-            for(vector<Lit>::const_iterator
-                it = lits.begin(), end = lits.end()
-                ; it != end
-                ; ++it
-            ) {
-                seen[it->var()] = 0;
-            }
-
-            add_clause_to_component(lits);
+        Var expected = a;
+        if (parent[a].compare_exchange_weak(expected, b)) {
+            return;
         }
-
     }
 }
 
-template<class T>
-bool CompFinder::belong_to_same_component(const T& cl)
+void CompFinder::link_long_clauses(const size_t from, const size_t to)
 {
-    if (table[cl[0].var()] != std::numeric_limits<uint32_t>::max()) {
-        bogoprops_remain -= cl.size()/2 + 1;
-        const uint32_t comp = table[cl[0].var()];
-
-        for (const Lit l: cl) {
-            if (table[l.var()] != comp) {
-                return false;
-            }
+    for(size_t i = from; i < to; i++) {
+        const Clause& cl = *solver->cl_alloc.ptr(solver->longIrredCls[i]);
+        for(size_t i2 = 1; i2 < cl.size(); i2++) {
+            link(cl[0].var(), cl[i2].var());
         }
-
-        return true;
     }
-
-    return false;
 }
 
-template<class T>
-void CompFinder::fill_newset_and_tomerge(const T& cl)
+void CompFinder::link_implicit_clauses(const size_t from, const size_t to)
 {
-    bogoprops_remain -= cl.size()*2;
-
-    for (const Lit lit: cl) {
-        if (table[lit.var()] != std::numeric_limits<uint32_t>::max()
-        ) {
-            if (!seen[table[lit.var()]]) {
-                tomerge.push_back(table[lit.var()]);
-                seen[table[lit.var()]] = 1;
+    for (size_t var = from; var < to; var++) {
+        for(unsigned sign = 0; sign < 2; sign++) {
+            const Lit lit = Lit(var, sign);
+            watch_subarray_const ws = solver->watches[lit.toInt()];
+            for(const Watched& w: ws) {
+                //Only irred, and each clause from its smallest literal only
+                if (w.isBinary()
+                    && !w.red()
+                    && lit < w.lit2()
+                ) {
+                    link(var, w.lit2().var());
+                }
+
+                if (w.isTri()
+                    && !w.red()
+                    && lit < w.lit2()
+                    && lit < w.lit3()
+                ) {
+                    link(var, w.lit2().var());
+                    link(var, w.lit3().var());
+                }
             }
-        } else {
-            newSet.push_back(lit.var());
         }
     }
 }
 
-void CompFinder::merge_newset_into_single_component()
-{
-    const uint32_t into = tomerge[0];
-    seen[into] = 0;
-    map<uint32_t, vector<Var> >::iterator intoReverse
-        = reverseTable.find(into);
-
-    //Put the new lits into this set
-    for (const Var v: newSet) {
-        intoReverse->second.push_back(v);
-        table[v] = into;
-    }
-}
-
-template<class T>
-void CompFinder::add_clause_to_component(const T& cl)
+void CompFinder::link_in_parallel()
 {
-    assert(cl.size() > 1);
-    tomerge.clear();
-    newSet.clear();
-
-    if (belong_to_same_component(cl)) {
+    //Chunks of long clauses come first, then ranges of variables
+    const size_t cls_chunk = 2000;
+    const size_t vars_chunk = 5000;
+    const size_t num_cls = solver->longIrredCls.size();
+    const size_t num_cls_chunks = (num_cls + cls_chunk - 1)/cls_chunk;
+    const size_t num_chunks =
+        num_cls_chunks + (solver->nVars() + vars_chunk - 1)/vars_chunk;
+
+    std::atomic<size_t> next(0);
+    auto worker = [&] {
+        size_t i;
+        while((i = next++) < num_chunks) {
+            if (i < num_cls_chunks) {
+                const size_t from = i*cls_chunk;
+                link_long_clauses(from, std::min(num_cls, from + cls_chunk));
+            } else {
+                const size_t from = (i - num_cls_chunks)*vars_chunk;
+                link_implicit_clauses(
+                    from
+                    , std::min<size_t>(solver->nVars(), from + vars_chunk)
+                );
+            }
+        }
+    };
+
+    const size_t num_threads = std::min<size_t>(
+        std::max(1U, solver->conf.comp_threads)
+        , num_chunks
+    );
+    if (num_threads <= 1) {
+        worker();
         return;
     }
 
-    fill_newset_and_tomerge(cl);
-
-    //no sets to merge, only merge the clause into one tree
-    if (tomerge.size() == 1) {
-        merge_newset_into_single_component();
-        return;
+    std::vector<std::thread> thds;
+    for(size_t t = 0; t < num_threads; t++) {
+        thds.push_back(std::thread(worker));
     }
+    for(std::thread& thd: thds) {
+        thd.join();
+    }
+}
 
-    //Expensive merging coming up
-    bogoprops_remain -= 20;
-
-    //Delete tables to merge and put their elements into newSet
-    for (const uint32_t merge: tomerge) {
-        //Clear seen
-        seen[merge] = 0;
-
-        //Find in reverseTable
-        bogoprops_remain -= reverseTable.size()*2;
-        map<uint32_t, vector<Var> >::iterator it2 = reverseTable.find(merge);
-        assert(it2 != reverseTable.end());
-
-        //Add them all
-        bogoprops_remain -= it2->second.size();
-        newSet.insert(
-            newSet.end()
-            , it2->second.begin()
-            , it2->second.end()
-        );
+/**
+@brief Numbers the components in the order of their smallest variable
 
-        //Delete this comp
-        bogoprops_remain -= reverseTable.size();
-        reverseTable.erase(it2);
-        used_comp_no--;
+Variables that are in no clause are in no component. Every clause has at least
+two variables, so these are exactly the roots with no other variable below.
+*/
+void CompFinder::fill_tables()
+{
+    vector<uint32_t> comp_size(solver->nVars(), 0);
+    for(size_t var = 0; var < solver->nVars(); var++) {
+        comp_size[find_root(var)]++;
     }
 
-    //No literals lie outside of already seen components
-    if (newSet.empty())
-        return;
+    uint32_t comp_no = 0;
+    for(size_t var = 0; var < solver->nVars(); var++) {
+        const Var root = find_root(var);
+        if (comp_size[root] < 2) {
+            continue;
+        }
 
-    //Mark all lits not belonging to seen components as belonging to comp_no
-    bogoprops_remain -= newSet.size();
-    for (const Var v: newSet) {
-        table[v] = comp_no;
+        //The root is the smallest variable, so it's numbered first
+        if (root == var) {
+            table[var] = comp_no++;
+        }
+        table[var] = table[root];
+        reverseTable[table[var]].push_back(var);
     }
-
-    reverseTable[comp_no] = newSet;
-    comp_no++;
-    used_comp_no++;
 }
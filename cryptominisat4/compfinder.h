@@ -24,6 +24,7 @@
 
 #include <vector>
 #include <map>
+#include <atomic>
 #include "constants.h"
 #include "solvertypes.h"
 #include "cloffset.h"
@@ -37,12 +38,19 @@ using std::map;
 using std::vector;
 using std::pair;
 
+/**
+@brief Finds the disconnected components of the irredundant clauses
+
+Uses a union-find over the variables, with path halving. The long clauses are
+split into chunks and the watchlists into ranges of variables, and these are
+linked on conf.comp_threads threads at the same time. A pass is linear in the
+size of the problem, so there is no time limit.
+*/
 class CompFinder {
 
     public:
         CompFinder(Solver* solver);
         bool find_components();
-        bool getTimedOut() const;
 
         const map<uint32_t, vector<Var> >& getReverseTable() const; // comp->var
         uint32_t getVarComp(const Var var) const;
@@ -50,83 +58,50 @@ class CompFinder {
         const vector<Var>& getCompVars(const uint32_t comp);
 
     private:
-        void addToCompImplicits();
-        void add_clauses_to_component(const vector<ClOffset>& cs);
-        template<class T>
-        void add_clause_to_component(const T& cl);
-        template<class T>
-        bool belong_to_same_component(const T& cl);
-        template<class T>
-        void fill_newset_and_tomerge(const T& cl);
-        void merge_newset_into_single_component();
-
-        void time_out_print(const double myTime) const;
+        //Union-find
+        Var find_root(Var var);
+        void link(Var a, Var b);
+        void link_long_clauses(const size_t from, const size_t to);
+        void link_implicit_clauses(const size_t from, const size_t to);
+        void link_in_parallel();
+        void fill_tables();
+
         void print_found_components() const;
         bool reverse_table_is_correct() const;
         void print_and_add_to_sql_result(const double myTime) const;
 
-        struct MySorter
-        {
-            bool operator () (
-                const pair<uint32_t, uint32_t>& left
-                , const pair<uint32_t, uint32_t>& right
-            ) {
-                return left.second < right.second;
-            }
-        };
-
         //comp -> vars
         map<uint32_t, vector<Var> > reverseTable;
 
         //var -> comp
         vector<uint32_t> table;
 
-        //The comp counter
-        uint32_t comp_no;
-        uint32_t used_comp_no;
-
-        //Temporary
-        vector<Var> newSet;
-        vector<uint32_t> tomerge;
+        //var -> parent in the union-find, roots point to themselves
+        vector<std::atomic<Var> > parent;
 
-        //Keep track of time
-        long long bogoprops_remain;
-        long long orig_bogoprops;
-        bool timedout;
-
-        vector<uint16_t>& seen;
         Solver* solver;
 };
 
 inline const map<uint32_t, vector<Var> >& CompFinder::getReverseTable() const
 {
-    assert(!timedout);
     return reverseTable;
 }
 
 inline const vector<Var>& CompFinder::getTable() const
 {
-    assert(!timedout);
     return table;
 }
 
 inline uint32_t CompFinder::getVarComp(const Var var) const
 {
-    assert(!timedout);
     return table[var];
 }
 
 inline const vector<Var>& CompFinder::getCompVars(const uint32_t comp)
 {
-    assert(!timedout);
     return reverseTable[comp];
 }
 
-inline bool CompFinder::getTimedOut() const
-{
-    return timedout;
-}
-
 } //End namespace
 
 #endif //PARTFINDER_H
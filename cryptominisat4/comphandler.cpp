@@ -32,6 +32,9 @@
 #include <iomanip>
 #include "cryptominisat.h"
 #include "sqlstats.h"
+#include <thread>
+#include <atomic>
+#include <chrono>
 
 using namespace CMSat;
 using std::make_pair;
@@ -96,10 +99,13 @@ void CompHandler::createRenumbering(const vector<Var>& vars)
     }
 }
 
-bool CompHandler::assumpsInsideComponent(const vector<Var>& vars)
+bool CompHandler::assumpsOrFrozenInsideComponent(const vector<Var>& vars)
 {
     for(Var var: vars) {
-        if (solver->var_inside_assumptions(var)) {
+        if (solver->var_inside_assumptions(var)
+            || solver->varData[var].frozen
+            || solver->varData[var].in_xor
+        ) {
             return true;
         }
     }
@@ -134,13 +140,12 @@ bool CompHandler::handle()
 {
     assert(solver->okay());
     double myTime = cpuTime();
+    //A finder may be left over from a round that stopped early
+    delete compFinder;
     compFinder = new CompFinder(solver);
     if (!compFinder->find_components()) {
         return false;
     }
-    if (compFinder->getTimedOut()) {
-        return solver->okay();
-    }
 
     const uint32_t num_comps = compFinder->getReverseTable().size();
 
@@ -158,17 +163,37 @@ bool CompHandler::handle()
     assert(num_comps == compFinder->getReverseTable().size());
     vector<pair<uint32_t, uint32_t> > sizes = get_component_sizes();
 
+    //The biggest component stays in the main solver. Smallest first, except
+    //with more threads, where the long solves should start early
+    const size_t num_threads = std::max(1U, solver->conf.comp_threads);
+    vector<CompJob> jobs;
+    for (uint32_t i = 0; i < sizes.size()-1; i++) {
+        const uint32_t it = (num_threads == 1) ? i : sizes.size()-2-i;
+        const uint32_t comp = sizes[it].first;
+        const vector<Var>& vars = reverseTable[comp];
+        if (component_can_be_moved(vars)) {
+            jobs.push_back(CompJob(it, comp, vars));
+        }
+    }
+
+    //Only a batch of sub-solvers is alive at any one time, to bound memory
+    const size_t batch_size = (num_threads == 1) ? 1 : num_threads*16;
     size_t num_comps_solved = 0;
     size_t vars_solved = 0;
-    for (uint32_t it = 0; it < sizes.size()-1; ++it) {
-        const uint32_t comp = sizes[it].first;
-        vector<Var>& vars = reverseTable[comp];
-        const bool cont = try_to_solve_component(it, comp, vars, num_comps);
+    for (size_t at = 0; at < jobs.size(); at += batch_size) {
+        const size_t end = std::min(jobs.size(), at + batch_size);
+        for(size_t i = at; i < end; i++) {
+            create_subsolver(jobs[i], num_threads > 1);
+        }
+        solve_subsolvers(jobs, at, end, num_comps);
+        const bool cont = merge_subsolvers(jobs, at, end, num_comps);
         if (!cont) {
             break;
         }
-        num_comps_solved++;
-        vars_solved += vars.size();
+        for(size_t i = at; i < end; i++) {
+            num_comps_solved++;
+            vars_solved += jobs[i].vars.size();
+        }
     }
 
     if (!solver->okay())
@@ -200,94 +225,182 @@ bool CompHandler::handle()
     return true;
 }
 
-bool CompHandler::try_to_solve_component(
-    const uint32_t comp_at
-    , const uint32_t comp
-    , const vector<Var>& vars_orig
-    , const size_t num_comps
-) {
-    for(const Var var: vars_orig) {
+CompHandler::CompJob::CompJob(
+    const uint32_t _comp_at
+    , const uint32_t _comp
+    , const vector<Var>& _vars
+) :
+    comp_at(_comp_at)
+    , comp(_comp)
+    , vars(_vars)
+{
+    std::sort(vars.begin(), vars.end());
+}
+
+bool CompHandler::component_can_be_moved(const vector<Var>& vars)
+{
+    for(const Var var: vars) {
         assert(solver->value(var) == l_Undef);
     }
 
-    if (vars_orig.size() > 100ULL*1000ULL) {
+    if (vars.size() > 100ULL*1000ULL) {
         //There too many variables -- don't create a sub-solver
         //I'm afraid that we will memory-out
 
-        return true;
+        return false;
     }
 
-    //Components with assumptions should not be removed
-    if (assumpsInsideComponent(vars_orig))
-        return true;
+    //Components with assumptions or frozen vars should not be removed
+    if (assumpsOrFrozenInsideComponent(vars))
+        return false;
 
-    return solve_component(comp_at, comp, vars_orig, num_comps);
+    return true;
 }
 
-bool CompHandler::solve_component(
-    const uint32_t comp_at
-    , const uint32_t comp
-    , const vector<Var>& vars_orig
+void CompHandler::create_subsolver(CompJob& job, const bool threaded)
+{
+    assert(!solver->drup->enabled());
+    createRenumbering(job.vars);
+
+    //Sub-solvers running on other threads don't print, and are interrupted
+    //together, through a flag of their own. They already share the cores,
+    //so they simplify on one thread each. As their CPU time (or wall time)
+    //starts from zero, their time limit must be what's left of ours
+    SolverConf conf = configureNewSolver(job.vars.size());
+    bool* interrupt = solver->get_must_interrupt_asap_ptr();
+    if (threaded) {
+        conf.verbosity = 0;
+        conf.varelim_threads = 1;
+        conf.subsume_threads = 1;
+        conf.probe_threads = 1;
+        interrupt = &subsolvers_interrupt;
+    }
+    if (threaded || conf.maxTimeIsWall) {
+        conf.maxTime = solver->time_left();
+    }
+    job.newSolver = new SATSolver((void*)&conf, interrupt);
+    moveVariablesBetweenSolvers(job.newSolver, job.vars, job.comp);
+
+    //Move clauses over
+    moveClausesImplicit(job.newSolver, job.comp, job.vars);
+    moveClausesLong(solver->longIrredCls, job.newSolver, job.comp);
+    moveClausesLong(solver->longRedCls, job.newSolver, job.comp);
+}
+
+void CompHandler::solve_subsolvers(
+    vector<CompJob>& jobs
+    , const size_t from
+    , const size_t to
     , const size_t num_comps
 ) {
-    assert(!solver->drup->enabled());
-    vector<Var> vars(vars_orig);
+    const size_t num_threads = std::min<size_t>(
+        std::max(1U, solver->conf.comp_threads)
+        , to - from
+    );
+    if (num_threads <= 1) {
+        for(size_t i = from; i < to; i++) {
+            if (solver->conf.verbosity >= 1 && num_comps < 20) {
+                cout
+                << "c [comp] Solving component " << jobs[i].comp_at
+                << " num vars: " << jobs[i].vars.size()
+                << " ======================================="
+                << endl;
+            }
+            jobs[i].status = jobs[i].newSolver->solve();
+            if (jobs[i].status != l_True) {
+                break;
+            }
+        }
+        return;
+    }
 
-    //Sort and renumber
-    std::sort(vars.begin(), vars.end());
-    createRenumbering(vars);
+    //Once any component is not SAT, the rest need not be solved
+    subsolvers_interrupt = false;
+    std::atomic<size_t> next(from);
+    std::atomic<size_t> finished(0);
+    std::vector<std::thread> thds;
+    for(size_t t = 0; t < num_threads; t++) {
+        thds.push_back(std::thread([&] {
+            size_t i;
+            while((i = next++) < to && !subsolvers_interrupt) {
+                jobs[i].status = jobs[i].newSolver->solve();
+                if (jobs[i].status != l_True) {
+                    subsolvers_interrupt = true;
+                }
+            }
+            finished++;
+        }));
+    }
 
-    if (solver->conf.verbosity >= 1 && num_comps < 20) {
-        cout
-        << "c [comp] Solving component " << comp_at
-        << " num vars: " << vars.size()
-        << " ======================================="
-        << endl;
+    //Pass on interrupts from the outside
+    while(finished < num_threads) {
+        if (solver->must_interrupt_asap()) {
+            subsolvers_interrupt = true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
+    for(std::thread& thd: thds) {
+        thd.join();
+    }
+}
 
-    //Set up new solver
-    SolverConf conf = configureNewSolver(vars.size());
-    SATSolver newSolver((void*)&conf, solver->get_must_interrupt_asap_ptr());
-    moveVariablesBetweenSolvers(&newSolver, vars, comp);
+/**
+@brief Moves the results of the sub-solvers back, in the order of the jobs
 
-    //Move clauses over
-    moveClausesImplicit(&newSolver, comp, vars);
-    moveClausesLong(solver->longIrredCls, &newSolver, comp);
-    moveClausesLong(solver->longRedCls, &newSolver, comp);
+The order, and so savedState, does not depend on the number of threads or on
+which thread finished first.
+*/
+bool CompHandler::merge_subsolvers(
+    vector<CompJob>& jobs
+    , const size_t from
+    , const size_t to
+    , const size_t num_comps
+) {
+    bool unsat = false;
+    bool undef = false;
+    for(size_t i = from; i < to; i++) {
+        unsat |= (jobs[i].status == l_False);
+        undef |= (jobs[i].status == l_Undef);
+    }
 
-    const lbool status = newSolver.solve();
-    //Out of time
-    if (status == l_Undef) {
+    if (unsat) {
+        solver->ok = false;
         if (solver->conf.verbosity >= 2) {
             cout
-            << "c [comp] subcomponent returned l_Undef -- timeout or interrupt."
+            << "c [comp] The component is UNSAT -> problem is UNSAT"
             << endl;
         }
-        readdRemovedClauses();
-        return false;
-    }
-
-    if (status == l_False) {
-        solver->ok = false;
+    } else if (undef) {
+        //Out of time
         if (solver->conf.verbosity >= 2) {
             cout
-            << "c [comp] The component is UNSAT -> problem is UNSAT"
+            << "c [comp] subcomponent returned l_Undef -- timeout or interrupt."
             << endl;
         }
-        return false;
+        readdRemovedClauses();
+    } else {
+        for(size_t i = from; i < to; i++) {
+            const CompJob& job = jobs[i];
+            createRenumbering(job.vars);
+            check_solution_is_unassigned_in_main_solver(job.newSolver, job.vars);
+            save_solution_to_savedstate(job.newSolver, job.vars, job.comp);
+            move_decision_level_zero_vars_here(job.newSolver);
+
+            if (solver->conf.verbosity >= 1 && num_comps < 20) {
+                cout
+                << "c [comp] component " << job.comp_at
+                << " ======================================="
+                << endl;
+            }
+        }
     }
 
-    check_solution_is_unassigned_in_main_solver(&newSolver, vars);
-    save_solution_to_savedstate(&newSolver, vars, comp);
-    move_decision_level_zero_vars_here(&newSolver);
-
-    if (solver->conf.verbosity >= 1 && num_comps < 20) {
-        cout
-        << "c [comp] component " << comp_at
-        << " ======================================="
-        << endl;
+    for(size_t i = from; i < to; i++) {
+        delete jobs[i].newSolver;
+        jobs[i].newSolver = NULL;
     }
-    return true;
+
+    return !unsat && !undef;
 }
 
 void CompHandler::check_local_vardata_sanity()
@@ -769,7 +882,12 @@ void CompHandler::readdRemovedClauses()
         if (dat.removed == Removed::decomposed) {
             dat.removed = Removed::none;
             num_vars_removed--;
-            solver->set_decision_var(inter);
+
+            //Variables renumbered past nVars() are made decision variables
+            //when adding back their clauses below re-inserts them
+            if (inter < solver->nVars()) {
+                solver->set_decision_var(inter);
+            }
         }
     }
 
@@ -42,7 +42,7 @@ class Watched;
 @brief Disconnected components are treated here
 
 Uses CompFinder to find disconnected components and treats them using
-subsolvers. The solutions (if SAT) are aggregated, and at then end, the
+subsolvers, solved on conf.comp_threads threads. The solutions (if SAT) are aggregated, and at then end, the
 solution is extended with the sub-solutions, and the removed clauses are
 added back to the problem.
 */
@@ -78,7 +78,7 @@ class CompHandler
                 return left.second < right.second;
             }
         };
-        bool assumpsInsideComponent(const vector<Var>& vars);
+        bool assumpsOrFrozenInsideComponent(const vector<Var>& vars);
         void move_decision_level_zero_vars_here(
             const SATSolver* newSolver
         );
@@ -92,18 +92,35 @@ class CompHandler
             , const vector<Var>& vars
         );
         void check_local_vardata_sanity();
-        bool try_to_solve_component(
-            const uint32_t comp_at
-            , const uint32_t comp
-            , const vector<Var>& vars
+
+        //Solving the components
+        struct CompJob {
+            CompJob(
+                const uint32_t _comp_at
+                , const uint32_t _comp
+                , const vector<Var>& _vars
+            );
+            uint32_t comp_at;
+            uint32_t comp;
+            vector<Var> vars; ///<Sorted, the renumbering relies on it
+            SATSolver* newSolver = NULL;
+            lbool status = l_Undef;
+        };
+        bool component_can_be_moved(const vector<Var>& vars);
+        void create_subsolver(CompJob& job, const bool threaded);
+        void solve_subsolvers(
+            vector<CompJob>& jobs
+            , const size_t from
+            , const size_t to
             , const size_t num_comps
         );
-        bool solve_component(
-            const uint32_t comp_at
-            , const uint32_t comp
-            , const vector<Var>& vars_orig
+        bool merge_subsolvers(
+            vector<CompJob>& jobs
+            , const size_t from
+            , const size_t to
             , const size_t num_comps
         );
+        bool subsolvers_interrupt = false;
         vector<pair<uint32_t, uint32_t> > get_component_sizes() const;
 
         SolverConf configureNewSolver(
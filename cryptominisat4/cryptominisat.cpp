@@ -23,10 +23,14 @@
 #include "solver.h"
 #include "drup.h"
 #include "shareddata.h"
+#include "cubefinder.h"
 #include <stdexcept>
 #include <thread>
 #include <mutex>
 #include <fstream>
+#include <algorithm>
+#include <unordered_set>
+#include <deque>
 using std::thread;
 using std::mutex;
 
@@ -61,7 +65,21 @@ namespace CMSat {
         unsigned cls;
         unsigned vars_to_add;
         vector<Lit> cls_lits;
+        vector<vector<Lit> > cls_lits_normalized;
+        vector<Lit> batch_tmp;
         bool okay;
+
+        //Cube-and-conquer: conflict over the assumptions, if the last
+        //solve() call was UNSAT
+        vector<Lit> cube_conflict;
+        bool cube_solved = false;
+
+        //Clause groups: activation literal of each group, whether the group
+        //has been removed, and which (outside) variables are activation ones
+        vector<Lit> group_lits;
+        vector<char> group_removed;
+        unsigned num_active_groups = 0;
+        vector<Lit> group_tmp;
         std::ofstream* log = NULL;
     };
 }
@@ -70,7 +88,7 @@ struct DataForThread
 {
     explicit DataForThread(CMSatPrivateData* data, const vector<Lit>* _assumptions = NULL) :
         solvers(data->solvers)
-        , lits_to_add(&(data->cls_lits))
+        , lits_to_add(&(data->cls_lits_normalized))
         , vars_to_add(data->vars_to_add)
         , assumptions(_assumptions)
         , update_mutex(new mutex)
@@ -85,7 +103,7 @@ struct DataForThread
         delete ret;
     }
     vector<Solver*>& solvers;
-    vector<Lit> *lits_to_add;
+    vector<vector<Lit> > *lits_to_add;
     uint32_t vars_to_add;
     const vector<Lit> *assumptions;
     mutex* update_mutex;
@@ -120,6 +138,7 @@ void update_config(SolverConf& conf, unsigned thread_num)
             conf.shortTermHistorySize = 80;
             //conf.clauseCleaningType = CMSat::clean_glue_based;
             conf.restartType = CMSat::restart_type_glue;
+            conf.branch_strategy = CMSat::branch_vmtf;
             conf.increaseClean = 1.08;
             //conf.ratioRemoveClauses = 0.55;
             break;
@@ -149,6 +168,7 @@ void update_config(SolverConf& conf, unsigned thread_num)
             conf.more_red_minim_limit_cache = 100;
             conf.more_red_minim_limit_binary = 100;
             conf.probe_bogoprops_time_limitM = 4000;
+            conf.branch_strategy = CMSat::branch_chb;
 //             conf.ratioRemoveClauses = 0.6;
             break;
         }
@@ -228,7 +248,10 @@ void SATSolver::set_num_threads(const unsigned num)
     }
 
     //set shared data
-    data->shared_data = new SharedData(data->solvers.size());
+    data->shared_data = new SharedData(
+        data->solvers.size()
+        , data->solvers[0]->getConf().sync_ring_size
+    );
     for(unsigned i = 0; i < num; i++) {
         SolverConf conf = data->solvers[i]->getConf();
         if (i >= 1) {
@@ -236,11 +259,159 @@ void SATSolver::set_num_threads(const unsigned num)
             conf.doSQL = 0;
             conf.doFindXors = 0;
         }
+        //The threads share the time limit, so it must be wall-clock time
+        conf.maxTimeIsWall = true;
         data->solvers[i]->setConf(conf);
         data->solvers[i]->set_shared_data((SharedData*)data->shared_data, i);
     }
 }
 
+//Sorts the literals of the normal clauses in cls_lits[start..end), removes
+//duplicate literals, tautologies and duplicate clauses. XORs are kept as-is.
+struct OneThreadNormalizeCls
+{
+    OneThreadNormalizeCls(
+        const vector<Lit>& _lits
+        , const size_t _start
+        , const size_t _end
+        , vector<Lit>& _out
+    ) :
+        lits(_lits)
+        , start(_start)
+        , end(_end)
+        , out(_out)
+    {}
+
+    struct ClHash
+    {
+        explicit ClHash(const vector<Lit>& _out) : out(_out) {}
+        size_t operator()(const std::pair<size_t, size_t>& cl) const
+        {
+            size_t hash = 0;
+            for(size_t i = cl.first; i < cl.second; i++) {
+                hash = hash*31 + out[i].toInt();
+            }
+            return hash;
+        }
+        const vector<Lit>& out;
+    };
+
+    struct ClEqual
+    {
+        explicit ClEqual(const vector<Lit>& _out) : out(_out) {}
+        bool operator()(
+            const std::pair<size_t, size_t>& a
+            , const std::pair<size_t, size_t>& b
+        ) const {
+            return (a.second - a.first) == (b.second - b.first)
+                && std::equal(
+                    out.begin() + a.first
+                    , out.begin() + a.second
+                    , out.begin() + b.first
+                );
+        }
+        const vector<Lit>& out;
+    };
+
+    void operator()()
+    {
+        out.clear();
+        out.reserve(end - start);
+        std::unordered_set<std::pair<size_t, size_t>, ClHash, ClEqual>
+            added(16, ClHash(out), ClEqual(out));
+
+        size_t at = start;
+        while(at < end) {
+            const size_t cl_at = out.size();
+            out.push_back(lits[at]);
+            at++;
+            if (out.back() == lit_Error) {
+                //XOR: marker, rhs, vars
+                out.push_back(lits[at]);
+                at++;
+                for(; at < end && !is_marker(lits[at]); at++) {
+                    out.push_back(lits[at]);
+                }
+                continue;
+            }
+
+            for(; at < end && !is_marker(lits[at]); at++) {
+                out.push_back(lits[at]);
+            }
+            if (!sort_and_clean(cl_at + 1)
+                || !added.insert(std::make_pair(cl_at + 1, out.size())).second
+            ) {
+                out.resize(cl_at);
+            }
+        }
+    }
+
+    static bool is_marker(const Lit lit)
+    {
+        return lit == lit_Undef || lit == lit_Error;
+    }
+
+    //Returns false if the clause is a tautology
+    bool sort_and_clean(const size_t cl_start)
+    {
+        std::sort(out.begin() + cl_start, out.end());
+        Lit p = lit_Undef;
+        size_t j = cl_start;
+        for(size_t i = cl_start; i < out.size(); i++) {
+            if (out[i] == ~p) {
+                return false;
+            }
+            if (out[i] != p) {
+                out[j++] = p = out[i];
+            }
+        }
+        out.resize(j);
+        return true;
+    }
+
+    const vector<Lit>& lits;
+    const size_t start;
+    const size_t end;
+    vector<Lit>& out;
+};
+
+//Normalizes cls_lits once, in parallel, into cls_lits_normalized. Every
+//solver thread then only has to attach the clauses.
+static void normalize_clauses_to_add(CMSatPrivateData* data)
+{
+    const vector<Lit>& lits = data->cls_lits;
+    const size_t num_chunks = std::max<size_t>(
+        1
+        , std::min<size_t>(data->solvers.size(), lits.size()/10000)
+    );
+    data->cls_lits_normalized.resize(num_chunks);
+
+    //Cut at clause boundaries
+    vector<size_t> cut;
+    cut.push_back(0);
+    for(size_t i = 1; i < num_chunks; i++) {
+        size_t at = std::max(cut.back(), lits.size()*i/num_chunks);
+        while(at < lits.size()
+            && !OneThreadNormalizeCls::is_marker(lits[at])
+        ) {
+            at++;
+        }
+        cut.push_back(at);
+    }
+    cut.push_back(lits.size());
+
+    std::vector<std::thread> thds;
+    for(size_t i = 0; i < num_chunks; i++) {
+        thds.push_back(thread(OneThreadNormalizeCls(
+            lits, cut[i], cut[i+1], data->cls_lits_normalized[i]
+        )));
+    }
+    for(std::thread& thread : thds){
+        thread.join();
+    }
+    data->cls_lits.clear();
+}
+
 struct OneThreadAddCls
 {
     OneThreadAddCls(DataForThread& _data_for_thread, size_t _tid) :
@@ -254,23 +425,40 @@ struct OneThreadAddCls
         Solver& solver = *data_for_thread.solvers[tid];
         solver.new_external_vars(data_for_thread.vars_to_add);
 
-        vector<Lit> lits;
-        vector<Var> vars;
+        bool ret = true;
+        for(const vector<Lit>& orig_lits: *data_for_thread.lits_to_add) {
+            ret = add_chunk(solver, orig_lits);
+            if (!ret) {
+                break;
+            }
+        }
+
+        if (!ret) {
+            data_for_thread.update_mutex->lock();
+            *data_for_thread.ret = l_False;
+            data_for_thread.update_mutex->unlock();
+        }
+    }
+
+    bool add_chunk(Solver& solver, const vector<Lit>& orig_lits)
+    {
         bool ret = true;
         size_t at = 0;
-        const vector<Lit>& orig_lits = (*data_for_thread.lits_to_add);
         const size_t size = orig_lits.size();
         while(at < size && ret) {
             if (orig_lits[at] == lit_Undef) {
-                lits.clear();
                 at++;
+                const size_t cl_start = at;
                 for(; at < size
                     && orig_lits[at] != lit_Undef
                     && orig_lits[at] != lit_Error
                     ; at++
                 ) {
-                    lits.push_back(orig_lits[at]);
                 }
+
+                //Already sorted and deduplicated, so unless renumbering
+                //reorders it, it is only checked against the assignment
+                lits.assign(orig_lits.begin() + cl_start, orig_lits.begin() + at);
                 ret = solver.add_clause_outer(lits);
             } else {
                 vars.clear();
@@ -288,19 +476,25 @@ struct OneThreadAddCls
             }
         }
 
-        if (!ret) {
-            data_for_thread.update_mutex->lock();
-            *data_for_thread.ret = l_False;
-            data_for_thread.update_mutex->unlock();
-        }
+        return ret;
     }
 
     DataForThread& data_for_thread;
     const size_t tid;
+    vector<Lit> lits;
+    vector<Var> vars;
 };
 
+static void clear_added_clauses(CMSatPrivateData* data)
+{
+    data->cls_lits.clear();
+    data->cls_lits_normalized.clear();
+    data->vars_to_add = 0;
+}
+
 static bool actually_add_clauses_to_threads(CMSatPrivateData* data)
 {
+    normalize_clauses_to_add(data);
     DataForThread data_for_thread(data);
     std::vector<std::thread> thds;
     for(size_t i = 0; i < data->solvers.size(); i++) {
@@ -312,8 +506,7 @@ static bool actually_add_clauses_to_threads(CMSatPrivateData* data)
     bool ret = (*data_for_thread.ret == l_True);
 
     //clear what has been added
-    data->cls_lits.clear();
-    data->vars_to_add = 0;
+    clear_added_clauses(data);
 
     return ret;
 }
@@ -363,6 +556,56 @@ bool SATSolver::add_clause(const vector< Lit >& lits)
     return ret;
 }
 
+bool SATSolver::add_clauses(const Lit* lits, size_t n)
+{
+    const Lit* end = lits + n;
+    if (data->log) {
+        for(const Lit* at = lits; at < end; at++) {
+            for(; at < end && *at != lit_Undef; at++) {
+                (*data->log) << *at << " ";
+            }
+            (*data->log) << "0" << endl;
+        }
+    }
+
+    bool ret = true;
+    if (data->solvers.size() > 1) {
+        if (data->cls_lits.size() + n + 1 > CACHE_SIZE) {
+            ret = actually_add_clauses_to_threads(data);
+        }
+
+        //The buffer marks the start of clauses instead of their end
+        data->cls_lits.reserve(data->cls_lits.size() + n + 1);
+        for(const Lit* at = lits; at < end; at++) {
+            const Lit* cl_end = std::find(at, end, lit_Undef);
+            data->cls_lits.push_back(lit_Undef);
+            data->cls_lits.insert(data->cls_lits.end(), at, cl_end);
+            at = cl_end;
+        }
+    } else {
+        data->solvers[0]->new_vars(data->vars_to_add);
+        data->vars_to_add = 0;
+
+        ret = data->solvers[0]->add_clauses_outer(lits, n);
+        data->cls += std::count(lits, end, lit_Undef);
+    }
+
+    return ret;
+}
+
+bool SATSolver::add_clauses(const Lit* lits, const size_t* offsets, size_t num_clauses)
+{
+    vector<Lit>& flat = data->batch_tmp;
+    flat.clear();
+    flat.reserve(offsets[num_clauses] - offsets[0] + num_clauses);
+    for(size_t i = 0; i < num_clauses; i++) {
+        flat.insert(flat.end(), lits + offsets[i], lits + offsets[i+1]);
+        flat.push_back(lit_Undef);
+    }
+
+    return add_clauses(flat.data(), flat.size());
+}
+
 void add_xor_clause_to_log(const std::vector<unsigned>& vars, bool rhs, std::ofstream* file)
 {
     if (vars.size() == 0) {
@@ -408,6 +651,46 @@ bool SATSolver::add_xor_clause(const std::vector<unsigned>& vars, bool rhs)
     return ret;
 }
 
+bool SATSolver::add_xor_clauses(
+    const unsigned* vars
+    , const size_t* offsets
+    , const bool* rhs
+    , size_t num_xors
+) {
+    if (data->log) {
+        vector<unsigned> tmp;
+        for(size_t i = 0; i < num_xors; i++) {
+            tmp.assign(vars + offsets[i], vars + offsets[i+1]);
+            add_xor_clause_to_log(tmp, rhs[i], data->log);
+        }
+    }
+
+    bool ret = true;
+    if (data->solvers.size() > 1) {
+        const size_t n = offsets[num_xors] - offsets[0] + 2*num_xors;
+        if (data->cls_lits.size() + n > CACHE_SIZE) {
+            ret = actually_add_clauses_to_threads(data);
+        }
+
+        data->cls_lits.reserve(data->cls_lits.size() + n);
+        for(size_t i = 0; i < num_xors; i++) {
+            data->cls_lits.push_back(lit_Error);
+            data->cls_lits.push_back(Lit(0, rhs[i]));
+            for(size_t at = offsets[i]; at < offsets[i+1]; at++) {
+                data->cls_lits.push_back(Lit(vars[at], false));
+            }
+        }
+    } else {
+        data->solvers[0]->new_vars(data->vars_to_add);
+        data->vars_to_add = 0;
+
+        ret = data->solvers[0]->add_xor_clauses_outer(vars, offsets, rhs, num_xors);
+        data->cls += num_xors;
+    }
+
+    return ret;
+}
+
 struct OneThreadSolve
 {
     OneThreadSolve(DataForThread& _data_for_thread, size_t _tid) :
@@ -454,16 +737,210 @@ struct OneThreadSolve
     const size_t tid;
 };
 
-lbool SATSolver::solve(const vector< Lit >* assumptions)
+//Each thread pops cubes from the back of its own deque, and steals from
+//the front of the others' when its own is empty
+class CubeQueue
 {
-    if (data->log) {
-        (*data->log) << "c Solver::solve( ";
-        if (assumptions) {
-            (*data->log) << *assumptions;
+public:
+    CubeQueue(const size_t num_threads, vector<vector<Lit> >& cubes) :
+        queues(num_threads)
+        , mutexes(num_threads)
+    {
+        for(size_t i = 0; i < cubes.size(); i++) {
+            queues[i % num_threads].push_back(std::move(cubes[i]));
+        }
+    }
+
+    bool pop(const size_t tid, vector<Lit>& cube, bool& stolen)
+    {
+        stolen = false;
+        if (pop_back(tid, cube)) {
+            return true;
+        }
+
+        for(size_t i = 1; i < queues.size(); i++) {
+            const size_t victim = (tid + i) % queues.size();
+            std::lock_guard<mutex> lock(mutexes[victim]);
+            if (!queues[victim].empty()) {
+                cube = std::move(queues[victim].front());
+                queues[victim].pop_front();
+                stolen = true;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+private:
+    bool pop_back(const size_t tid, vector<Lit>& cube)
+    {
+        std::lock_guard<mutex> lock(mutexes[tid]);
+        if (queues[tid].empty()) {
+            return false;
+        }
+        cube = std::move(queues[tid].back());
+        queues[tid].pop_back();
+        return true;
+    }
+
+    vector<std::deque<vector<Lit> > > queues;
+    vector<mutex> mutexes;
+};
+
+struct CubeSolveData
+{
+    CubeSolveData(
+        vector<Solver*>& _solvers
+        , const vector<Lit>* _assumptions
+        , vector<vector<Lit> >& cubes
+    ) :
+        solvers(_solvers)
+        , queue(_solvers.size(), cubes)
+    {
+        if (_assumptions) {
+            assumptions = *_assumptions;
+        }
+    }
+
+    vector<Solver*>& solvers;
+    vector<Lit> assumptions;
+    CubeQueue queue;
+    mutex update_mutex;
+    bool done = false;
+    lbool ret = l_False;
+    int which_solved = 0;
+    vector<Lit> conflict;
+
+    //Stats
+    size_t cubes_solved = 0;
+    size_t cubes_stolen = 0;
+};
+
+struct OneThreadCubeSolve
+{
+    OneThreadCubeSolve(CubeSolveData& _data, size_t _tid) :
+        data(_data)
+        , tid(_tid)
+    {}
+
+    void operator()()
+    {
+        Solver& solver = *data.solvers[tid];
+        vector<Lit> cube;
+        vector<Lit> assumps;
+        bool stolen;
+        while(data.queue.pop(tid, cube, stolen)) {
+            assumps = data.assumptions;
+            assumps.insert(assumps.end(), cube.begin(), cube.end());
+            const lbool ret = solver.solve_with_assumptions(&assumps);
+
+            std::lock_guard<mutex> lock(data.update_mutex);
+            if (data.done) {
+                break;
+            }
+            data.cubes_solved++;
+            data.cubes_stolen += stolen;
+
+            if (ret == l_False && solver.okay()) {
+                //Refuted the cube, maybe also the assumptions
+                bool cube_involved = false;
+                for(const Lit lit: solver.get_final_conflict()) {
+                    if (std::find(cube.begin(), cube.end(), ~lit) != cube.end()) {
+                        cube_involved = true;
+                    } else if (std::find(data.conflict.begin(), data.conflict.end(), lit)
+                        == data.conflict.end()
+                    ) {
+                        data.conflict.push_back(lit);
+                    }
+                }
+                if (cube_involved) {
+                    continue;
+                }
+            }
+
+            //SAT, UNSAT without the cube, or interrupted: we are done
+            data.done = true;
+            data.ret = ret;
+            data.which_solved = tid;
+            if (ret == l_False) {
+                data.conflict = solver.get_final_conflict();
+            }
+            for(size_t i = 0; i < data.solvers.size(); i++) {
+                if (i != tid) {
+                    data.solvers[i]->set_must_interrupt_asap();
+                }
+            }
+            break;
+        }
+    }
+
+    CubeSolveData& data;
+    const size_t tid;
+};
+
+static lbool solve_cube_and_conquer(
+    CMSatPrivateData* data
+    , const vector<Lit>* assumptions
+) {
+    data->cube_solved = true;
+    data->cube_conflict.clear();
+    data->which_solved = 0;
+    if (!actually_add_clauses_to_threads(data)) {
+        data->okay = false;
+        return l_False;
+    }
+
+    Solver& solver = *data->solvers[0];
+    if (!solver.okay()) {
+        data->okay = false;
+        return l_False;
+    }
+    vector<vector<Lit> > cubes;
+    CubeFinder cube_finder(&solver);
+    if (!cube_finder.find_cubes(solver.conf.cube_depth, cubes)) {
+        data->okay = false;
+        return l_False;
+    }
+
+    CubeSolveData cube_data(data->solvers, assumptions, cubes);
+    std::vector<std::thread> thds;
+    for(size_t i = 0; i < data->solvers.size(); i++) {
+        thds.push_back(thread(OneThreadCubeSolve(cube_data, i)));
+    }
+    for(std::thread& thread : thds){
+        thread.join();
+    }
+    for(Solver* s: data->solvers) {
+        s->unset_must_interrupt_asap();
+    }
+
+    if (solver.conf.verbosity >= 1) {
+        cout
+        << "c [cube] solved cubes: " << cube_data.cubes_solved
+        << " stolen: " << cube_data.cubes_stolen
+        << " result: " << cube_data.ret
+        << endl;
+    }
+
+    //Every cube was refuted without any of the assumptions: UNSAT for good
+    if (!cube_data.done && cube_data.conflict.empty()) {
+        for(Solver* s: data->solvers) {
+            s->add_clause_outer(vector<Lit>());
         }
-        (*data->log) << " )" << endl;
     }
 
+    data->which_solved = cube_data.which_solved;
+    data->cube_conflict = cube_data.conflict;
+    data->okay = data->solvers[data->which_solved]->okay();
+
+    return cube_data.ret;
+}
+
+static lbool solve_with_threads(
+    CMSatPrivateData* data
+    , const vector<Lit>* assumptions
+) {
     if (data->solvers.size() == 1) {
         data->solvers[0]->new_vars(data->vars_to_add);
         data->vars_to_add = 0;
@@ -473,7 +950,16 @@ lbool SATSolver::solve(const vector< Lit >* assumptions)
         return ret;
     }
 
+    //Cubes are only worth it if there are several threads to share them
+    if (data->solvers[0]->conf.cube_depth > 0) {
+        return solve_cube_and_conquer(data, assumptions);
+    }
+    data->cube_solved = false;
+
+    normalize_clauses_to_add(data);
     DataForThread data_for_thread(data, assumptions);
+    //Stays l_Undef if all threads run out of time
+    *data_for_thread.ret = l_Undef;
     std::vector<std::thread> thds;
     for(size_t i = 0; i < data->solvers.size(); i++) {
         thds.push_back(thread(OneThreadSolve(data_for_thread, i)));
@@ -484,13 +970,39 @@ lbool SATSolver::solve(const vector< Lit >* assumptions)
     lbool real_ret = *data_for_thread.ret;
 
     //clear what has been added
-    data->cls_lits.clear();
-    data->vars_to_add = 0;
+    clear_added_clauses(data);
     data->okay = data->solvers[*data_for_thread.which_solved]->okay();
 
     return real_ret;
 }
 
+lbool SATSolver::solve(const vector< Lit >* assumptions)
+{
+    //Active clause groups are assumed on top of the user's assumptions
+    vector<Lit> with_groups;
+    if (data->num_active_groups > 0) {
+        if (assumptions) {
+            with_groups = *assumptions;
+        }
+        for(size_t i = 0; i < data->group_lits.size(); i++) {
+            if (!data->group_removed[i]) {
+                with_groups.push_back(data->group_lits[i]);
+            }
+        }
+        assumptions = &with_groups;
+    }
+
+    if (data->log) {
+        (*data->log) << "c Solver::solve( ";
+        if (assumptions) {
+            (*data->log) << *assumptions;
+        }
+        (*data->log) << " )" << endl;
+    }
+
+    return solve_with_threads(data, assumptions);
+}
+
 const vector< lbool >& SATSolver::get_model() const
 {
     return data->solvers[data->which_solved]->get_model();
@@ -498,6 +1010,9 @@ const vector< lbool >& SATSolver::get_model() const
 
 const std::vector<Lit>& SATSolver::get_conflict() const
 {
+    if (data->cube_solved) {
+        return data->cube_conflict;
+    }
 
     return data->solvers[data->which_solved]->get_final_conflict();
 }
@@ -524,6 +1039,80 @@ void SATSolver::new_vars(const size_t n)
     data->vars_to_add += n;
 }
 
+unsigned SATSolver::new_clause_group()
+{
+    const unsigned var = nVars();
+    new_var();
+
+    data->group_lits.push_back(Lit(var, false));
+    data->group_removed.push_back(false);
+    data->num_active_groups++;
+
+    return data->group_lits.size()-1;
+}
+
+void SATSolver::set_frozen(unsigned var, bool frozen)
+{
+    if (data->log) {
+        (*data->log) << "c Solver::set_frozen( " << var << ", " << frozen << " )" << endl;
+    }
+
+    if (var >= nVars()) {
+        std::cerr
+        << "ERROR: Variable " << var + 1
+        << " frozen, but max var is " << nVars() << endl;
+        exit(-1);
+    }
+
+    for(Solver* s: data->solvers) {
+        s->set_frozen_outer(var, frozen);
+    }
+}
+
+static void check_clause_group(const CMSatPrivateData* data, unsigned group)
+{
+    if (group >= data->group_lits.size()) {
+        std::cerr
+        << "ERROR: Clause group " << group << " does not exist, only "
+        << data->group_lits.size() << " groups have been created" << endl;
+        exit(-1);
+    }
+}
+
+bool SATSolver::add_clause(const vector<Lit>& lits, unsigned group)
+{
+    check_clause_group(data, group);
+
+    data->group_tmp = lits;
+    data->group_tmp.push_back(~data->group_lits[group]);
+    return add_clause(data->group_tmp);
+}
+
+bool SATSolver::remove_clause_group(unsigned group)
+{
+    check_clause_group(data, group);
+    if (data->group_removed[group]) {
+        return okay();
+    }
+    data->group_removed[group] = true;
+    data->num_active_groups--;
+
+    //All clauses of the group, and all learnt clauses derived from them,
+    //contain ~lit, so they become satisfied
+    bool ret = add_clause(vector<Lit>{~data->group_lits[group]});
+    for(Solver* s: data->solvers) {
+        s->remove_satisfied_at_next_solve();
+    }
+
+    return ret;
+}
+
+Lit SATSolver::get_clause_group_lit(unsigned group) const
+{
+    check_clause_group(data, group);
+    return data->group_lits[group];
+}
+
 void SATSolver::add_sql_tag(const std::string& tagname, const std::string& tag)
 {
     for(size_t i = 0; i < data->solvers.size(); i++) {
@@ -39,8 +39,37 @@ namespace CMSat {
         unsigned nVars() const;
         bool add_clause(const std::vector<Lit>& lits);
         bool add_xor_clause(const std::vector<unsigned>& vars, bool rhs);
+
+        //Batch insertion. Flat form: every clause in lits[0..n) is
+        //terminated by lit_Undef. CSR form: clause i is
+        //lits[offsets[i]] .. lits[offsets[i+1]-1]
+        bool add_clauses(const Lit* lits, size_t n);
+        bool add_clauses(const Lit* lits, const size_t* offsets, size_t num_clauses);
+        bool add_xor_clauses(
+            const unsigned* vars
+            , const size_t* offsets
+            , const bool* rhs
+            , size_t num_xors
+        );
         void new_var();
         void new_vars(const size_t n);
+
+        //Clause groups. Every clause of a group carries the negation of the
+        //group's activation literal, which is assumed true at every solve()
+        //call until the group is removed. Removing a group retires its
+        //clauses and all learnt clauses that have been derived from them.
+        //The conflict of an UNSAT solve() contains the negation of the
+        //activation literal of every group that took part in it.
+        unsigned new_clause_group();
+        bool add_clause(const std::vector<Lit>& lits, unsigned group);
+        bool remove_clause_group(unsigned group);
+        Lit get_clause_group_lit(unsigned group) const;
+
+        //Frozen variables are never eliminated or decomposed away by
+        //simplification, so they can be used in later clauses and
+        //assumptions without being brought back each time
+        void set_frozen(unsigned var, bool frozen = true);
+
         lbool solve(const std::vector<Lit>* assumptions = 0);
         const std::vector<lbool>& get_model() const;
         const std::vector<Lit>& get_conflict() const;
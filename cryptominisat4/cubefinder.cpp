@@ -0,0 +1,205 @@
+/*
+ * CryptoMiniSat
+ *
+ * Copyright (c) 2009-2014, Mate Soos. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation
+ * version 2.0 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+*/
+
+
+#include "cubefinder.h"
+#include "solver.h"
+#include "time_mem.h"
+#include <algorithm>
+#include <iomanip>
+
+using namespace CMSat;
+using std::cout;
+using std::endl;
+
+CubeFinder::CubeFinder(Solver* _solver) :
+    cubes_out(NULL)
+    , solver(_solver)
+{
+}
+
+bool CubeFinder::find_cubes(const uint32_t depth, vector<vector<Lit> >& cubes)
+{
+    assert(solver->okay());
+    assert(solver->decisionLevel() == 0);
+    const double myTime = cpuTime();
+    num_cubes = 0;
+    num_refuted = 0;
+    num_lookaheads = 0;
+
+    //Looking ahead must not overwrite the saved phases of the solver
+    const bool update_polarity_orig = solver->update_polarity_and_activity;
+    solver->update_polarity_and_activity = false;
+
+    cubes.clear();
+    cubes_out = &cubes;
+    cube.clear();
+    outer_to_without_bva_map = solver->build_outer_to_without_bva_map();
+    fill_candidates();
+
+    solver->ok = solver->propagate<false>().isNULL();
+    if (solver->okay()) {
+        split(depth);
+    }
+    assert(solver->decisionLevel() == 0);
+    cubes_out = NULL;
+    solver->update_polarity_and_activity = update_polarity_orig;
+
+    if (solver->conf.verbosity >= 1) {
+        cout
+        << "c [cube] cubes: " << num_cubes
+        << " refuted: " << num_refuted
+        << " lookaheads: " << num_lookaheads
+        << solver->conf.print_times(cpuTime() - myTime)
+        << endl;
+    }
+
+    //All branches refuted
+    if (solver->okay() && cubes.empty()) {
+        solver->ok = false;
+    }
+
+    return solver->okay();
+}
+
+//Variables with the longest watchlists are the ones worth looking ahead on
+void CubeFinder::fill_candidates()
+{
+    vector<std::pair<size_t, Var> > by_occur;
+    for(Var var = 0; var < solver->nVars(); var++) {
+        if (solver->value(var) != l_Undef
+            || solver->varData[var].removed != Removed::none
+            || solver->varData[var].is_bva
+        ) {
+            continue;
+        }
+
+        const size_t num = solver->watches[Lit(var, false).toInt()].size()
+            + solver->watches[Lit(var, true).toInt()].size();
+        by_occur.push_back(std::make_pair(num, var));
+    }
+    std::sort(by_occur.begin(), by_occur.end()
+        , [](const std::pair<size_t, Var>& a, const std::pair<size_t, Var>& b) {
+            return a.first > b.first;
+        }
+    );
+
+    candidates.clear();
+    for(size_t i = 0
+        ; i < by_occur.size() && i < solver->conf.cube_lookahead_cands
+        ; i++
+    ) {
+        candidates.push_back(by_occur[i].second);
+    }
+}
+
+//Returns the number of literals propagated, or 0 if it lead to a conflict
+uint64_t CubeFinder::lookahead(const Lit lit)
+{
+    num_lookaheads++;
+    const size_t orig_trail = solver->trail_size();
+    const uint32_t level = solver->decisionLevel();
+    solver->new_decision_level();
+    solver->enqueue(lit);
+    const bool ok = solver->propagate<false>().isNULL();
+    const uint64_t props = solver->trail_size() - orig_trail;
+    solver->cancelUntil(level);
+
+    return ok ? props : 0;
+}
+
+/**
+@returns lit_Undef if there is nothing to branch on, lit_Error if both
+polarities of some candidate fail, i.e. the current cube is refuted
+*/
+Lit CubeFinder::pick_branch_lit()
+{
+    Lit best = lit_Undef;
+    uint64_t best_score = 0;
+    for(const Var var: candidates) {
+        if (solver->value(var) != l_Undef) {
+            continue;
+        }
+
+        const Lit lit = Lit(var, false);
+        const uint64_t pos = lookahead(lit);
+        const uint64_t neg = lookahead(~lit);
+        if (pos == 0 && neg == 0) {
+            return lit_Error;
+        }
+
+        //One branch fails: branch here, the failing branch will be refuted
+        if (pos == 0 || neg == 0) {
+            return lit;
+        }
+
+        const uint64_t score = pos*neg;
+        if (best == lit_Undef || score > best_score) {
+            best = (pos >= neg) ? lit : ~lit;
+            best_score = score;
+        }
+    }
+
+    return best;
+}
+
+void CubeFinder::split(const uint32_t depth_left)
+{
+    if (depth_left == 0) {
+        add_cube();
+        return;
+    }
+
+    const Lit branch = pick_branch_lit();
+    if (branch == lit_Error) {
+        num_refuted++;
+        return;
+    }
+    if (branch == lit_Undef) {
+        add_cube();
+        return;
+    }
+
+    for(const Lit lit: {branch, ~branch}) {
+        const uint32_t level = solver->decisionLevel();
+        solver->new_decision_level();
+        solver->enqueue(lit);
+        cube.push_back(lit);
+        if (solver->propagate<false>().isNULL()) {
+            split(depth_left - 1);
+        } else {
+            num_refuted++;
+        }
+        cube.pop_back();
+        solver->cancelUntil(level);
+    }
+}
+
+void CubeFinder::add_cube()
+{
+    num_cubes++;
+    vector<Lit> outside;
+    for(const Lit lit: cube) {
+        const Lit outer = solver->map_inter_to_outer(lit);
+        outside.push_back(Lit(outer_to_without_bva_map[outer.var()], outer.sign()));
+    }
+    cubes_out->push_back(outside);
+}
@@ -0,0 +1,73 @@
+/*
+ * CryptoMiniSat
+ *
+ * Copyright (c) 2009-2014, Mate Soos. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation
+ * version 2.0 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+*/
+
+
+#ifndef CUBEFINDER_H
+#define CUBEFINDER_H
+
+#include <vector>
+#include "solvertypes.h"
+
+namespace CMSat {
+
+class Solver;
+
+using std::vector;
+
+/**
+@brief Splits the problem into cubes using a lookahead on the top-level
+
+Each inner node of the split tree branches on the variable that maximises
+the product of the number of literals propagated by its two polarities.
+Branches that fail during propagation are not emitted. The cubes are
+returned in the outside numbering, so they can be given as assumptions to
+any of the solver threads.
+*/
+class CubeFinder {
+    public:
+        CubeFinder(Solver* solver);
+
+        //Returns false if the problem was found to be UNSAT
+        bool find_cubes(const uint32_t depth, vector<vector<Lit> >& cubes);
+
+    private:
+        void fill_candidates();
+        Lit pick_branch_lit();
+        uint64_t lookahead(const Lit lit);
+        void split(const uint32_t depth_left);
+        void add_cube();
+
+        vector<Var> candidates;
+        vector<Lit> cube;
+        vector<Var> outer_to_without_bva_map;
+        vector<vector<Lit> >* cubes_out;
+
+        //Stats
+        uint64_t num_cubes = 0;
+        uint64_t num_refuted = 0;
+        uint64_t num_lookaheads = 0;
+
+        Solver* solver;
+};
+
+} //End namespace
+
+#endif //CUBEFINDER_H
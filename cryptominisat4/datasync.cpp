@@ -24,6 +24,7 @@
 #include "solver.h"
 #include "shareddata.h"
 #include <iomanip>
+#include <algorithm>
 
 using namespace CMSat;
 
@@ -33,7 +34,13 @@ DataSync::DataSync(Solver* _solver, SharedData* _sharedData, uint32_t _thread_nu
     , thread_num(_thread_num)
     , seen(solver->seen)
     , toClear(solver->toClear)
-{}
+{
+    if (sharedData) {
+        ringCursor.resize(sharedData->num_threads, 0);
+        shareMaxGlue = solver->conf.sync_max_glue;
+        shareMaxSize = std::min<uint32_t>(solver->conf.sync_max_size, (uint32_t)ClauseRing::max_lits);
+    }
+}
 
 void DataSync::new_var(const bool bva)
 {
@@ -103,6 +110,10 @@ bool DataSync::syncData()
     sharedData->bin_mutex.unlock();
     if (!ok) return false;
 
+    //Rings are lock-free
+    ok = syncLongFromOthers();
+    if (!ok) return false;
+
     lastSyncConf = solver->sumConflicts();
 
     return true;
@@ -328,6 +339,188 @@ bool DataSync::shareUnitData()
     return true;
 }
 
+bool DataSync::syncLongFromOthers()
+{
+    const uint32_t oldRecvLongData = stats.recvLongData;
+    const uint32_t oldLostLongData = stats.lostLongData;
+
+    auto import = [&](const Lit* lits, const uint32_t size, const uint32_t glue) {
+        if (solver->ok) {
+            importLongClause(lits, size, glue);
+        }
+    };
+    for(uint32_t i = 0; i < sharedData->num_threads; i++) {
+        if (i == thread_num) {
+            continue;
+        }
+
+        ringCursor[i] = sharedData->rings[i]->read_from(
+            ringCursor[i]
+            , import
+            , stats.lostLongData
+        );
+        if (!solver->ok) {
+            return false;
+        }
+    }
+
+    if (solver->conf.verbosity >= 2) {
+        cout
+        << "c [sync] got long " << (stats.recvLongData - oldRecvLongData)
+        << " lost long " << (stats.lostLongData - oldLostLongData)
+        << " sent long " << stats.sentLongData
+        << " useful long " << stats.usefulLongData
+        << " ring mem use: "
+        << sharedData->calc_memory_use_rings()/(1024*1024) << " M"
+        << endl;
+    }
+
+    return true;
+}
+
+void DataSync::importLongClause(
+    const Lit* lits
+    , const uint32_t size
+    , const uint32_t glue
+) {
+    tmpLits.clear();
+    for(uint32_t i = 0; i < size; i++) {
+        Lit lit = lits[i];
+        if (lit.var() >= solver->nVarsOutside()) {
+            return;
+        }
+        lit = solver->map_to_with_bva(lit);
+        lit = solver->varReplacer->get_lit_replaced_with_outer(lit);
+        lit = solver->map_outer_to_inter(lit);
+        if (solver->varData[lit.var()].removed != Removed::none
+            || solver->value(lit) == l_True
+        ) {
+            return;
+        }
+        if (solver->value(lit) == l_Undef) {
+            tmpLits.push_back(lit);
+        }
+    }
+
+    ClauseStats cl_stats;
+    cl_stats.glue = std::min<uint32_t>(glue, tmpLits.size());
+    cl_stats.last_touched = solver->sumConflicts();
+
+    //Don't add DRUP: it would add to the thread data, too
+    Clause* cl = solver->add_clause_int(tmpLits, true, cl_stats, true, NULL, false);
+    if (cl != NULL) {
+        cl->set_imported(true);
+        solver->longRedCls.push_back(solver->cl_alloc.get_offset(cl));
+    } else if (solver->ok
+        && tmpLits.size() == 3
+        && importedTris.size() < max_imported_tris
+    ) {
+        importedTris.insert(tri_key(tmpLits[0], tmpLits[1], tmpLits[2]));
+    }
+    stats.recvLongData++;
+}
+
+DataSync::TriKey DataSync::tri_key(Lit lit1, Lit lit2, Lit lit3) const
+{
+    TriKey k = {{
+        solver->map_inter_to_outer(lit1).toInt()
+        , solver->map_inter_to_outer(lit2).toInt()
+        , solver->map_inter_to_outer(lit3).toInt()
+    }};
+    std::sort(k.begin(), k.end());
+    return k;
+}
+
+/**
+@brief Forgets the imported tri clauses that are no longer in the solver
+
+They may have been satisfied, subsumed, or removed with an eliminated
+variable. A learnt tri clause with the same literals would otherwise be
+counted as a useful import.
+*/
+void DataSync::remove_stale_imported_tris()
+{
+    for(auto it = importedTris.begin(); it != importedTris.end(); ) {
+        if (imported_tri_exists(*it)) {
+            ++it;
+        } else {
+            it = importedTris.erase(it);
+        }
+    }
+}
+
+bool DataSync::imported_tri_exists(const TriKey& k) const
+{
+    Lit lits[3];
+    for(size_t i = 0; i < 3; i++) {
+        lits[i] = solver->map_outer_to_inter(Lit::toLit(k[i]));
+        if (lits[i].var() >= solver->nVars()
+            || solver->varData[lits[i].var()].removed != Removed::none
+            || solver->value(lits[i]) != l_Undef
+        ) {
+            return false;
+        }
+    }
+
+    for(const Watched& w: solver->watches[lits[0].toInt()]) {
+        if (w.isTri()
+            && w.red()
+            && ((w.lit2() == lits[1] && w.lit3() == lits[2])
+                || (w.lit2() == lits[2] && w.lit3() == lits[1]))
+        ) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void DataSync::check_imported_tri_used(Lit lit1, Lit lit2, Lit lit3)
+{
+    if (importedTris.erase(tri_key(lit1, lit2, lit3))) {
+        stats.usefulLongData++;
+    }
+}
+
+void DataSync::exportLongClause(const vector<Lit>& lits, const uint32_t glue)
+{
+    if (must_rebuild_bva_map) {
+        outer_to_without_bva_map = solver->build_outer_to_without_bva_map();
+        must_rebuild_bva_map = false;
+    }
+
+    for(size_t i = 0; i < lits.size(); i++) {
+        Lit lit = lits[i];
+        if (solver->varData[lit.var()].is_bva)
+            return;
+
+        lit = solver->map_inter_to_outer(lit);
+        exportLits[i] = map_outside_without_bva(lit);
+    }
+    sharedData->rings[thread_num]->push(exportLits, lits.size(), glue);
+    stats.sentLongData++;
+}
+
+void DataSync::Stats::print() const
+{
+    cout << "c -------- DATA SYNC STATS --------" << endl;
+    print_stats_line("c units sent", sentUnitData);
+    print_stats_line("c units recv", recvUnitData);
+    print_stats_line("c bins sent", sentBinData);
+    print_stats_line("c bins recv", recvBinData);
+    print_stats_line("c long sent", sentLongData);
+    print_stats_line("c long recv", recvLongData);
+    print_stats_line("c long recv useful"
+        , usefulLongData
+        , stats_line_percent(usefulLongData, recvLongData)
+        , "% of recv"
+    );
+    print_stats_line("c long lost"
+        , lostLongData
+    );
+    cout << "c -------- DATA SYNC STATS END --------" << endl;
+}
+
 void DataSync::signalNewBinClause(Lit lit1, Lit lit2)
 {
     if (!enabled()) {
@@ -22,6 +22,9 @@
 #include "solvertypes.h"
 #include "watched.h"
 #include "watcharray.h"
+#include "clausering.h"
+#include <array>
+#include <unordered_set>
 
 namespace CMSat {
 
@@ -44,13 +47,23 @@ class DataSync
 
         template <class T> void signalNewBinClause(T& ps);
         void signalNewBinClause(Lit lit1, Lit lit2);
+        void signalNewLongClause(const vector<Lit>& lits, const uint32_t glue);
+        void signalImportedClauseUsed();
+        void signalTriClauseUsed(Lit lit1, Lit lit2, Lit lit3);
+        void remove_stale_imported_tris();
 
         struct Stats
         {
+            void print() const;
+
             uint32_t sentUnitData = 0;
             uint32_t recvUnitData = 0;
             uint32_t sentBinData = 0;
             uint32_t recvBinData = 0;
+            uint32_t sentLongData = 0;
+            uint32_t recvLongData = 0;
+            uint32_t usefulLongData = 0;
+            uint32_t lostLongData = 0;
         };
         const Stats& get_stats() const;
 
@@ -64,6 +77,25 @@ class DataSync
         void clear_set_binary_values();
         void addOneBinToOthers(const Lit lit1, const Lit lit2);
         bool shareBinData();
+        void exportLongClause(const vector<Lit>& lits, const uint32_t glue);
+        bool syncLongFromOthers();
+        void importLongClause(const Lit* lits, const uint32_t size, const uint32_t glue);
+        void check_imported_tri_used(Lit lit1, Lit lit2, Lit lit3);
+
+        //Imported 3-long clauses are implicit, so they have no imported flag.
+        //Their sorted outer literals are kept here until they are used.
+        //Bounded, beyond that imported tri clauses are not tracked
+        typedef std::array<uint32_t, 3> TriKey;
+        struct TriKeyHash {
+            size_t operator()(const TriKey& k) const
+            {
+                return ((size_t)k[0]*31 + k[1])*31 + k[2];
+            }
+        };
+        TriKey tri_key(Lit lit1, Lit lit2, Lit lit3) const;
+        bool imported_tri_exists(const TriKey& k) const;
+        std::unordered_set<TriKey, TriKeyHash> importedTris;
+        static const size_t max_imported_tris = 1ULL << 16;
 
         //stuff to sync
         vector<std::pair<Lit, Lit> > newBinClauses;
@@ -71,8 +103,13 @@ class DataSync
         //stats
         uint64_t lastSyncConf = 0;
         vector<uint32_t> syncFinish;
+        vector<uint64_t> ringCursor;
         Stats stats;
 
+        //Limits of what long clauses to share
+        uint32_t shareMaxGlue = 0;
+        uint32_t shareMaxSize = 0;
+
         //Other systems
         Solver* solver;
         SharedData* sharedData;
@@ -82,6 +119,8 @@ class DataSync
         vector<uint16_t>& seen;
         vector<Lit>& toClear;
         vector<uint32_t> outer_to_without_bva_map;
+        vector<Lit> tmpLits;
+        Lit exportLits[ClauseRing::max_lits];
         bool must_rebuild_bva_map = false;
 };
 
@@ -100,6 +139,31 @@ inline void DataSync::signalNewBinClause(T& ps)
     signalNewBinClause(ps[0], ps[1]);
 }
 
+inline void DataSync::signalNewLongClause(const vector<Lit>& lits, const uint32_t glue)
+{
+    if (sharedData == NULL
+        || lits.size() > shareMaxSize
+        || glue > shareMaxGlue
+    ) {
+        return;
+    }
+    exportLongClause(lits, glue);
+}
+
+inline void DataSync::signalImportedClauseUsed()
+{
+    stats.usefulLongData++;
+}
+
+//Literals are in the inter numbering
+inline void DataSync::signalTriClauseUsed(Lit lit1, Lit lit2, Lit lit3)
+{
+    if (importedTris.empty()) {
+        return;
+    }
+    check_imported_tri_used(lit1, lit2, lit3);
+}
+
 inline Lit DataSync::map_outside_without_bva(const Lit lit) const
 {
     return Lit(outer_to_without_bva_map[lit.var()], lit.sign());
@@ -28,8 +28,20 @@ THE SOFTWARE.
 #include <vector>
 #include <fstream>
 #include <complex>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <thread>
+#include <future>
 #include "assert.h"
 
+#ifndef _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 using std::vector;
 using std::cout;
 using std::endl;
@@ -86,6 +98,7 @@ int32_t DimacsParser::parseInt(StreamBuffer& in)
         << " At line " << lineNum
         << " we expected a number"
         << endl;
+        in.wait_read_ahead();
         std::exit(3);
     }
 
@@ -133,6 +146,7 @@ void DimacsParser::readClause(StreamBuffer& in)
             << "Variable requested is far too large: " << var << endl
             << "--> At line " << lineNum+1
             << endl;
+            in.wait_read_ahead();
             std::exit(-1);
         }
 
@@ -146,6 +160,7 @@ void DimacsParser::readClause(StreamBuffer& in)
             << "After each literal there must be an empty space!"
             << "--> At line " << lineNum+1 << endl
             << endl;
+            in.wait_read_ahead();
             std::exit(-1);
         }
     }
@@ -173,10 +188,12 @@ void DimacsParser::printHeader(StreamBuffer& in)
         }
         if (vars < 0) {
             std::cerr << "ERROR: Number of variables in header cannot be less than 0" << endl;
+            in.wait_read_ahead();
             exit(-1);
         }
         if (clauses < 0) {
             std::cerr << "ERROR: Number of clauses in header cannot be less than 0" << endl;
+            in.wait_read_ahead();
             exit(-1);
         }
 
@@ -188,6 +205,7 @@ void DimacsParser::printHeader(StreamBuffer& in)
         << "PARSE ERROR! Unexpected char: '" << *in
         << "' in the header, at line " << lineNum+1
         << endl;
+        in.wait_read_ahead();
         std::exit(3);
     }
 }
@@ -373,6 +391,433 @@ template <class T> void DimacsParser::parse_DIMACS(T input_stream)
     }
 }
 
+static inline bool is_blank(const char c)
+{
+    return (c >= 9 && c <= 13 && c != 10) || c == 32;
+}
+
+static inline const char* skip_blanks(const char* p, const char* end)
+{
+    while (p != end && is_blank(*p)) {
+        p++;
+    }
+    return p;
+}
+
+static inline const char* skip_to_next_line(const char* p, const char* end)
+{
+    const char* nl = (const char*)memchr(p, '\n', end - p);
+    return nl == NULL ? end : nl + 1;
+}
+
+#if defined(__GNUC__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define DIMACS_SWAR_DIGITS
+
+//Number of ASCII digits at the beginning of the 8 bytes in 'w'
+static inline uint32_t num_leading_digits(const uint64_t w)
+{
+    const uint64_t high = 0x8080808080808080ULL;
+    const uint64_t low7 = w & ~high;
+    const uint64_t at_least_0 = low7 + 0x5050505050505050ULL;
+    const uint64_t above_9 = low7 + 0x4646464646464646ULL;
+    const uint64_t non_digit = (~at_least_0 | above_9 | w) & high;
+    if (non_digit == 0) {
+        return 8;
+    }
+    return __builtin_ctzll(non_digit) / 8;
+}
+
+//Value of the first 'n' (1..8) digits in 'w'
+static inline uint64_t convert_digits(uint64_t w, const uint32_t n)
+{
+    w <<= 8*(8-n);
+    w &= 0x0F0F0F0F0F0F0F0FULL;
+    w = (w * 10 + (w >> 8)) & 0x00FF00FF00FF00FFULL;
+    w = (w * 100 + (w >> 16)) & 0x0000FFFF0000FFFFULL;
+    w = (w * 10000 + (w >> 32)) & 0xFFFFFFFFULL;
+    return w;
+}
+#endif
+
+/**
+@brief Parses the digits at 'p' into 'val', returns the first non-digit
+
+Converts 8 bytes at a time with SWAR arithmetic where the target allows it.
+Values that cannot be a valid variable anyway are not tracked exactly.
+*/
+static inline const char* parse_digits(const char* p, const char* end, uint64_t& val)
+{
+    val = 0;
+    #ifdef DIMACS_SWAR_DIGITS
+    static const uint64_t pow10[9] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000
+    };
+    while (end - p >= 8 && val < (1ULL << 32)) {
+        uint64_t w;
+        memcpy(&w, p, 8);
+        const uint32_t n = num_leading_digits(w);
+        if (n == 0) {
+            return p;
+        }
+        val = val*pow10[n] + convert_digits(w, n);
+        p += n;
+        if (n < 8) {
+            return p;
+        }
+    }
+    #endif
+
+    while (p != end && *p >= '0' && *p <= '9') {
+        val = (val < (1ULL << 32)) ? val*10 + (*p - '0') : val;
+        p++;
+    }
+    return p;
+}
+
+static inline const char* parse_signed(
+    const char* p
+    , const char* end
+    , int64_t& val
+    , bool& ok
+) {
+    p = skip_blanks(p, end);
+    bool neg = false;
+    if (p != end && (*p == '-' || *p == '+')) {
+        neg = (*p == '-');
+        p++;
+    }
+    const char* digits = p;
+    uint64_t uval;
+    p = parse_digits(p, end, uval);
+    ok = (p != digits);
+    val = neg ? -(int64_t)uval : (int64_t)uval;
+    return p;
+}
+
+const char* DimacsParser::tokenize_clause(const char* p, ParsedChunk& chunk)
+{
+    const char* end = chunk.end;
+    for(;;) {
+        int64_t parsed_lit;
+        bool ok;
+        const char* at = p;
+        p = parse_signed(p, end, parsed_lit, ok);
+        if (!ok) {
+            chunk.error_at = at;
+            chunk.error = ParseError::expected_number;
+            return NULL;
+        }
+        if (parsed_lit == 0) {
+            chunk.lits.push_back(lit_Undef);
+            return skip_to_next_line(p, end);
+        }
+
+        const uint64_t var = std::abs(parsed_lit)-1;
+        if (var >= (1ULL<<28)) {
+            chunk.error_at = at;
+            chunk.error = ParseError::var_too_large;
+            chunk.error_var = var;
+            return NULL;
+        }
+        chunk.max_var = std::max<uint32_t>(chunk.max_var, var);
+        chunk.lits.push_back(Lit(var, parsed_lit < 0));
+
+        if (p == end || *p != ' ') {
+            chunk.error_at = p;
+            chunk.error = ParseError::no_space_after_lit;
+            return NULL;
+        }
+    }
+}
+
+void DimacsParser::tokenize_chunk(ParsedChunk& chunk)
+{
+    const char* p = chunk.start;
+    const char* end = chunk.end;
+    chunk.lits.reserve((end - p)/4);
+
+    while (p != end) {
+        p = skip_blanks(p, end);
+        if (p == end) {
+            break;
+        }
+
+        switch (*p) {
+            case 'c':
+                p = skip_to_next_line(p, end);
+                break;
+
+            case '\n':
+                chunk.empty_lines++;
+                p++;
+                break;
+
+            case 'p': {
+                const char* hdr = "p cnf";
+                for(; *hdr != 0 && p != end && *p == *hdr; hdr++, p++) {
+                }
+                if (*hdr != 0) {
+                    chunk.error_at = p;
+                    chunk.error = ParseError::malformed_header;
+                    return;
+                }
+
+                int64_t vars;
+                int64_t clauses;
+                bool ok;
+                const char* at = p;
+                p = parse_signed(p, end, vars, ok);
+                if (ok) {
+                    at = p;
+                    p = parse_signed(p, end, clauses, ok);
+                }
+                if (!ok) {
+                    chunk.error_at = at;
+                    chunk.error = ParseError::expected_number;
+                    return;
+                }
+                if (vars < 0 || clauses < 0) {
+                    chunk.error_at = at;
+                    chunk.error = (vars < 0) ? ParseError::negative_header_vars
+                        : ParseError::negative_header_clauses;
+                    return;
+                }
+                if (chunk.header_vars == -1) {
+                    chunk.header_vars = vars;
+                    chunk.header_clauses = clauses;
+                }
+                p = skip_to_next_line(p, end);
+                break;
+            }
+
+            case 'x':
+            default: {
+                const size_t clause_start = chunk.lits.size();
+                if (*p == 'x') {
+                    chunk.lits.push_back(lit_Error);
+                    p++;
+                }
+                p = tokenize_clause(p, chunk);
+                if (p == NULL) {
+                    chunk.lits.resize(clause_start);
+                    return;
+                }
+                break;
+            }
+        }
+    }
+}
+
+void DimacsParser::add_parsed_chunk(const ParsedChunk& chunk)
+{
+    if (chunk.header_vars != -1) {
+        if (verbosity >= 1) {
+            cout << "c -- header says num vars:   " << std::setw(12) << chunk.header_vars << endl;
+            cout << "c -- header says num clauses:" <<  std::setw(12) << chunk.header_clauses << endl;
+        }
+        if (solver->nVars() < (size_t)chunk.header_vars) {
+            solver->new_vars(chunk.header_vars - solver->nVars());
+        }
+    }
+    if (!chunk.lits.empty() && solver->nVars() <= chunk.max_var) {
+        solver->new_vars(chunk.max_var + 1 - solver->nVars());
+    }
+
+    //Runs of normal clauses are already in the format add_clauses() takes
+    const vector<Lit>& cls = chunk.lits;
+    size_t at = 0;
+    while (at < cls.size()) {
+        if (cls[at] == lit_Error) {
+            at++;
+            bool rhs = true;
+            vars.clear();
+            for(; cls[at] != lit_Undef; at++) {
+                vars.push_back(cls[at].var());
+                rhs ^= cls[at].sign();
+            }
+            at++;
+            if (!vars.empty()) {
+                solver->add_xor_clause(vars, rhs);
+                xor_clauses_added++;
+            }
+            continue;
+        }
+
+        const size_t run_start = at;
+        while (at < cls.size() && cls[at] != lit_Error) {
+            while (cls[at] != lit_Undef) {
+                at++;
+            }
+            at++;
+            norm_clauses_added++;
+        }
+        solver->add_clauses(cls.data() + run_start, at - run_start);
+    }
+
+    if (chunk.empty_lines > 0) {
+        std::cerr
+        << "c WARNING: " << chunk.empty_lines << " empty line(s)"
+        << " -- this is not part of the DIMACS specifications. Ignoring."
+        << endl;
+    }
+
+}
+
+//Same messages and exit codes as parse_DIMACS()
+void DimacsParser::exit_on_parse_error(const ParsedChunk& chunk, const char* file_start) const
+{
+    const size_t line = 1 + std::count(file_start, chunk.error_at, '\n');
+    const char* at = skip_blanks(chunk.error_at, chunk.end);
+    const int c = (at == chunk.end) ? EOF : *at;
+    switch (chunk.error) {
+        case ParseError::expected_number:
+            cout
+            << "PARSE ERROR! Unexpected char (dec: '" << (char)c << ")"
+            << " At line " << line
+            << " we expected a number"
+            << endl;
+            std::exit(3);
+
+        case ParseError::var_too_large:
+            std::cerr
+            << "ERROR! "
+            << "Variable requested is far too large: " << chunk.error_var << endl
+            << "--> At line " << line
+            << endl;
+            std::exit(-1);
+
+        case ParseError::no_space_after_lit:
+            std::cerr
+            << "ERROR! "
+            << "After each literal there must be an empty space!"
+            << "--> At line " << line << endl
+            << endl;
+            std::exit(-1);
+
+        case ParseError::malformed_header:
+            std::cerr
+            << "PARSE ERROR! Unexpected char: '" << (char)c
+            << "' in the header, at line " << line
+            << endl;
+            std::exit(3);
+
+        case ParseError::negative_header_vars:
+            std::cerr << "ERROR: Number of variables in header cannot be less than 0" << endl;
+            std::exit(-1);
+
+        case ParseError::negative_header_clauses:
+            std::cerr << "ERROR: Number of clauses in header cannot be less than 0" << endl;
+            std::exit(-1);
+
+        case ParseError::none:
+            break;
+    }
+    assert(false);
+}
+
+bool DimacsParser::parse_DIMACS_mmap(const std::string& filename, unsigned num_threads)
+{
+    #ifdef _WIN32
+    return false;
+    #else
+    if (debugLib) {
+        return false;
+    }
+
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd == -1) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size < 2) {
+        close(fd);
+        return false;
+    }
+    const size_t size = st.st_size;
+    void* mem = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mem == MAP_FAILED) {
+        return false;
+    }
+    const char* data = (const char*)mem;
+
+    //gzip magic
+    if ((unsigned char)data[0] == 0x1f && (unsigned char)data[1] == 0x8b) {
+        munmap(mem, size);
+        return false;
+    }
+    madvise(mem, size, MADV_SEQUENTIAL);
+
+    if (num_threads == 0) {
+        num_threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    //The file is processed in windows of num_threads chunks, each chunk
+    //tokenized by a separate thread. The next window is tokenized while the
+    //clauses of the current one are being added
+    const size_t chunk_size = 16ULL*1024ULL*1024ULL;
+    const char* file_end = data + size;
+    auto tokenize_window = [=](const char* from) {
+        vector<ParsedChunk> chunks;
+        while (from != file_end && chunks.size() < num_threads) {
+            ParsedChunk chunk;
+            chunk.start = from;
+            chunk.end = from + std::min<size_t>(chunk_size, file_end - from);
+            if (chunk.end != file_end) {
+                chunk.end = skip_to_next_line(chunk.end, file_end);
+            }
+            from = chunk.end;
+            chunks.push_back(std::move(chunk));
+        }
+
+        vector<std::thread> threads;
+        for(size_t i = 1; i < chunks.size(); i++) {
+            threads.push_back(std::thread(tokenize_chunk, std::ref(chunks[i])));
+        }
+        if (!chunks.empty()) {
+            tokenize_chunk(chunks[0]);
+        }
+        for(std::thread& t: threads) {
+            t.join();
+        }
+        return chunks;
+    };
+
+    const uint32_t origNumVars = solver->nVars();
+    vector<ParsedChunk> window = tokenize_window(data);
+    while (!window.empty()) {
+        const char* next_start = window.back().end;
+        std::future<vector<ParsedChunk> > next;
+        if (window.back().error == ParseError::none) {
+            next = std::async(std::launch::async, tokenize_window, next_start);
+        }
+
+        for(const ParsedChunk& chunk: window) {
+            add_parsed_chunk(chunk);
+            if (chunk.error != ParseError::none) {
+                //Don't exit while the next window is being tokenized
+                if (next.valid()) {
+                    next.wait();
+                }
+                exit_on_parse_error(chunk, data);
+            }
+        }
+        window = next.valid() ? next.get() : vector<ParsedChunk>();
+    }
+    munmap(mem, size);
+
+    if (verbosity >= 1) {
+        cout
+        << "c -- clauses added: " << norm_clauses_added << endl
+        << "c -- xor clauses added: " << xor_clauses_added << endl
+        << "c -- vars added " << (solver->nVars() - origNumVars)
+        << endl;
+    }
+
+    return true;
+    #endif
+}
+
 #ifdef USE_ZLIB
 template void DimacsParser::parse_DIMACS(gzFile input_stream);
 #else
@@ -42,7 +42,48 @@ class DimacsParser
 
         template <class T> void parse_DIMACS(T input_stream);
 
+        /**
+        @brief Parses an uncompressed file through mmap, tokenizing in parallel
+
+        @returns false (without having added anything) if the file must go
+        through parse_DIMACS() instead: it cannot be mapped, it is gzipped,
+        or debugLib is set. num_threads == 0 means one per hardware thread.
+        */
+        bool parse_DIMACS_mmap(const std::string& filename, unsigned num_threads = 0);
+
     private:
+        enum class ParseError {
+            none
+            , expected_number
+            , var_too_large
+            , no_space_after_lit
+            , malformed_header
+            , negative_header_vars
+            , negative_header_clauses
+        };
+
+        ///Tokenized part of a mapped file. Each clause is terminated by
+        ///lit_Undef, xor clauses are also preceded by lit_Error
+        struct ParsedChunk
+        {
+            const char* start = NULL;
+            const char* end = NULL;
+            vector<Lit> lits;
+            uint32_t max_var = 0;
+            int64_t header_vars = -1;
+            int64_t header_clauses = -1;
+            size_t empty_lines = 0;
+
+            //Set if parsing stopped at 'error_at'
+            const char* error_at = NULL;
+            ParseError error = ParseError::none;
+            uint64_t error_var = 0;
+        };
+        static void tokenize_chunk(ParsedChunk& chunk);
+        static const char* tokenize_clause(const char* p, ParsedChunk& chunk);
+        void add_parsed_chunk(const ParsedChunk& chunk);
+        void exit_on_parse_error(const ParsedChunk& chunk, const char* file_start) const;
+
         void parse_DIMACS_main(StreamBuffer& in);
         void skipWhitespace(StreamBuffer& in);
         void skipLine(StreamBuffer& in);
@@ -23,14 +23,11 @@
 
 #include <iostream>
 #include <iomanip>
-#include "clause.h"
 #include <algorithm>
 #include <iterator>
 
-#include "clausecleaner.h"
-#include "varreplacer.h"
+#include "clause.h"
 #include "solver.h"
-//#include "cmsat/DataSync.h"
 
 //#define VERBOSE_DEBUG
 //#define DEBUG_GAUSS
@@ -40,21 +37,19 @@ using std::ostream;
 using std::cout;
 using std::endl;
 
-static const uint16_t unassigned_col = std::numeric_limits<uint16_t>::max();
-static const Var unassigned_var = std::numeric_limits<Var>::max();
+static const uint32_t unassigned_col = std::numeric_limits<uint32_t>::max();
 
 Gaussian::Gaussian(
     Solver* _solver
     , const GaussConf& _config
     , const uint32_t _matrix_no
-    , const vector<Xor*>& _xorclauses
+    , const vector<Xor>& _xorclauses
 ) :
     solver(_solver)
     , config(_config)
     , matrix_no(_matrix_no)
     , xorclauses(_xorclauses)
-    , messed_matrix_vars_since_reversal(true)
-    , gauss_last_level(0)
+    , must_restore(false)
     , disabled(false)
     , useful_prop(0)
     , useful_confl(0)
@@ -70,209 +65,95 @@ Gaussian::~Gaussian()
     }
 }
 
-inline void Gaussian::set_matrixset_to_cur()
-{
-    uint32_t level = solver->decisionLevel() / config.only_nth_gauss_save;
-    assert(level <= matrix_sets.size());
-
-    if (level == matrix_sets.size())
-        matrix_sets.push_back(cur_matrixset);
-    else
-        matrix_sets[level] = cur_matrixset;
-}
-
-bool Gaussian::clean_one_xor(Xor& x)
-{
-    bool rhs = x.rhs;
-    size_t i = 0;
-    size_t j = 0;
-    for(size_t size = x.vars.size(); i < size; i++) {
-        Var var = x.vars[i];
-        if (solver->value(i) != l_Undef) {
-            if (solver->value(i) == l_True) {
-                rhs ^= true;
-            }
-        } else {
-            x.vars[j++] = var;
-        }
-    }
-    x.vars.resize(x.vars.size()-(i-j));
-
-    switch(x.vars.size()) {
-        case 0:
-            solver->ok &= !x.rhs;
-            return false;
-
-        case 1: {
-            solver->fully_enqueue_this(Lit(x.vars[0], !x.rhs));
-            return false;
-        }
-        case 2: {
-            solver->add_xor_clause_inter(vars_to_lits(x.vars), x.rhs);
-            return false;
-        }
-        default: {
-            return true;
-            break;
-        }
-    }
-}
-
-bool Gaussian::clean_xor_clauses()
-{
-    size_t i = 0;
-    size_t j = 0;
-    for(size_t size = xorclauses.size(); i < size; i++) {
-        Xor& x = xorclauses[i];
-        bool ret = clean_one_xor(x);
-        if (!solver->ok) {
-            return false;
-        }
-
-        if (ret) {
-            xorclauses[j++] = x;
-        }
-    }
-    return solver->ok;
-}
-
 bool Gaussian::init_until_fixedpoint()
 {
     assert(solver->ok);
     assert(solver->decisionLevel() == 0);
 
-    if (!should_init()) return true;
-    reset_stats();
-    uint32_t last_trail_size = solver->trail.size();
-
-    bool do_again_gauss = true;
-    while (do_again_gauss) {
-        if (!clean_xor_clauses()) {
-            return false;
-        }
-        if (last_trail_size < solver->trail.size()) {
-            continue;
-        }
-        do_again_gauss = false;
-
-        init();
-        PropBy confl;
-        gaussian_ret g = gaussian(confl);
-        switch (g) {
-        case unit_conflict:
-        case conflict:
-            #ifdef VERBOSE_DEBUG
-            cout << "(" << matrix_no << ")conflict at level 0" << std::endl;
-            #endif
-            solver->ok = false;
-            return false;
-        case unit_propagation:
-        case propagation:
-            unit_truths += last_trail_size - solver->trail.size();
-            do_again_gauss = true;
-            solver->ok = (solver->propagate().isNULL());
-            if (!solver->ok) return false;
-            break;
-        case nothing:
-            break;
-        }
+    select_columnorder();
+    if (xorclauses.empty() || col_to_var_original.empty()) {
+        disabled = true;
+        return true;
     }
+    fill_matrix(cur_matrixset);
+    matrix_sets.clear();
+    must_restore = false;
 
-    return true;
-}
+    while(true) {
+        update_matrix(cur_matrixset);
+        PropBy confl;
+        Lit failBinLit = lit_Undef;
+        const gauss_ret ret = handle_matrix_prop_and_confl(cur_matrixset, confl, failBinLit);
+        switch(ret) {
+            case gauss_false:
+                return false;
+
+            case gauss_prop:
+                solver->ok = solver->propagate<false>().isNULL();
+                if (!solver->ok) {
+                    return false;
+                }
+                continue;
 
-void Gaussian::init()
-{
-    assert(solver->decisionLevel() == 0);
+            case gauss_nothing:
+                break;
 
-    fill_matrix(cur_matrixset);
-    if (!cur_matrixset.num_rows || !cur_matrixset.num_cols) {
-        disabled = true;
-        badlevel = 0;
-        return;
+            case gauss_confl:
+            default:
+                //Conflicts at decision level 0 are returned as gauss_false
+                assert(false);
+                break;
+        }
+        break;
     }
 
-    matrix_sets.clear();
+    cur_matrixset.level = 0;
     matrix_sets.push_back(cur_matrixset);
-    gauss_last_level = solver->trail.size();
-    messed_matrix_vars_since_reversal = false;
-    badlevel = std::numeric_limits<uint32_t>::max();
 
     #ifdef VERBOSE_DEBUG
     cout << "(" << matrix_no << ")Gaussian init finished." << endl;
     #endif
+
+    return solver->ok;
 }
 
-uint32_t Gaussian::select_columnorder(vector<uint16_t>& var_to_col, matrixset& origMat)
+void Gaussian::select_columnorder()
 {
+    var_to_col.clear();
     var_to_col.resize(solver->nVars(), unassigned_col);
+    col_to_var_original.clear();
 
-    uint32_t num_xorclauses  = 0;
-    for (uint32_t i = 0; i != xorclauses.size(); i++) {
-        Xor& c = *xorclauses[i];
-        if (c.getRemoved()) continue;
-        num_xorclauses++;
-
-        for (uint32_t i2 = 0; i2 < c.size(); i2++) {
-            assert(solver->value(c[i2].var()) == l_Undef);
-            var_to_col[c[i2].var()] = unassigned_col - 1;
-        }
-    }
-
-    uint32_t largest_used_var = 0;
-    for (uint32_t i = 0; i < var_to_col.size(); i++)
-        if (var_to_col[i] != unassigned_col)
-            largest_used_var = i;
-    var_to_col.resize(largest_used_var + 1);
-
-    var_is_in.resize(var_to_col.size(), 0);
-    origMat.var_is_set.resize(var_to_col.size(), 0);
-
-    origMat.col_to_var.clear();
-    vector<Var> vars(solver->nVars());
-    if (!config.orderCols) {
-        for (uint32_t i = 0; i < solver->nVars(); i++) {
-            vars.push_back(i);
+    vector<Var> vars;
+    for (const Xor& x: xorclauses) {
+        for (const Var var: x.vars) {
+            assert(var < solver->nVars());
+            if (var_to_col[var] == unassigned_col) {
+                var_to_col[var] = unassigned_col - 1;
+                vars.push_back(var);
+            }
         }
-        std::random_shuffle(vars.begin(), vars.end());
     }
 
-    Heap<Solver::VarOrderLt> order_heap(solver->order_heap);
-    uint32_t iterReduceIt = 0;
-    while ((config.orderCols && !order_heap.empty()) || (!config.orderCols && iterReduceIt < vars.size()))
-    {
-        Var v;
-        if (config.orderCols) v = order_heap.removeMin();
-        else v = vars[iterReduceIt++];
-        if (var_to_col[v] == 1) {
-            #ifdef DEBUG_GAUSS
-            vector<uint32_t>::iterator it =
-                std::find(origMat.col_to_var.begin(), origMat.col_to_var.end(), v);
-            assert(it == origMat.col_to_var.end());
-            #endif
-
-            origMat.col_to_var.push_back(v);
-            var_to_col[v] = origMat.col_to_var.size()-1;
-            var_is_in.setBit(v);
-        }
+    //Most active variables first, they will be the pivots
+    if (config.orderCols) {
+        const vector<double>& activities = solver->activities;
+        std::stable_sort(vars.begin(), vars.end(),
+            [&activities](const Var a, const Var b) {
+                return activities[a] > activities[b];
+            }
+        );
     }
 
-    //for the ones that were not in the order_heap, but are marked in var_to_col
-    for (uint32_t v = 0; v != var_to_col.size(); v++) {
-        if (var_to_col[v] == unassigned_col - 1) {
-            origMat.col_to_var.push_back(v);
-            var_to_col[v] = origMat.col_to_var.size() -1;
-            var_is_in.setBit(v);
-        }
+    for (const Var var: vars) {
+        var_to_col[var] = col_to_var_original.size();
+        col_to_var_original.push_back(var);
     }
 
     #ifdef VERBOSE_DEBUG_MORE
     cout << "(" << matrix_no << ")col_to_var:";
-    std::copy(origMat.col_to_var.begin(), origMat.col_to_var.end(), std::ostream_iterator<uint32_t>(cout, ","));
+    std::copy(col_to_var_original.begin(), col_to_var_original.end(), std::ostream_iterator<uint32_t>(cout, ","));
     cout << endl;
     #endif
-
-    return num_xorclauses;
 }
 
 void Gaussian::fill_matrix(matrixset& origMat)
@@ -281,643 +162,303 @@ void Gaussian::fill_matrix(matrixset& origMat)
     cout << "(" << matrix_no << ")Filling matrix" << endl;
     #endif
 
-    vector<uint16_t> var_to_col;
-    origMat.num_rows = select_columnorder(var_to_col, origMat);
-    origMat.num_cols = origMat.col_to_var.size();
-    col_to_var_original = origMat.col_to_var;
-    changed_rows.resize(origMat.num_rows);
-    memset(&changed_rows[0], 0, sizeof(unsigned char)*changed_rows.size());
-
-    origMat.last_one_in_col.resize(origMat.num_cols);
-    std::fill(origMat.last_one_in_col.begin(), origMat.last_one_in_col.end(), origMat.num_rows);
-    origMat.first_one_in_row.resize(origMat.num_rows);
-
-    origMat.removeable_cols = 0;
-    origMat.least_column_changed = -1;
+    origMat.num_rows = xorclauses.size();
+    origMat.num_cols = col_to_var_original.size();
     origMat.matrix.resize(origMat.num_rows, origMat.num_cols);
+    origMat.row_pivot.clear();
+    origMat.row_pivot.resize(origMat.num_rows, unassigned_col);
+    origMat.level = 0;
+    origMat.trail_at = 0;
+
+    changed_rows.clear();
+    changed_rows.resize(origMat.num_rows, 0);
+    changed_rows_list.clear();
+    conflict_rows.clear();
 
     #ifdef VERBOSE_DEBUG
     cout << "(" << matrix_no << ")matrix size:" << origMat.num_rows << "," << origMat.num_cols << endl;
     #endif
 
-    uint32_t matrix_row = 0;
     for (uint32_t i = 0; i != xorclauses.size(); i++) {
-        const Xor& c = *xorclauses[i];
-        if (c.getRemoved()) continue;
-
-        origMat.matrix.getVarsetAt(matrix_row).set(c, var_to_col, origMat.num_cols);
-        origMat.matrix.getMatrixAt(matrix_row).set(c, var_to_col, origMat.num_cols);
-        matrix_row++;
+        const Xor& c = xorclauses[i];
+        origMat.matrix.getVarsetAt(i).set(c, var_to_col);
+        origMat.matrix.getMatrixAt(i).set(c, var_to_col);
     }
-    assert(origMat.num_rows == matrix_row);
+
+    eliminate(origMat);
 }
 
-void Gaussian::update_matrix_col(matrixset& m, const Var var, const uint32_t col)
+void Gaussian::eliminate(matrixset& m)
 {
-    #ifdef VERBOSE_DEBUG_MORE
-    cout << "(" << matrix_no << ")Updating matrix var " << var+1
-    << " (col " << col << ", m.last_one_in_col[col]: " << m.last_one_in_col[col] << ")"
-    << endl;
-    cout << "m.num_rows:" << m.num_rows << endl;
-    #endif
-
-    #ifdef DEBUG_GAUSS
-    assert(col < m.num_cols);
-    #endif
-
-    m.least_column_changed = std::min(m.least_column_changed, (int)col);
-    PackedMatrix::iterator this_row = m.matrix.beginMatrix();
-    uint32_t row_num = 0;
+    uint32_t row = 0;
+    PackedMatrix::iterator beginIt = m.matrix.beginMatrix();
+    PackedMatrix::iterator endIt = m.matrix.endMatrix();
+    for (uint32_t col = 0; col != m.num_cols && row != m.num_rows; col++) {
+        //Find pivot in column col, starting in row 'row'
+        PackedMatrix::iterator rowIt = beginIt + row;
+        PackedMatrix::iterator this_matrix_row = rowIt;
+        for (; this_matrix_row != endIt; ++this_matrix_row) {
+            if ((*this_matrix_row)[col])
+                break;
+        }
+        if (this_matrix_row == endIt)
+            continue;
 
-    if (solver->value(var)) {
-        for (uint32_t end = m.last_one_in_col[col];  row_num != end; ++this_row, row_num++) {
-            if ((*this_row)[col]) {
-                changed_rows[row_num] = true;
-                (*this_row).invert_is_true();
-                (*this_row).clearBit(col);
-            }
+        if (this_matrix_row != rowIt) {
+            (*rowIt).swapBoth(*this_matrix_row);
         }
-    } else {
-        for (uint32_t end = m.last_one_in_col[col];  row_num != end; ++this_row, row_num++) {
-            if ((*this_row)[col]) {
-                changed_rows[row_num] = true;
-                (*this_row).clearBit(col);
+
+        //Clear the column everywhere else, above the pivot too
+        uint32_t row_num = 0;
+        for (PackedMatrix::iterator it = beginIt; it != endIt; ++it, row_num++) {
+            if (row_num != row && (*it)[col]) {
+                (*it).xorBoth(*rowIt);
             }
         }
+        m.row_pivot[row] = col;
+        row++;
     }
 
-    #ifdef DEBUG_GAUSS
-    bool c = false;
-    for(PackedMatrix::iterator r = m.matrix.beginMatrix(), end = r + m.matrix.getSize(); r != end; ++r)
-        c |= (*r)[col];
-    assert(!c);
-    #endif
-
-    m.removeable_cols++;
-    m.col_to_var[col] = unassigned_var;
-    m.var_is_set.setBit(var);
+    //The rest are empty
+    for (; row != m.num_rows; row++) {
+        m.row_pivot[row] = unassigned_col;
+        if (m.matrix.getMatrixAt(row).is_true()) {
+            conflict_rows.push_back(row);
+        }
+    }
 }
 
-void Gaussian::update_matrix_by_col_all(matrixset& m)
+inline void Gaussian::mark_changed(const uint32_t row)
 {
-    #ifdef VERBOSE_DEBUG
-    cout << "(" << matrix_no << ")Updating matrix." << endl;
-    #ifdef VERBOSE_DEBUG_MORE
-    print_matrix(m);
-    #endif
-    uint32_t num_updated = 0;
-    #endif
-
-    #ifdef DEBUG_GAUSS
-    assert(nothing_to_propagate(cur_matrixset));
-    assert(solver->decisionLevel() == 0 || check_last_one_in_cols(m));
-    #endif
-
-    memset(&changed_rows[0], 0, sizeof(unsigned char)*changed_rows.size());
-
-    uint32_t last = 0;
-    uint32_t col = 0;
-    for (const Var *it = &m.col_to_var[0], *end = it + m.num_cols; it != end; col++, it++) {
-        if (*it != unassigned_var && solver->value(*it) != l_Undef) {
-            update_matrix_col(m, *it, col);
-            last++;
-            #ifdef VERBOSE_DEBUG
-            num_updated++;
-            #endif
-        } else
-            last = 0;
+    if (!changed_rows[row]) {
+        changed_rows[row] = 1;
+        changed_rows_list.push_back(row);
     }
-    m.num_cols -= last;
-
-    #ifdef DEBUG_GAUSS
-    check_matrix_against_varset(m.matrix, m);
-    #endif
+}
 
-    #ifdef VERBOSE_DEBUG
-    cout << "Matrix update finished, updated " << num_updated << " cols" << endl;
+void Gaussian::update_matrix_col(matrixset& m, const Var var, const uint32_t col)
+{
     #ifdef VERBOSE_DEBUG_MORE
-    print_matrix(m);
-    #endif
+    cout << "(" << matrix_no << ")Updating matrix var " << var+1
+    << " (col " << col << ")" << endl;
     #endif
 
-    /*cout << "num_rows:" << m.num_rows;
-    cout << " num_rows diff:" << origMat.num_rows - m.num_rows << endl;
-    cout << "num_cols:" << col_to_var_original.size();
-    cout << " num_cols diff:" << col_to_var_original.size() - m.col_to_var.size() << endl;
-    cout << "removeable cols:" << m.removeable_cols << endl;*/
-}
+    const bool val = (solver->value(var) == l_True);
+    uint32_t row_num = 0;
+    for (PackedMatrix::iterator
+        it = m.matrix.beginMatrix(), end = m.matrix.endMatrix()
+        ; it != end
+        ; ++it, row_num++
+    ) {
+        PackedRow row = *it;
+        if (!row[col])
+            continue;
 
-inline void Gaussian::update_last_one_in_col(matrixset& m)
-{
-    for (uint16_t* i = &m.last_one_in_col[0]+m.last_one_in_col.size()-1, *end = &m.last_one_in_col[0]-1; i != end && *i >= m.num_rows; i--)
-        *i = m.num_rows;
+        row.clearBit(col);
+        row.invert_is_true(val);
+        mark_changed(row_num);
+        if (m.row_pivot[row_num] == col) {
+            lost_pivot.push_back(row_num);
+        }
+    }
 }
 
-Gaussian::gaussian_ret Gaussian::gaussian(PropBy& confl)
+void Gaussian::set_pivot(matrixset& m, const uint32_t row)
 {
-    //cout << ">>G-----" << endl;
-    if (solver->decisionLevel() >= badlevel) {
-        //cout << "Over badlevel" << endl;
-        //cout << "<<----G" << endl;
-        return nothing;
-    }
-
-    const uint32_t level = solver->decisionLevel() / config.only_nth_gauss_save;
-    //cout << "level: " << level << " matrix_sets.size(): " << matrix_sets.size() << endl;
-
-    if (messed_matrix_vars_since_reversal) {
-        #ifdef VERBOSE_DEBUG
-        cout << "(" << matrix_no << ")matrix needs copy before update" << endl;
-        #endif
-
-        assert(level < matrix_sets.size());
-        cur_matrixset = matrix_sets[level];
-    }
-    update_last_one_in_col(cur_matrixset);
-    update_matrix_by_col_all(cur_matrixset);
-
-    messed_matrix_vars_since_reversal = false;
-    gauss_last_level = solver->trail.size();
-    badlevel = std::numeric_limits<uint32_t>::max();
-
-    propagatable_rows.clear();
-    uint32_t last_row = eliminate(cur_matrixset);
-    #ifdef DEBUG_GAUSS
-    check_matrix_against_varset(cur_matrixset.matrix, cur_matrixset);
-    #endif
-
-    gaussian_ret ret;
-    //There is no early abort, so this is unneeded
-    /*if (conflict_row != std::numeric_limits<uint32_t>::max()) {
-        uint32_t maxlevel = std::numeric_limits<uint32_t>::max();
-        uint32_t size = std::numeric_limits<uint32_t>::max();
-        uint32_t best_row = std::numeric_limits<uint32_t>::max();
-        analyse_confl(cur_matrixset, conflict_row, maxlevel, size, best_row);
-        ret = handle_matrix_confl(confl, cur_matrixset, size, maxlevel, best_row);
-    } else {*/
-        ret = handle_matrix_prop_and_confl(cur_matrixset, last_row, confl);
-    //}
-    #ifdef DEBUG_GAUSS
-    assert(ret == conflict || ret == unit_conflict || nothing_to_propagate(cur_matrixset));
-    #endif
-
-    if (!cur_matrixset.num_cols || !cur_matrixset.num_rows) {
-        badlevel = solver->decisionLevel();
-        //cout << "Set badlevel to " << badlevel << endl;
-        //cout << "<<----G" << endl;
-        return ret;
+    PackedRow pivot_row = m.matrix.getMatrixAt(row);
+    const uint32_t col = pivot_row.scan(0);
+    if (col == std::numeric_limits<uint32_t>::max()) {
+        m.row_pivot[row] = unassigned_col;
+        if (pivot_row.is_true()) {
+            conflict_rows.push_back(row);
+        }
+        return;
     }
 
-    /*cout << "ret is :";
-    if (ret == nothing) {
-        cout << "nothing" << endl;
-    } else if (ret == conflict) {
-        cout << "conflict" << endl;
-    } else if (ret == unit_conflict) {
-        cout << "unit_conflict";
-    } else if (ret == propagation) {
-        cout << "propagation";
-    } else if (ret == unit_propagation) {
-        cout << "unit propagation";
-    }*/
-
-    if (ret == nothing &&
-        solver->decisionLevel() % config.only_nth_gauss_save == 0
+    m.row_pivot[row] = col;
+    uint32_t row_num = 0;
+    for (PackedMatrix::iterator
+        it = m.matrix.beginMatrix(), end = m.matrix.endMatrix()
+        ; it != end
+        ; ++it, row_num++
     ) {
-        set_matrixset_to_cur();
+        if (row_num != row && (*it)[col]) {
+            (*it).xorBoth(pivot_row);
+            mark_changed(row_num);
+        }
     }
-
-    #ifdef VERBOSE_DEBUG
-    if (ret == nothing)
-        cout << "(" << matrix_no << ")Useless. ";
-    else
-        cout << "(" << matrix_no << ")Useful. ";
-    cout << "(" << matrix_no << ")Useful prop in " << ((double)useful_prop/(double)called)*100.0 << "%" << endl;
-    cout << "(" << matrix_no << ")Useful confl in " << ((double)useful_confl/(double)called)*100.0 << "%" << endl;
-    #endif
-
-    //cout << "<<----G" << endl;
-    return ret;
 }
 
-uint32_t Gaussian::eliminate(matrixset& m)
+void Gaussian::update_matrix(matrixset& m)
 {
-    #ifdef VERBOSE_DEBUG
-    cout << "(" << matrix_no << ")";
-    cout << "Starting elimination" << endl;
-    cout << "m.least_column_changed:" << m.least_column_changed << endl;
-    #ifdef VERBOSE_DEBUG_MORE
-    print_last_one_in_cols(m);
-    #endif
-
-    uint32_t number_of_row_additions = 0;
-    uint32_t no_exchanged = 0;
-    #endif
-
-    if (m.least_column_changed == INT_MAX) {
-        #ifdef VERBOSE_DEBUG
-        cout << "Nothing to eliminate" << endl;
-        #endif
-
-        return m.num_rows;
-    }
-
-
-    #ifdef DEBUG_GAUSS
-    assert(solver->decisionLevel() == 0 || check_last_one_in_cols(m));
-    #endif
-
-    uint32_t i = 0;
-    uint32_t j = (config.iterativeReduce) ? m.least_column_changed + 1 : 0;
-    PackedMatrix::iterator beginIt = m.matrix.beginMatrix();
-    PackedMatrix::iterator rowIt = m.matrix.beginMatrix();
-
-    #ifdef DEBUG_GAUSS
-    check_first_one_in_row(m, j);
-    #endif
-
-    if (j) {
-        uint16_t until = std::min(m.last_one_in_col[m.least_column_changed] - 1, (int)m.num_rows);
-        if (j-1 > m.first_one_in_row[m.num_rows-1])
-            until = m.num_rows;
-        for (;i != until; i++, ++rowIt) if (changed_rows[i] && (*rowIt).popcnt_is_one(m.first_one_in_row[i]))
-            propagatable_rows.push(i);
-    }
-
-    #ifdef VERBOSE_DEBUG
-    cout << "At while() start: i,j = " << i << ", " << j << endl;
-    cout << "num_rows:" << m.num_rows << " num_cols:" << m.num_cols << endl;
-    #endif
-
-    if (j > m.num_cols) {
-        #ifdef VERBOSE_DEBUG
-        cout << "Going straight to finish" << endl;
-        #endif
-        goto finish;
-    }
-
-    #ifdef DEBUG_GAUSS
-    assert(i <= m.num_rows && j <= m.num_cols);
-    #endif
-
-    while (i != m.num_rows && j != m.num_cols) {
-        //Find pivot in column j, starting in row i:
-
-        if (m.col_to_var[j] == unassigned_var) {
-            j++;
+    lost_pivot.clear();
+    for (; m.trail_at < solver->trail.size(); m.trail_at++) {
+        const Var var = solver->trail[m.trail_at].var();
+        if (var >= var_to_col.size()
+            || var_to_col[var] == unassigned_col
+        ) {
             continue;
         }
-
-        PackedMatrix::iterator this_matrix_row = rowIt;
-        PackedMatrix::iterator end = beginIt + m.last_one_in_col[j];
-        for (; this_matrix_row != end; ++this_matrix_row) {
-            if ((*this_matrix_row)[j])
-                break;
-        }
-
-        if (this_matrix_row != end) {
-
-            //swap rows i and maxi, but do not change the value of i;
-            if (this_matrix_row != rowIt) {
-                #ifdef VERBOSE_DEBUG
-                no_exchanged++;
-                #endif
-
-                //Would early abort, but would not find the best conflict (and would be expensive)
-                //if (matrix_row_i.is_true() && matrix_row_i.isZero()) {
-                //    conflict_row = i;
-                //    return 0;
-                //}
-                (*rowIt).swapBoth(*this_matrix_row);
-            }
-            #ifdef DEBUG_GAUSS
-            assert(m.matrix.getMatrixAt(i).popcnt(j) == m.matrix.getMatrixAt(i).popcnt());
-            assert(m.matrix.getMatrixAt(i)[j]);
-            #endif
-
-            if ((*rowIt).popcnt_is_one(j))
-                propagatable_rows.push(i);
-
-            //Now A[i,j] will contain the old value of A[maxi,j];
-            ++this_matrix_row;
-            for (; this_matrix_row != end; ++this_matrix_row) if ((*this_matrix_row)[j]) {
-                //subtract row i from row u;
-                //Now A[u,j] will be 0, since A[u,j] - A[i,j] = A[u,j] -1 = 0.
-                #ifdef VERBOSE_DEBUG
-                number_of_row_additions++;
-                #endif
-
-                (*this_matrix_row).xorBoth(*rowIt);
-                //Would early abort, but would not find the best conflict (and would be expensive)
-                //if (it->is_true() &&it->isZero()) {
-                //    conflict_row = i2;
-                //    return 0;
-                //}
-            }
-            m.first_one_in_row[i] = j;
-            i++;
-            ++rowIt;
-            m.last_one_in_col[j] = i;
-        } else {
-            m.first_one_in_row[i] = j;
-            m.last_one_in_col[j] = i + 1;
-        }
-        j++;
+        update_matrix_col(m, var, var_to_col[var]);
     }
 
-    finish:
-
-    m.least_column_changed = INT_MAX;
-
-    #ifdef VERBOSE_DEBUG
-    cout << "Finished elimination" << endl;
-    cout << "Returning with i,j:" << i << ", " << j << "(" << m.num_rows << ", " << m.num_cols << ")" << endl;
-    #ifdef VERBOSE_DEBUG_MORE
-    print_matrix(m);
-    print_last_one_in_cols(m);
-    #endif
-    cout << "(" << matrix_no << ")Exchanged:" << no_exchanged << " row additions:" << number_of_row_additions << endl;
-    #endif
-
-    #ifdef DEBUG_GAUSS
-    assert(check_last_one_in_cols(m));
-    uint32_t row = 0;
-    uint32_t col = 0;
-    for (; col < m.num_cols && row < m.num_rows && row < i ; col++) {
-        assert(m.matrix.getMatrixAt(row).popcnt() == m.matrix.getMatrixAt(row).popcnt(col));
-        assert(!(m.col_to_var[col] == unassigned_var && m.matrix.getMatrixAt(row)[col]));
-        if (m.col_to_var[col] == unassigned_var || !m.matrix.getMatrixAt(row)[col]) {
-            #ifdef VERBOSE_DEBUG_MORE
-            cout << "row:" << row << " col:" << col << " m.last_one_in_col[col]-1: " << m.last_one_in_col[col]-1 << endl;
-            #endif
-            assert(m.col_to_var[col] == unassigned_var || std::min((uint16_t)(m.last_one_in_col[col]-1), m.num_rows) == row);
-            continue;
-        }
-        row++;
+    for (const uint32_t row: lost_pivot) {
+        set_pivot(m, row);
     }
-    #endif
-
-    return i;
 }
 
-Gaussian::gaussian_ret Gaussian::handle_matrix_confl(
-    PropBy& confl
-    , const matrixset& m
-    , const uint32_t maxlevel
-    , const uint32_t best_row
-) {
-    assert(best_row != std::numeric_limits<uint32_t>::max());
-
-    const bool xorEqualFalse = !m.matrix.getVarsetAt(best_row).is_true();
-    const bool wasUndef = m.matrix.getVarsetAt(best_row).fill(tmp_clause, solver->assigns, col_to_var_original);
-    release_assert(!wasUndef);
-
-    #ifdef VERBOSE_DEBUG
-    cout << "(" << matrix_no << ")matrix confl clause:"
-    << tmp_clause << " , "
-    << "xorEqualFalse:" << xorEqualFalse << std::endl;
-    #endif
+void Gaussian::save_matrixset()
+{
+    const uint32_t level = solver->decisionLevel();
+    if (level % config.only_nth_gauss_save != 0)
+        return;
 
-    if (tmp_clause.size() <= 1) {
-        if (!tmp_clause.empty()) {
-            confl = PropBy(tmp_clause[0]);
-        } else {
-            confl = PropBy();
-            solver->ok = false;
-        }
-        return unit_conflict;
+    assert(!matrix_sets.empty());
+    assert(matrix_sets.back().level <= level);
+    if (matrix_sets.back().level < level) {
+        matrix_sets.push_back(cur_matrixset);
+        matrix_sets.back().level = level;
+    } else if (level == 0) {
+        matrix_sets.back() = cur_matrixset;
     }
+}
 
-    if (maxlevel != solver->decisionLevel()) {
-        solver->cancelUntil(maxlevel);
+void Gaussian::canceling(const uint32_t level)
+{
+    while(!clauses_toclear.empty()
+        && clauses_toclear.back().second > level
+    ) {
+        solver->cl_alloc.clauseFree(clauses_toclear.back().first);
+        clauses_toclear.pop_back();
     }
-    const uint32_t curr_dec_level = solver->decisionLevel();
-    assert(maxlevel == curr_dec_level);
-
-    uint32_t maxsublevel = 0;
-    if (tmp_clause.size() == 2) {
-        solver->attach_bin_clause(tmp_clause[0], tmp_clause[1], true, false);
-        Lit lit1 = tmp_clause[0];
-        Lit lit2 = tmp_clause[1];
-
-        const uint32_t sublevel1 = find_sublevel(lit1.var());
-        const uint32_t sublevel2 = find_sublevel(lit2.var());
-        if (sublevel1 > sublevel2) {
-            maxsublevel = sublevel1;
-            std::swap(lit1, lit2);
-        } else {
-            maxsublevel = sublevel2;
-        }
 
-        confl = PropBy(lit1);
-        solver->failBinLit = lit2;
-    } else {
-        Clause* cl = (Clause*)solver->cl_alloc.Clause_new(tmp_clause, 0);
-        confl = PropBy(solver->cl_alloc.get_offset(*cl));
-
-        uint32_t maxsublevel_at = std::numeric_limits<uint32_t>::max();
-        for (uint32_t i = 0, size = cl->size(); i != size; i++)  {
-            if (solver->varData[(*cl)[i].var()].level == curr_dec_level) {
-                uint32_t tmp = find_sublevel((*cl)[i].var());
-                if (tmp >= maxsublevel) {
-                    maxsublevel = tmp;
-                    maxsublevel_at = i;
-                }
-            }
-        }
-        #ifdef VERBOSE_DEBUG
-        cout << "(" << matrix_no << ") || Sublevel of confl: " << maxsublevel
-        << " (due to var:" << cla[maxsublevel_at].var()-1 << ")" << endl;
-        #endif
-
-        std::swap((*cl)[maxsublevel_at], (*cl)[1]);
+    while(matrix_sets.size() > 1
+        && matrix_sets.back().level > level
+    ) {
+        matrix_sets.pop_back();
     }
-
-    cancel_until_sublevel(maxsublevel+1);
-    messed_matrix_vars_since_reversal = true;
-
-    return conflict;
+    must_restore = true;
 }
 
-Gaussian::gaussian_ret Gaussian::handle_matrix_prop_and_confl(
+Gaussian::gauss_ret Gaussian::handle_matrix_prop_and_confl(
     matrixset& m
-    , uint32_t last_row
     , PropBy& confl
+    , Lit& failBinLit
 ) {
-    int32_t maxlevel = std::numeric_limits<int32_t>::max();
-    uint32_t size = std::numeric_limits<uint32_t>::max();
-    uint32_t best_row = std::numeric_limits<uint32_t>::max();
-
-    for (uint32_t row = last_row; row != m.num_rows; row++) {
-        #ifdef DEBUG_GAUSS
-        assert(m.matrix.getMatrixAt(row).isZero());
-        #endif
-        if (m.matrix.getMatrixAt(row).is_true())
-            analyse_confl(m, row, maxlevel, size, best_row);
-    }
-
-    if (maxlevel != std::numeric_limits<int32_t>::max())
-        return handle_matrix_confl(confl, m, maxlevel, best_row);
-
-    #ifdef DEBUG_GAUSS
-    assert(check_no_conflict(m));
-    assert(last_row == 0 || !m.matrix.getMatrixAt(last_row-1).isZero());
-    #endif
-
-    #ifdef VERBOSE_DEBUG
-    cout << "Resizing matrix to num_rows = " << last_row << endl;
-    #endif
-    m.num_rows = last_row;
-    m.matrix.resizeNumRows(m.num_rows);
-
-    gaussian_ret ret = nothing;
+    gauss_ret ret = gauss_nothing;
+    if (!conflict_rows.empty()) {
+        ret = handle_matrix_confl(m, confl, failBinLit);
+    } else {
+        for (const uint32_t row: changed_rows_list) {
+            if (m.row_pivot[row] == unassigned_col
+                || !m.matrix.getMatrixAt(row).popcnt_is_one()
+            ) {
+                continue;
+            }
 
-    uint32_t num_props = 0;
-    for (const uint32_t*
-        prop_row = propagatable_rows.getData(), *end = prop_row + propagatable_rows.size()
-        ; prop_row != end
-        ; prop_row++
-    ) {
-        //this is a "000..1..0000000X" row. I.e. it indicates a propagation
-        ret = handle_matrix_prop(m, *prop_row);
-        num_props++;
-        if (ret == unit_propagation) {
-            #ifdef VERBOSE_DEBUG
-            cout << "(" << matrix_no << ")Unit prop! Breaking from prop examination" << endl;
-            #endif
-            return  unit_propagation;
+            //this is a "000..1..0000000X" row. I.e. it indicates a propagation
+            ret = handle_matrix_prop(m, row);
+            if (must_restore) {
+                //Went back to decision level 0, the rest is invalid
+                break;
+            }
         }
     }
-    #ifdef VERBOSE_DEBUG
-    if (num_props > 0) cout << "(" << matrix_no << ")Number of props during gauss:" << num_props << endl;
-    #endif
-
-    return ret;
-}
-
-uint32_t Gaussian::find_sublevel(const Var v) const
-{
-    for (int i = solver->trail.size()-1; i >= 0; i --)
-        if (solver->trail[i].var() == v) return i;
 
-    #ifdef VERBOSE_DEBUG
-    cout << "(" << matrix_no << ")Oooops! Var " << v+1 << " does not have a sublevel!!"
-    << "(so it must be undefined)" << endl;
-    #endif
+    for (const uint32_t row: changed_rows_list) {
+        changed_rows[row] = 0;
+    }
+    changed_rows_list.clear();
+    conflict_rows.clear();
 
-    assert(false);
-    return 0;
+    return ret;
 }
 
-void Gaussian::cancel_until_sublevel(const uint32_t until_sublevel)
-{
-    #ifdef VERBOSE_DEBUG
-    cout << "(" << matrix_no << ")Canceling until sublevel " << until_sublevel << endl;
-    #endif
-
-    for (vector<Gaussian*>::iterator
-        gauss = solver->gauss_matrixes.begin(), end= solver->gauss_matrixes.end()
-        ; gauss != end
-        ; gauss++
-    )  {
-        if (*gauss != this) {
-            (*gauss)->canceling(until_sublevel);
+Gaussian::gauss_ret Gaussian::handle_matrix_confl(
+    const matrixset& m
+    , PropBy& confl
+    , Lit& failBinLit
+) {
+    //Pick the conflict with the lowest level, then the shortest one
+    uint32_t best_row = unassigned_col;
+    uint32_t best_level = std::numeric_limits<uint32_t>::max();
+    size_t best_size = std::numeric_limits<size_t>::max();
+    for (const uint32_t row: conflict_rows) {
+        const bool wasUndef = m.matrix.getVarsetAt(row).fill(tmp_clause, solver->assigns, col_to_var_original);
+        release_assert(!wasUndef);
+
+        uint32_t maxlevel = 0;
+        for (const Lit lit: tmp_clause) {
+            maxlevel = std::max(maxlevel, solver->varData[lit.var()].level);
+        }
+        if (maxlevel < best_level
+            || (maxlevel == best_level && tmp_clause.size() < best_size)
+        ) {
+            best_row = row;
+            best_level = maxlevel;
+            best_size = tmp_clause.size();
         }
     }
-
-    for (int64_t sublevel = (int64_t)solver->trail.size()-1
-        ; sublevel >= (int64_t)until_sublevel
-        ; sublevel--
-    ) {
-        const Var var  = solver->trail[sublevel].var();
-        #ifdef VERBOSE_DEBUG
-        cout << "(" << matrix_no << ")Canceling var " << var+1 << endl;
-        #endif
-
-        solver->assigns[var] = l_Undef;
-        solver->insertVarOrder(var);
-    }
-    solver->trail.shrink(solver->trail.size() - until_sublevel);
+    assert(best_row != unassigned_col);
+    m.matrix.getVarsetAt(best_row).fill(tmp_clause, solver->assigns, col_to_var_original);
 
     #ifdef VERBOSE_DEBUG
-    cout << "(" << matrix_no << ")Canceling sublevel finished." << endl;
+    cout << "(" << matrix_no << ")matrix confl clause: " << tmp_clause
+    << " level: " << best_level << endl;
     #endif
-}
-
-void Gaussian::analyse_confl(
-    const matrixset& m
-    , const uint32_t row
-    , int32_t& maxlevel
-    , uint32_t& size
-    , uint32_t& best_row
-) const {
-    assert(row < m.num_rows);
-
-    //this is a "000...00000001" row. I.e. it indicates we are on the wrong branch
-    #ifdef VERBOSE_DEBUG
-    cout << "(" << matrix_no << ")matrix conflict found!" << endl;
-    cout << "(" << matrix_no << ")conflict clause's vars: ";
-    #ifdef VERBOSE_DEBUG_MORE
-    print_matrix_row_with_assigns(m.matrix.getVarsetAt(row));
-    cout << endl;
 
-    cout << "(" << matrix_no << ")corresponding matrix's row (should be empty): ";
-    print_matrix_row(m.matrix.getMatrixAt(row));
-    cout << endl;
-    #endif
-    #endif
-
-    int32_t this_maxlevel = 0;
-    unsigned long int var = 0;
-    uint32_t this_size = 0;
-    while (true) {
-        var = m.matrix.getVarsetAt(row).scan(var);
-        if (var == ULONG_MAX) break;
-
-        const Var real_var = col_to_var_original[var];
-        assert(real_var < solver->nVars());
+    if (tmp_clause.empty() || best_level == 0) {
+        solver->cancelUntil(0);
+        solver->ok = false;
+        return gauss_false;
+    }
+    if (best_level != solver->decisionLevel()) {
+        solver->cancelUntil(best_level);
+    }
 
-        if (solver->varData[real_var].level > this_maxlevel)
-            this_maxlevel = solver->varData[real_var].level;
-        var++;
-        this_size++;
+    if (tmp_clause.size() == 1) {
+        //The XORs imply the negation of an assigned literal
+        solver->cancelUntil(0);
+        solver->enqueue(tmp_clause[0]);
+        unit_truths++;
+        useful_prop++;
+        return gauss_prop;
     }
 
-    //the maximum of all lit's level must be lower than the max. level of the current best clause (or this clause must be either empty or unit clause)
-    if (!(
-                (this_maxlevel < maxlevel)
-                || (this_maxlevel == maxlevel && this_size < size)
-                || (this_size <= 1)
-            )) {
-        assert(maxlevel != std::numeric_limits<int32_t>::max());
-
-        #ifdef VERBOSE_DEBUG
-        cout << "(" << matrix_no << ")Other found conflict just as good or better.";
-        cout << "(" << matrix_no << ") || Old maxlevel:" << maxlevel << " new maxlevel:" << this_maxlevel;
-        cout << "(" << matrix_no << ") || Old size:" << size << " new size:" << this_size << endl;
-        //assert(!(maxlevel != std::numeric_limits<uint32_t>::max() && maxlevel != this_maxlevel)); //NOTE: only holds if gauss is executed at each level
-        #endif
+    useful_confl++;
+    failBinLit = tmp_clause[0];
+    switch(tmp_clause.size()) {
+        case 2:
+            confl = PropBy(tmp_clause[1], false);
+            break;
 
-        return;
-    }
+        case 3:
+            confl = PropBy(tmp_clause[1], tmp_clause[2], false);
+            break;
 
+        default:
+            uint32_t dummy;
+            confl = make_reason(dummy);
+            break;
+    }
 
-    #ifdef VERBOSE_DEBUG
-    if (maxlevel != std::numeric_limits<int32_t>::max())
-        cout << "(" << matrix_no << ")Better conflict found.";
-    else
-        cout << "(" << matrix_no << ")Found a possible conflict.";
+    return gauss_confl;
+}
 
-    cout << "(" << matrix_no << ") || Old maxlevel:" << maxlevel << " new maxlevel:" << this_maxlevel;
-    cout << "(" << matrix_no << ") || Old size:" << size << " new size:" << this_size << endl;
-    #endif
+//Creates a temporary clause from tmp_clause, freed when backtracking below
+//the current decision level
+PropBy Gaussian::make_reason(uint32_t& out_level)
+{
+    Clause* cl = solver->cl_alloc.Clause_new(tmp_clause, solver->sumConflicts());
+    cl->set_gauss_temp_cl(true);
+    const ClOffset offset = solver->cl_alloc.get_offset(cl);
+    out_level = solver->decisionLevel();
+    clauses_toclear.push_back(std::make_pair(offset, out_level));
 
-    maxlevel = this_maxlevel;
-    size = this_size;
-    best_row = row;
+    return PropBy(offset);
 }
 
-Gaussian::gaussian_ret Gaussian::handle_matrix_prop(matrixset& m, const uint32_t row)
+Gaussian::gauss_ret Gaussian::handle_matrix_prop(matrixset& m, const uint32_t row)
 {
     #ifdef VERBOSE_DEBUG
     cout << "(" << matrix_no << ")matrix prop" << endl;
@@ -926,346 +467,170 @@ Gaussian::gaussian_ret Gaussian::handle_matrix_prop(matrixset& m, const uint32_t
     #endif
     #endif
 
-    bool xorEqualFalse = !m.matrix.getVarsetAt(row).is_true();
-    m.matrix.getVarsetAt(row).fill(tmp_clause, solver->assigns, col_to_var_original);
+    const bool wasUndef = m.matrix.getVarsetAt(row).fill(tmp_clause, solver->assigns, col_to_var_original);
+    release_assert(wasUndef);
+    assert(solver->value(tmp_clause[0]) == l_Undef);
+    assert(m.matrix.getMatrixAt(row).is_true() == !tmp_clause[0].sign());
+
     #ifdef VERBOSE_DEBUG
-    cout << "(" << matrix_no << ")matrix prop clause: " << tmp_clause << std::endl;
-    cout << endl;
+    cout << "(" << matrix_no << ")matrix prop clause: " << tmp_clause << endl;
     #endif
 
-    switch(tmp_clause.size()) {
-        case 0:
-            //This would mean nothing, empty = true, always true in xors
-            assert(false);
+    bool zero_level = true;
+    for (size_t i = 1; i < tmp_clause.size(); i++) {
+        if (solver->varData[tmp_clause[i].var()].level > 0) {
+            zero_level = false;
             break;
-        case 1:
-            solver->cancelUntil(0);
-            solver->enqueue(tmp_clause[0]);
-            return unit_propagation;
-        case 2: {
+        }
+    }
+
+    if (zero_level) {
+        if (solver->decisionLevel() != 0) {
             solver->cancelUntil(0);
-            tmp_clause[0] = tmp_clause[0].unsign();
-            tmp_clause[1] = tmp_clause[1].unsign();
-            Xor* cl = solver->addXorInt(tmp_clause, xorEqualFalse);
-            release_assert(cl == NULL);
-            release_assert(solver->ok);
-            return unit_propagation;
         }
-        default:
-            if (solver->decisionLevel() == 0) {
-                solver->enqueue(tmp_clause[0]);
-                return unit_propagation;
-            }
-            Clause& cla = *(Clause*)solver->cl_alloc.Xor_new(tmp_clause, xorEqualFalse);
-            assert(m.matrix.getMatrixAt(row).is_true() == !cla[0].sign());
-            assert(solver->assigns[cla[0].var()].isUndef());
+        solver->enqueue(tmp_clause[0]);
+        unit_truths++;
+        return gauss_prop;
+    }
 
-            clauses_toclear.push_back(std::make_pair(&cla, solver->trail.size()-1));
-            solver->enqueue(cla[0], solver->cl_alloc.get_offset(&cla));
-            return propagation;
+    PropBy reason;
+    switch(tmp_clause.size()) {
+        case 2:
+            reason = PropBy(tmp_clause[1], false);
+            break;
+
+        case 3:
+            reason = PropBy(tmp_clause[1], tmp_clause[2], false);
+            break;
+
+        default:
+            uint32_t dummy;
+            reason = make_reason(dummy);
+            break;
     }
+    solver->enqueue(tmp_clause[0], reason);
 
-    return propagation;
+    return gauss_prop;
 }
 
 void Gaussian::disable_if_necessary()
 {
-    if (//nof_conflicts >= 0
-        //&& conflictC >= nof_conflicts/8
-        !config.dontDisable
+    if (!config.dontDisable
         && called > 50
-        && useful_confl*2+useful_prop < (uint32_t)((double)called*0.05) )
-            disabled = true;
+        && useful_confl*2+useful_prop < (uint32_t)((double)called*0.05)
+    ) {
+        disabled = true;
+    }
 }
 
-llbool Gaussian::find_truths(vector<Lit>& learnt_clause, uint64_t& conflictC)
+Gaussian::gauss_ret Gaussian::find_truths(PropBy& confl, Lit& failBinLit)
 {
-    PropBy confl;
-
     disable_if_necessary();
     if (!should_check_gauss(solver->decisionLevel())) {
-        return l_Nothing;
+        return gauss_nothing;
     }
 
     called++;
-    gaussian_ret g = gaussian(confl);
-
-    switch (g) {
-        case conflict: {
-            useful_confl++;
-            llbool ret = solver->handle_conflict(learnt_clause, confl, conflictC, true);
-            if (confl.isClause())
-                solver->cl_alloc.clauseFree(solver->cl_alloc.ptr(confl.get_offset()));
+    if (must_restore) {
+        assert(!matrix_sets.empty());
+        cur_matrixset = matrix_sets.back();
+        must_restore = false;
+    }
+    update_matrix(cur_matrixset);
 
-            if (ret != l_Nothing) return ret;
-            return l_Continue;
-        }
+    #ifdef DEBUG_GAUSS
+    assert(!conflict_rows.empty() || check_matrix(cur_matrixset));
+    #endif
 
-        case unit_propagation:
-            unit_truths++;
-            //NOTE no break
-        case propagation:
+    const gauss_ret ret = handle_matrix_prop_and_confl(cur_matrixset, confl, failBinLit);
+    switch(ret) {
+        case gauss_prop:
             useful_prop++;
-            return l_Continue;
-
-        case unit_conflict: {
-            unit_truths++;
-            useful_confl++;
-            if (confl.isNULL()) {
-                #ifdef VERBOSE_DEBUG
-                std::cout << "(" << matrix_no << ")zero-length conflict. UNSAT" << std::endl;
-                #endif
-                solver->ok = false;
-                return l_False;
+            if (!must_restore) {
+                save_matrixset();
             }
+            break;
 
-            Lit lit = confl.lit2();
-            solver->cancelUntil(0);
-
-            #ifdef VERBOSE_DEBUG
-            std::cout << "(" << matrix_no << ")one-length conflict" << std::endl;
-            #endif
-            if (solver->value(lit) != l_Undef) {
-                assert(solver->value(lit) == l_False);
-                #ifdef VERBOSE_DEBUG
-                std::cout << "(" << matrix_no << ") -> UNSAT" << std::endl;
-                #endif
-                solver->ok = false;
-                return l_False;
-            }
-            #ifdef VERBOSE_DEBUG
-            std::cout << "(" << matrix_no << ") -> setting to correct value" << std::endl;
-            #endif
-            solver->enqueue(lit);
-            return l_Continue;
-        }
+        case gauss_nothing:
+            save_matrixset();
+            break;
 
-        case nothing:
+        default:
             break;
     }
 
-    return l_Nothing;
-}
-
-template<class T>
-void Gaussian::print_matrix_row(const T& row) const
-{
-    unsigned long int var = 0;
-    while (true) {
-        var = row.scan(var);
-        if (var == ULONG_MAX) break;
-
-        else cout << col_to_var_original[var]+1 << ", ";
-        var++;
-    }
-    cout << "final:" << row.is_true() << endl;;
+    return ret;
 }
 
-template<class T>
-void Gaussian::print_matrix_row_with_assigns(const T& row) const
+bool Gaussian::check_matrix(const matrixset& m) const
 {
-    unsigned long int col = 0;
-    while (true) {
-        col = row.scan(col);
-        if (col == ULONG_MAX) break;
-
-        else {
-            Var var = col_to_var_original[col];
-            cout << var+1 << "(" << lbool_to_string(solver->assigns[var]) << ")";
-            cout << ", ";
+    for (uint32_t row = 0; row < m.num_rows; row++) {
+        const PackedRow r = m.matrix.getMatrixAt(row);
+        const PackedRow varset = m.matrix.getVarsetAt(row);
+        const uint32_t pivot = m.row_pivot[row];
+        if (pivot == unassigned_col) {
+            if (!r.isZero() || r.is_true())
+                return false;
+            continue;
         }
-        col++;
-    }
-    if (!row.is_true()) cout << "xorEqualFalse";
-}
-
-string Gaussian::lbool_to_string(const lbool toprint)
-{
-    if (toprint == l_True)
-            return "true";
-    if (toprint == l_False)
-            return "false";
-    if (toprint == l_Undef)
-            return "undef";
-
-    assert(false);
-    return "";
-}
-
-
-void Gaussian::print_stats() const
-{
-    if (called > 0) {
-        cout.setf(std::ios::fixed);
-        std::cout << " Gauss(" << matrix_no << ") useful";
-        cout << " prop: " << std::setprecision(2) << std::setw(5) << ((double)useful_prop/(double)called)*100.0 << "% ";
-        cout << " confl: " << std::setprecision(2) << std::setw(5) << ((double)useful_confl/(double)called)*100.0 << "% ";
-        if (disabled) std::cout << "disabled";
-    } else
-        std::cout << " Gauss(" << matrix_no << ") not called.";
-}
-
-void Gaussian::print_matrix_stats() const
-{
-    cout << "matrix size: " << cur_matrixset.num_rows << "  x " << cur_matrixset.num_cols << endl;
-}
-
-
-void Gaussian::reset_stats()
-{
-    useful_prop = 0;
-    useful_confl = 0;
-    called = 0;
-    disabled = false;
-}
-
-bool Gaussian::check_no_conflict(matrixset& m) const
-{
-    uint32_t row = 0;
-    for(PackedMatrix::iterator r = m.matrix.beginMatrix(), end = m.matrix.endMatrix(); r != end; ++r, ++row) {
-        if ((*r).is_true() && (*r).isZero()) {
-            cout << "Conflict at row " << row << endl;
+        if (!r[pivot])
             return false;
-        }
-    }
-    return true;
-}
 
-void Gaussian::print_matrix(matrixset& m) const
-{
-    uint32_t row = 0;
-    for (PackedMatrix::iterator it = m.matrix.beginMatrix(); it != m.matrix.endMatrix(); ++it, row++) {
-        cout << *it << " -- row:" << row;
-        if (row >= m.num_rows)
-            cout << " (considered past the end)";
-        cout << endl;
-    }
-}
-
-void Gaussian::print_last_one_in_cols(matrixset& m) const
-{
-    for (uint32_t i = 0; i < m.num_cols; i++) {
-        cout << "last_one_in_col[" << i << "]-1 = " << m.last_one_in_col[i]-1 << endl;
-    }
-}
+        for (uint32_t row2 = 0; row2 < m.num_rows; row2++) {
+            if (row2 != row && m.matrix.getMatrixAt(row2)[pivot])
+                return false;
+        }
 
-bool Gaussian::nothing_to_propagate(matrixset& m) const
-{
-    for(PackedMatrix::iterator
-        r = m.matrix.beginMatrix(), end = m.matrix.endMatrix()
-        ; r != end
-        ; ++r
-    ) {
-        if ((*r).popcnt_is_one()
-            && solver->value(m.col_to_var[(*r).scan(0)]) == l_Undef
-        ) {
-            #ifdef VERBOSE_DEBUG
-            std::cout << "row " << (*r) << " is a propagation, but we didn't catch it" << std::endl;
-            #endif
-            return false;
+        bool rhs = varset.is_true();
+        for (uint32_t col = 0; col < m.num_cols; col++) {
+            const lbool val = solver->value(col_to_var_original[col]);
+            if (r[col] && val != l_Undef)
+                return false;
+            if (varset[col] && val != l_Undef) {
+                rhs ^= (val == l_True);
+            } else if (varset[col] != r[col]) {
+                return false;
+            }
         }
-    }
-    for(PackedMatrix::iterator
-        r = m.matrix.beginMatrix(), end = m.matrix.endMatrix()
-        ; r != end
-        ; ++r
-    ) {
-        if (r->isZero() && r->is_true()) {
-            #ifdef VERBOSE_DEBUG
-            std::cout << "row " << (*r) << " is a conflict, but we didn't catch it" << std::endl;
-            #endif
+        if (rhs != (bool)r.is_true())
             return false;
-        }
     }
+
     return true;
 }
 
-bool Gaussian::check_last_one_in_cols(matrixset& m) const
+template<class T>
+void Gaussian::print_matrix_row(const T& row) const
 {
-    for(uint32_t i = 0; i < m.num_cols; i++) {
-        const uint32_t last = std::min(m.last_one_in_col[i] - 1, (int)m.num_rows);
-        uint32_t real_last = 0;
-        uint32_t i2 = 0;
-        for (PackedMatrix::iterator it = m.matrix.beginMatrix(); it != m.matrix.endMatrix(); ++it, i2++) {
-            if ((*it)[i])
-                real_last = i2;
+    for (uint32_t col = 0; col < col_to_var_original.size(); col++) {
+        if (row[col]) {
+            cout << col_to_var_original[col] + 1 << ", ";
         }
-        if (real_last > last)
-            return false;
     }
-
-    return true;
+    cout << "final:" << row.is_true() << endl;;
 }
 
-void Gaussian::check_matrix_against_varset(PackedMatrix& matrix, const matrixset& m) const
+void Gaussian::print_matrix(const matrixset& m) const
 {
-    for (uint32_t i = 0; i < matrix.getSize(); i++) {
-        const PackedRow mat_row = matrix.getMatrixAt(i);
-        const PackedRow var_row = matrix.getVarsetAt(i);
-
-        unsigned long int col = 0;
-        bool final = false;
-        while (true) {
-            col = var_row.scan(col);
-            if (col == ULONG_MAX) break;
-
-            const Var var = col_to_var_original[col];
-            assert(var < solver->nVars());
-
-            if (solver->assigns[var] == l_True) {
-                assert(!mat_row[col]);
-                assert(m.col_to_var[col] == unassigned_var);
-                assert(m.var_is_set[var]);
-                final = !final;
-            } else if (solver->assigns[var] == l_False) {
-                assert(!mat_row[col]);
-                assert(m.col_to_var[col] == unassigned_var);
-                assert(m.var_is_set[var]);
-            } else if (solver->assigns[var] == l_Undef) {
-                assert(m.col_to_var[col] != unassigned_var);
-                assert(!m.var_is_set[var]);
-                assert(mat_row[col]);
-            } else assert(false);
-
-            col++;
-        }
-        if ((final^!mat_row.is_true()) != !var_row.is_true()) {
-            cout << "problem with row:"; print_matrix_row_with_assigns(var_row); cout << endl;
-            assert(false);
-        }
+    for (uint32_t row = 0; row < m.num_rows; row++) {
+        cout << "(" << matrix_no << ") row " << row
+        << " pivot " << m.row_pivot[row] << ": ";
+        print_matrix_row(m.matrix.getMatrixAt(row));
     }
 }
 
-void Gaussian::check_first_one_in_row(matrixset& m, const uint32_t j)
+void Gaussian::print_matrix_stats() const
 {
-    if (j) {
-        uint16_t until2 = std::min(m.last_one_in_col[m.least_column_changed] - 1, (int)m.num_rows);
-        if (j-1 > m.first_one_in_row[m.num_rows-1]) {
-            until2 = m.num_rows;
-            #ifdef VERBOSE_DEBUG
-            cout << "j-1 > m.first_one_in_row[m.num_rows-1]" << "j:" << j
-            << " m.first_one_in_row[m.num_rows-1]:" << m.first_one_in_row[m.num_rows-1] << endl;
-            #endif
-        }
-        for (uint32_t i2 = 0; i2 != until2; i2++) {
-            #ifdef VERBOSE_DEBUG
-            cout << endl << "row " << i2 << " (num rows:" << m.num_rows << ")" << endl;
-            cout << m.matrix.getMatrixAt(i2) << endl;
-            cout << " m.first_one_in_row[m.num_rows-1]:" << m.first_one_in_row[m.num_rows-1] << endl;
-            cout << "first_one_in_row:" << m.first_one_in_row[i2] << endl;
-            cout << "num_cols:" << m.num_cols << endl;
-            cout << "popcnt:" << m.matrix.getMatrixAt(i2).popcnt() << endl;
-            cout << "popcnt_is_one():" << m.matrix.getMatrixAt(i2).popcnt_is_one() << endl;
-            cout << "popcnt_is_one("<< m.first_one_in_row[i2] <<"): "
-            << m.matrix.getMatrixAt(i2).popcnt_is_one(m.first_one_in_row[i2]) << endl;
-            #endif
-
-            for (uint32_t i3 = 0; i3 < m.first_one_in_row[i2]; i3++) {
-                assert(m.matrix.getMatrixAt(i2)[i3] == 0);
-            }
-            assert(m.matrix.getMatrixAt(i2)[m.first_one_in_row[i2]]);
-            assert(m.matrix.getMatrixAt(i2).popcnt_is_one() ==
-            m.matrix.getMatrixAt(i2).popcnt_is_one(m.first_one_in_row[i2]));
-        }
-    }
+    cout
+    << "c [gauss] matrix " << matrix_no
+    << " rows: " << get_num_rows()
+    << " cols: " << get_num_cols()
+    << " called: " << called
+    << " useful prop: " << std::fixed << std::setprecision(2)
+    << stats_line_percent(useful_prop, called) << "%"
+    << " useful confl: " << std::fixed << std::setprecision(2)
+    << stats_line_percent(useful_confl, called) << "%"
+    << " unit truths: " << unit_truths
+    << (disabled ? " disabled" : "")
+    << endl;
 }
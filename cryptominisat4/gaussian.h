@@ -26,14 +26,13 @@
 #include <limits>
 #include <string>
 #include <utility>
-#include <vector>
 
 #include "solvertypes.h"
 #include "gaussianconfig.h"
 #include "propby.h"
 #include "packedmatrix.h"
-#include "bitarray.h"
-#include "xorfinder.h"
+#include "cloffset.h"
+#include "xor.h"
 
 //#define VERBOSE_DEBUG
 //#define DEBUG_GAUSS
@@ -44,55 +43,55 @@ using std::string;
 using std::pair;
 using std::vector;
 
-class Clause;
 class Solver;
 
-/// Hackish lbool that also supports l_Nothing and l_Continue
-class llbool
-{
-    char value;
-
-public:
-    llbool(): value(0) {};
-    llbool(lbool v) :
-            value(v.value) {};
-    llbool(char a) :
-            value(a) {}
+/**
+@brief Gaussian elimination over a set of XOR constraints during search
 
-    inline bool operator!=(const llbool& v) const {
-        return (v.value != value);
-    }
-
-    inline bool operator==(const llbool& v) const {
-        return (v.value == value);
-    }
-
-    friend class lbool;
-};
-const llbool l_Nothing  = toLbool(2);
-const llbool l_Continue = toLbool(3);
+The matrix is kept in reduced row echelon form over the unassigned variables:
+every non-empty row has a pivot column that no other row contains. When a
+variable gets assigned its column is folded into the right hand sides, and
+rows that lost their pivot pick a new one. A row with only one bit left
+propagates, an empty row with a right hand side of 1 is a conflict.
 
+Each row also carries the "varset" row, the XOR of the original constraints
+that make up the row, with all variables in it. Reasons and conflict clauses
+are created from this.
+*/
 class Gaussian
 {
 public:
-    Gaussian(Solver* solver, const GaussConf& config, const uint32_t matrix_no, const vector<Xor*>& xorclauses);
+    Gaussian(
+        Solver* solver
+        , const GaussConf& config
+        , const uint32_t matrix_no
+        , const vector<Xor>& xorclauses
+    );
     ~Gaussian();
 
+    enum gauss_ret {
+        gauss_nothing //Nothing found
+        , gauss_prop //Propagated something, decision level may be 0 now
+        , gauss_confl //Conflict returned in 'confl'
+        , gauss_false //Problem is UNSAT, we are at decision level 0
+    };
+
     bool init_until_fixedpoint();
-    llbool find_truths(vector<Lit>& learnt_clause, uint64_t& conflictC);
+    gauss_ret find_truths(PropBy& confl, Lit& failBinLit);
 
     //statistics
-    void print_stats() const;
     void print_matrix_stats() const;
     uint32_t get_called() const;
     uint32_t get_useful_prop() const;
     uint32_t get_useful_confl() const;
     bool get_disabled() const;
     uint32_t get_unit_truths() const;
+    uint32_t get_num_rows() const;
+    uint32_t get_num_cols() const;
     void set_disabled(const bool toset);
 
     //functions used throughout the Solver
-    void canceling(const uint32_t sublevel);
+    void canceling(const uint32_t level);
 
 protected:
     Solver* solver;
@@ -102,40 +101,34 @@ protected:
     const uint32_t matrix_no;
     vector<Xor> xorclauses;
 
-    enum gaussian_ret {conflict, unit_conflict, propagation, unit_propagation, nothing};
-    gaussian_ret gaussian(PropBy& confl);
-
     vector<Var> col_to_var_original; //Matches columns to variables
-    BitArray var_is_in; //variable is part of the the matrix. var_is_in's size is _minimal_ so you should check whether var_is_in.getSize() < var before issuing var_is_in[var]
-    uint32_t badlevel;
+    vector<uint32_t> var_to_col; //Matches variables to columns, unassigned_col if not in the matrix
 
     class matrixset
     {
     public:
         PackedMatrix matrix; // The matrix, updated to reflect variable assignements
-        BitArray var_is_set;
-        vector<Var> col_to_var; // col_to_var[COL] tells which variable is at a given column in the matrix. Gives unassigned_var if the COL has been zeroed (i.e. the variable assigned)
-        uint16_t num_rows; // number of active rows in the matrix. Unactive rows are rows that contain only zeros (and if they are conflicting, then the conflict has been treated)
-        uint32_t num_cols; // number of active columns in the matrix. The columns at the end that have all be zeroed are no longer active
-        int least_column_changed; // when updating the matrix, this value contains the smallest column number that has been updated  (Gauss elim. can start from here instead of from column 0)
-        vector<uint16_t> last_one_in_col; //last_one_in_col[COL] tells the last row+1 that has a '1' in that column. Used to reduce the burden of Gauss elim. (it only needs to look until that row)
-        vector<uint16_t> first_one_in_row;
-        uint32_t removeable_cols; // the number of columns that have been zeroed out (i.e. assigned)
+        vector<uint32_t> row_pivot; // pivot column of each row, unassigned_col if the row is empty
+        uint32_t num_rows = 0;
+        uint32_t num_cols = 0;
+        uint32_t level = 0; // the decision level this state was saved at
+        uint32_t trail_at = 0; // trail[0..trail_at) has been folded into the matrix
     };
 
     //Saved states
-    vector<matrixset> matrix_sets; // The matrixsets for depths 'decision_from' + 0,  'decision_from' + only_nth_gaussian_save, 'decision_from' + 2*only_nth_gaussian_save, ... 'decision_from' + 'decision_until'.
-    matrixset cur_matrixset; // The current matrixset, i.e. the one we are working on, or the last one we worked on
+    vector<matrixset> matrix_sets; // The state at decision level 0, then every 'only_nth_gauss_save'-th level of the current branch
+    matrixset cur_matrixset; // The current matrixset, i.e. the one we are working on
 
     //Varibales to keep Gauss state
-    bool messed_matrix_vars_since_reversal;
-    int gauss_last_level;
-    vector<pair<Clause*, uint32_t> > clauses_toclear;
+    bool must_restore; // cur_matrixset contains assignments that have been canceled
+    vector<pair<ClOffset, uint32_t> > clauses_toclear; // reason clauses and the decision level they were created at
     bool disabled; // Gauss is disabled
 
     //State of current elimnation
-    vector<uint32_t> propagatable_rows; //used to store which rows were deemed propagatable during elimination
-    vector<unsigned char> changed_rows; //used to store which rows were deemed propagatable during elimination
+    vector<uint32_t> lost_pivot; //rows whose pivot column got assigned
+    vector<uint32_t> changed_rows_list; //rows that changed, they may propagate
+    vector<char> changed_rows;
+    vector<uint32_t> conflict_rows;
 
     //Statistics
     uint32_t useful_prop; //how many times Gauss gave propagation as a result
@@ -144,94 +137,41 @@ protected:
     uint32_t unit_truths; //how many unitary (i.e. decisionLevel 0) truths have been found
 
     //gauss init functions
-    void init(); // Initalise gauss state
     void fill_matrix(matrixset& origMat); // Fills the origMat matrix
-    uint32_t select_columnorder(vector<uint16_t>& var_to_col, matrixset& origMat); // Fills var_to_col and col_to_var of the origMat matrix.
-
-    //Main function
-    uint32_t eliminate(matrixset& matrix); //does the actual gaussian elimination
+    void select_columnorder(); // Fills var_to_col and col_to_var_original
+    void eliminate(matrixset& m); //puts the whole matrix in reduced row echelon form
 
     //matrix update functions
-    void update_matrix_col(matrixset& matrix, const Var x, const uint32_t col); // Update one matrix column
-    void update_matrix_by_col_all(matrixset& m); // Update all columns, column-by-column (and not row-by-row)
-    void set_matrixset_to_cur(); // Save the current matrixset, the cur_matrixset to matrix_sets
-    //void update_matrix_by_row(matrixset& matrix) const;
-    //void update_matrix_by_col(matrixset& matrix, const uint32_t last_level) const;
+    void update_matrix(matrixset& m); // Folds trail[m.trail_at..] into the matrix
+    void update_matrix_col(matrixset& m, const Var var, const uint32_t col); // Fold one column
+    void set_pivot(matrixset& m, const uint32_t row); // Find new pivot for row, eliminate it from the other rows
+    void mark_changed(const uint32_t row);
+    void save_matrixset();
 
     //conflict&propagation handling
-    gaussian_ret handle_matrix_prop_and_confl(matrixset& m, uint32_t row, PropBy& confl);
-    void analyse_confl(const matrixset& m, const uint32_t row, int32_t& maxlevel, uint32_t& size, uint32_t& best_row) const; // analyse conflcit to find the best conflict. Gets & returns the best one in 'maxlevel', 'size' and 'best row' (these are all std::numeric_limits<uint32_t>::max() when calling this function first, i.e. when there is no other possible conflict to compare to the new in 'row')
-    gaussian_ret handle_matrix_confl(PropBy& confl, const matrixset& m, const uint32_t maxlevel, const uint32_t best_row);
-    gaussian_ret handle_matrix_prop(matrixset& m, const uint32_t row); // Handle matrix propagation at row 'row'
+    gauss_ret handle_matrix_confl(const matrixset& m, PropBy& confl, Lit& failBinLit);
+    gauss_ret handle_matrix_prop(matrixset& m, const uint32_t row);
+    gauss_ret handle_matrix_prop_and_confl(matrixset& m, PropBy& confl, Lit& failBinLit);
+    PropBy make_reason(uint32_t& out_level);
     vector<Lit> tmp_clause;
 
-    //propagation&conflict handling
-    void cancel_until_sublevel(const uint32_t until_sublevel); // cancels until sublevel 'until_sublevel'. The var 'until_sublevel' must NOT go over the current level. I.e. this function is ONLY for moving inside the current level
-    uint32_t find_sublevel(const Var v) const; // find the sublevel (i.e. trail[X]) of a given variable
-
     //helper functions
-    bool at_first_init() const;
-    bool should_init() const;
     bool should_check_gauss(const uint32_t decisionlevel) const;
     void disable_if_necessary();
-    void reset_stats();
-    void update_last_one_in_col(matrixset& m);
 
 private:
-    bool clean_xor_clauses();
-    bool clean_one_xor(Xor& x);
-
     //debug functions
-    bool check_no_conflict(matrixset& m) const; // Are there any conflicts that the matrixset 'm' causes?
-    bool nothing_to_propagate(matrixset& m) const; // Are there any conflicts of propagations that matrixset 'm' clauses?
+    bool check_matrix(const matrixset& m) const; // Is 'm' in RREF and consistent with the assignment?
     template<class T> void print_matrix_row(const T& row) const;
-    template<class T>
-    void print_matrix_row_with_assigns(const T& row) const;
-    void check_matrix_against_varset(PackedMatrix& matrix,const matrixset& m) const;
-    bool check_last_one_in_cols(matrixset& m) const;
-    void check_first_one_in_row(matrixset& m, const uint32_t j);
-    void print_matrix(matrixset& m) const;
-    void print_last_one_in_cols(matrixset& m) const;
-    static string lbool_to_string(const lbool toprint);
+    void print_matrix(const matrixset& m) const;
 };
 
-inline bool Gaussian::should_init() const
-{
-    return (config.decision_until > 0);
-}
-
 inline bool Gaussian::should_check_gauss(const uint32_t decisionlevel) const
 {
     return (!disabled
             && decisionlevel < config.decision_until);
 }
 
-inline void Gaussian::canceling(const uint32_t sublevel)
-{
-    if (disabled)
-        return;
-
-    uint32_t a = 0;
-    for (int i = clauses_toclear.size()-1; i >= 0 && clauses_toclear[i].second > sublevel; i--) {
-        solver.cl_alloc.clauseFree(clauses_toclear[i].first);
-        a++;
-    }
-    clauses_toclear.resize(clauses_toclear.size()-a);
-
-    if (messed_matrix_vars_since_reversal)
-        return;
-    int c = std::min((int)gauss_last_level, (int)(solver.trail.size())-1);
-    for (; c >= (int)sublevel; c--) {
-        Var var  = solver.trail[c].var();
-        if (var < var_is_in.getSize()
-            && var_is_in[var]
-            && cur_matrixset.var_is_set[var]) {
-        messed_matrix_vars_since_reversal = true;
-        return;
-        }
-    }
-}
-
 inline uint32_t Gaussian::get_unit_truths() const
 {
     return unit_truths;
@@ -257,13 +197,21 @@ inline bool Gaussian::get_disabled() const
     return disabled;
 }
 
+inline uint32_t Gaussian::get_num_rows() const
+{
+    return matrix_sets.empty() ? 0 : matrix_sets[0].num_rows;
+}
+
+inline uint32_t Gaussian::get_num_cols() const
+{
+    return col_to_var_original.size();
+}
+
 inline void Gaussian::set_disabled(const bool toset)
 {
     disabled = toset;
 }
 
-//std::ostream& operator << (std::ostream& os, const vector<Lit>& v);
-
 }
 
 #endif //GAUSSIAN_H
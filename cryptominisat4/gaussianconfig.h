@@ -22,7 +22,6 @@
 #ifndef GAUSSIANCONFIG_H
 #define GAUSSIANCONFIG_H
 
-#include "packedrow.h"
 #include "constants.h"
 
 namespace CMSat
@@ -34,11 +33,10 @@ class GaussConf
 
     GaussConf() :
         only_nth_gauss_save(2)
-        , decision_until(0)
+        , decision_until(700)
         , dontDisable(false)
         , noMatrixFind(false)
         , orderCols(true)
-        , iterativeReduce(true)
         , maxMatrixRows(1000)
         , minMatrixRows(20)
         , maxNumMatrixes(3)
@@ -47,11 +45,10 @@ class GaussConf
 
     //tuneable gauss parameters
     uint32_t only_nth_gauss_save;  //save only every n-th gauss matrix
-    uint32_t decision_until; //do Gauss until this level
+    uint32_t decision_until; //do Gauss until this level, 0 switches Gauss off
     bool dontDisable; //If activated, gauss elimination is never disabled
     bool noMatrixFind; //Put all xor-s into one matrix, don't find matrixes
     bool orderCols; //Order columns according to activity
-    bool iterativeReduce; //Don't minimise matrix work
     uint32_t maxMatrixRows; //The maximum matrix size -- no. of rows
     uint32_t minMatrixRows; //The minimum matrix size -- no. of rows
     uint32_t maxNumMatrixes; //Maximum number of matrixes
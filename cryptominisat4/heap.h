@@ -130,6 +130,12 @@ class Heap {
         return heap.size() == 1;
     }
 
+    uint32_t get_min() const
+    {
+        assert(!empty());
+        return heap[1];
+    }
+
     void decrease  (uint32_t n) {
         //assert(in_heap(n));
         percolate_up(indices[n]);
@@ -846,6 +846,8 @@ Lit HyperEngine::analyzeFail(const PropBy propBy)
             break;
         }
 
+        //Native XORs are not propagated by this engine
+        case xor_t:
         case null_clause_t:
             assert(false);
             break;
@@ -1043,7 +1045,7 @@ PropResult HyperEngine::prop_normal_cl_with_ancestor_info(
     , PropBy& confl
 ) {
     //Blocked literal is satisfied, so clause is satisfied
-    if (value(i->getBlockedLit()) == l_True) {
+    if (watch_blocked(*i)) {
         *j++ = *i;
         return PROP_NOTHING;
     }
@@ -37,29 +37,26 @@ using std::endl;
 //Make all literals as if propagated only by redundant
 void ImplCache::makeAllRed()
 {
-    for(vector<TransCache>::iterator
-        it = implCache.begin(), end = implCache.end()
-        ; it != end
-        ; ++it
-    ) {
-        it->makeAllRed();
+    for(const Entry& e: entries) {
+        for(size_t i = e.at; i < e.at + e.num; i++) {
+            arena[i] = LitExtra(arena[i].getLit(), false);
+        }
     }
 }
 
 size_t ImplCache::mem_used() const
 {
-    double numBytes = 0;
-    for(vector<TransCache>::const_iterator
-        it = implCache.begin(), end = implCache.end()
-        ; it != end
-        ; ++it
-    ) {
-        //1.2 is overhead
-        numBytes += (double)it->lits.capacity()*(double)sizeof(LitExtra)*1.2;
-    }
-    numBytes += implCache.capacity()*sizeof(vector<TransCache>);
+    return arena.capacity()*sizeof(LitExtra)
+        + entries.capacity()*sizeof(Entry);
+}
 
-    return numBytes;
+void ImplCache::save_on_var_memorys(const uint32_t newNumVars)
+{
+    for(size_t i = newNumVars*2; i < entries.size(); i++) {
+        garbage += entries[i].cap;
+    }
+    entries.resize(newNumVars*2);
+    entries.shrink_to_fit();
 }
 
 void ImplCache::print_stats(const Solver* solver) const
@@ -81,13 +78,13 @@ void ImplCache::print_statsSort(const Solver* solver) const
     size_t totalElems = 0;
     size_t activeLits = 0;
 
-    for(size_t i = 0; i < implCache.size(); i++) {
+    for(size_t i = 0; i < entries.size(); i++) {
         Lit lit = Lit::toLit(i);
 
         if (solver->varData[lit.var()].is_decision) {
             activeLits++;
-            totalElems += implCache[i].lits.size();
-            numHasElems += !implCache[i].lits.empty();
+            totalElems += entries[i].num;
+            numHasElems += entries[i].num > 0;
         }
     }
 
@@ -102,6 +99,11 @@ void ImplCache::print_statsSort(const Solver* solver) const
         , stats_line_percent(totalElems, numHasElems)
         , "extralits"
     );
+
+    print_stats_line(
+        "c cache lists evicted"
+        , num_evicted
+    );
 }
 
 bool ImplCache::clean(Solver* solver, bool* setSomething)
@@ -122,7 +124,7 @@ bool ImplCache::clean(Solver* solver, bool* setSomething)
         if (solver->varData[var].removed == Removed::replaced) {
             for(int i = 0; i < 2; i++) {
                 const Lit litOrig = Lit(var, i);
-                if (implCache[litOrig.toInt()].lits.empty())
+                if (entries[litOrig.toInt()].num == 0)
                     continue;
 
                 const Lit lit = solver->varReplacer->get_lit_replaced_with(litOrig);
@@ -130,8 +132,9 @@ bool ImplCache::clean(Solver* solver, bool* setSomething)
                 //Updated literal must be normal, otherwise, biig problems e.g
                 //implCache is not even large enough, etc.
                 if (solver->varData[lit.var()].removed == Removed::none) {
-                    bool taut = implCache.at(lit.toInt()).merge(
-                        implCache[litOrig.toInt()].lits
+                    bool taut = merge(
+                        lit
+                        , litOrig
                         , lit_Undef //nothing to add
                         , false //replaced, so 'irred'
                         , lit.var() //exclude the literal itself
@@ -152,33 +155,30 @@ bool ImplCache::clean(Solver* solver, bool* setSomething)
             || solver->varData[var].removed == Removed::replaced
             || solver->varData[var].removed == Removed::decomposed
         ) {
-            vector<LitExtra> tmp1;
-            numFreed += implCache[Lit(var, false).toInt()].lits.capacity();
-            implCache[Lit(var, false).toInt()].lits.swap(tmp1);
-
-            vector<LitExtra> tmp2;
-            numFreed += implCache[Lit(var, true).toInt()].lits.capacity();
-            implCache[Lit(var, true).toInt()].lits.swap(tmp2);
+            for(const Lit lit: {Lit(var, false), Lit(var, true)}) {
+                Entry& e = entries[lit.toInt()];
+                numFreed += e.cap;
+                garbage += e.cap;
+                e.num = 0;
+                e.cap = 0;
+            }
         }
     }
 
     vector<uint16_t>& inside = solver->seen;
     vector<uint16_t>& irred = solver->seen2;
-    size_t wsLit = 0;
-    for(vector<TransCache>::iterator
-        trans = implCache.begin(), transEnd = implCache.end()
-        ; trans != transEnd
-        ; trans++, wsLit++
-    ) {
+    for(size_t wsLit = 0; wsLit < entries.size(); wsLit++) {
+        Entry& trans = entries[wsLit];
+
         //Stats
-        size_t origSize = trans->lits.size();
+        size_t origSize = trans.num;
         size_t newSize = 0;
 
         //Update to replaced vars, remove vars already set or eliminated
         Lit vertLit = Lit::toLit(wsLit);
-        vector<LitExtra>::iterator it = trans->lits.begin();
-        vector<LitExtra>::iterator it2 = it;
-        for (vector<LitExtra>::iterator end = trans->lits.end(); it != end; ++it) {
+        LitExtra* it = arena.data() + trans.at;
+        LitExtra* it2 = it;
+        for (LitExtra* end = it + trans.num; it != end; ++it) {
             Lit lit = it->getLit();
             assert(lit.var() != vertLit.var());
 
@@ -217,14 +217,14 @@ bool ImplCache::clean(Solver* solver, bool* setSomething)
             *it2++ = LitExtra(lit, it->getOnlyIrredBin());
             newSize++;
         }
-        trans->lits.resize(newSize);
+        trans.num = newSize;
 
         //Now that we have gone through the list, go through once more to:
         //1) set irred right (above we might have it set later)
         //2) clear 'inside'
         //3) clear 'irred'
-        for (vector<LitExtra>::iterator
-            it2 = trans->lits.begin(), end2 = trans->lits.end()
+        for (LitExtra
+            *it2 = arena.data() + trans.at, *end2 = it2 + trans.num
             ;it2 != end2
             ; it2++
         ) {
@@ -242,7 +242,10 @@ bool ImplCache::clean(Solver* solver, bool* setSomething)
             assert(solver->varData[it2->getLit().var()].removed == Removed::none);
             assert(solver->value(it2->getLit()) == l_Undef);
         }
-        numCleaned += origSize-trans->lits.size();
+        numCleaned += origSize-trans.num;
+    }
+    if (garbage > arena.size()/2) {
+        compact();
     }
 
     size_t origTrailDepth = solver->trail_size();
@@ -419,15 +422,15 @@ void ImplCache::tryVar(
 
     Lit lit = Lit(var, false);
 
-    const vector<LitExtra>& cache1 = implCache[lit.toInt()].lits;
+    const TransCache cache1 = (*this)[lit.toInt()];
     assert(solver->watches.size() > (lit.toInt()));
     watch_subarray_const ws1 = solver->watches[lit.toInt()];
-    const vector<LitExtra>& cache2 = implCache[(~lit).toInt()].lits;
+    const TransCache cache2 = (*this)[(~lit).toInt()];
     watch_subarray_const ws2 = solver->watches[(~lit).toInt()];
 
     //Fill 'seen' and 'val' from cache
-    for (vector<LitExtra>::const_iterator
-        it = cache1.begin(), end = cache1.end()
+    for (const LitExtra
+        *it = cache1.begin(), *end = cache1.end()
         ; it != end
         ; ++it
     ) {
@@ -465,8 +468,8 @@ void ImplCache::tryVar(
 
     //Try to see if we propagate the same or opposite from the other end
     //Using cache
-    for (vector<LitExtra>::const_iterator
-        it = cache2.begin(), end = cache2.end()
+    for (const LitExtra
+        *it = cache2.begin(), *end = cache2.end()
         ; it != end
         ; ++it
     ) {
@@ -503,7 +506,7 @@ void ImplCache::tryVar(
     }
 
     //Clear 'seen' and 'val'
-    for (vector<LitExtra>::const_iterator it = cache1.begin(), end = cache1.end(); it != end; ++it) {
+    for (const LitExtra *it = cache1.begin(), *end = cache1.end(); it != end; ++it) {
         seen[it->getLit().var()] = false;
         val[it->getLit().var()] = false;
     }
@@ -517,13 +520,22 @@ void ImplCache::tryVar(
     }
 }
 
-bool TransCache::merge(
-    const vector<LitExtra>& otherLits //Lits to add
+bool ImplCache::merge(
+    const Lit into //Add to the list of this lit
+    , const Lit from //Lits to add are the list of this lit
     , const Lit extraLit //Add this, too to the list of lits
     , const bool red //The step was a redundant-dependent step?
     , const Var leaveOut //Leave this literal out
     , vector<uint16_t>& seen
 ) {
+    assert(into != from);
+    touch(from);
+    touch(into);
+
+    //May move lists around, so pointers into the arena are only taken after
+    reserve_extra(into, entries[from.toInt()].num + 1);
+    const TransCache otherLits = (*this)[from.toInt()];
+
     //Mark every literal that is to be added in 'seen'
     for (size_t i = 0, size = otherLits.size(); i < size; i++) {
         const Lit lit = otherLits[i].getLit();
@@ -532,14 +544,16 @@ bool TransCache::merge(
         seen[lit.toInt()] = 1 + (int)onlyIrred;
     }
 
-    bool taut = mergeHelper(extraLit, red, seen);
+    bool taut = mergeHelper(into, extraLit, red, seen);
 
     //Whatever rests needs to be added
+    Entry& e = entries[into.toInt()];
+    LitExtra* lits = arena.data() + e.at;
     for (size_t i = 0 ,size = otherLits.size(); i < size; i++) {
         const Lit lit = otherLits[i].getLit();
         if (seen[lit.toInt()]) {
             if (lit.var() != leaveOut)
-                lits.push_back(LitExtra(lit, !red && otherLits[i].getOnlyIrredBin()));
+                lits[e.num++] = LitExtra(lit, !red && otherLits[i].getOnlyIrredBin());
             seen[lit.toInt()] = 0;
         }
     }
@@ -547,34 +561,41 @@ bool TransCache::merge(
     //Handle extra lit
     if (extraLit != lit_Undef && seen[extraLit.toInt()]) {
         if (extraLit.var() != leaveOut)
-            lits.push_back(LitExtra(extraLit, !red));
+            lits[e.num++] = LitExtra(extraLit, !red);
         seen[extraLit.toInt()] = 0;
     }
+    assert(e.num <= e.cap);
 
     return taut;
 }
 
-bool TransCache::merge(
-    const vector<Lit>& otherLits //Lits to add
+bool ImplCache::merge(
+    const Lit into //Add to the list of this lit
+    , const vector<Lit>& otherLits //Lits to add
     , const Lit extraLit //Add this, too to the list of lits
     , const bool red //The step was a redundant-dependent step?
     , const Var leaveOut //Leave this literal out
     , vector<uint16_t>& seen
 ) {
+    touch(into);
+    reserve_extra(into, otherLits.size() + 1);
+
     //Mark every literal that is to be added in 'seen'
     for (size_t i = 0, size = otherLits.size(); i < size; i++) {
         const Lit lit = otherLits[i];
         seen[lit.toInt()] = 1;
     }
 
-    bool taut = mergeHelper(extraLit, red, seen);
+    bool taut = mergeHelper(into, extraLit, red, seen);
 
     //Whatever rests needs to be added
+    Entry& e = entries[into.toInt()];
+    LitExtra* lits = arena.data() + e.at;
     for (size_t i = 0 ,size = otherLits.size(); i < size; i++) {
         const Lit lit = otherLits[i];
         if (seen[lit.toInt()]) {
             if (lit.var() != leaveOut)
-                lits.push_back(LitExtra(lit, false));
+                lits[e.num++] = LitExtra(lit, false);
             seen[lit.toInt()] = 0;
         }
     }
@@ -582,15 +603,17 @@ bool TransCache::merge(
     //Handle extra lit
     if (extraLit != lit_Undef && seen[extraLit.toInt()]) {
         if (extraLit.var() != leaveOut)
-            lits.push_back(LitExtra(extraLit, !red));
+            lits[e.num++] = LitExtra(extraLit, !red);
         seen[extraLit.toInt()] = 0;
     }
+    assert(e.num <= e.cap);
 
     return taut;
 }
 
-bool TransCache::mergeHelper(
-    const Lit extraLit //Add this, too to the list of lits
+bool ImplCache::mergeHelper(
+    const Lit into
+    , const Lit extraLit //Add this, too to the list of lits
     , const bool red //The step was a redundant-dependent step?
     , vector<uint16_t>& seen
 ) {
@@ -603,7 +626,9 @@ bool TransCache::mergeHelper(
     //Everything that's already in the cache, set seen[] to zero
     //Also, if seen[] is 2, but it's marked redundant in the cache
     //mark it as irred
-    for (size_t i = 0, size = lits.size(); i < size; i++) {
+    const Entry& e = entries[into.toInt()];
+    LitExtra* lits = arena.data() + e.at;
+    for (size_t i = 0, size = e.num; i < size; i++) {
         if (!red
             && !lits[i].getOnlyIrredBin()
             && seen[lits[i].getLit().toInt()] == 2
@@ -622,24 +647,116 @@ bool TransCache::mergeHelper(
     return taut;
 }
 
-//Make all literals as if propagated only by redundant
-void TransCache::makeAllRed()
+void ImplCache::touch(const Lit lit)
 {
-    for(size_t i = 0; i < lits.size(); i++) {
-        lits[i] = LitExtra(lits[i].getLit(), false);
+    //Only the order of the stamps matters, so halving keeps them usable
+    if (stamp == std::numeric_limits<uint32_t>::max()) {
+        for(Entry& e: entries) {
+            e.last_used >>= 1;
+        }
+        stamp >>= 1;
+    }
+    entries[lit.toInt()].last_used = ++stamp;
+}
+
+void ImplCache::reserve_extra(const Lit lit, const size_t extra)
+{
+    Entry& e = entries[lit.toInt()];
+    const size_t need = (size_t)e.num + extra;
+    if (need <= e.cap)
+        return;
+
+    //Evict to 3/4 of the limit, or further if that still leaves no room.
+    //Only a single list bigger than the limit can make the arena go over it
+    const size_t max_lits = max_mem/sizeof(LitExtra);
+    size_t newCap = need + need/2;
+    if (arena.size() + newCap > max_lits) {
+        const size_t room = max_lits - std::min(max_lits, newCap);
+        evict_to(std::min(max_lits/4*3, room)*sizeof(LitExtra));
+        newCap = std::max(need, std::min(newCap, max_lits - std::min(max_lits, arena.size())));
+    } else if (garbage > arena.size()/2) {
+        compact();
     }
 
+    //Unless it's at the end of the arena and can grow in place, move it there
+    const bool atEnd = (e.at + e.cap == arena.size());
+    const size_t newSize = (atEnd ? e.at : arena.size()) + newCap;
+    assert(newSize <= std::numeric_limits<uint32_t>::max());
+    if (newSize > arena.capacity()) {
+        arena.reserve(std::max(newSize, std::min(newSize + arena.size()/4, max_lits)));
+    }
+    arena.resize(newSize);
+    if (!atEnd) {
+        const uint32_t at = newSize - newCap;
+        std::copy(arena.begin() + e.at, arena.begin() + e.at + e.num, arena.begin() + at);
+        garbage += e.cap;
+        e.at = at;
+    }
+    e.cap = newCap;
 }
 
-void TransCache::updateVars(
-    const std::vector< uint32_t >& outerToInter
-    , const size_t newMaxVars
-) {
-    for(size_t i = 0; i < lits.size(); i++) {
-        lits[i] = LitExtra(getUpdatedLit(lits[i].getLit(), outerToInter), lits[i].getOnlyIrredBin());
-        assert(lits[i].getLit().var() < newMaxVars);
+void ImplCache::compact()
+{
+    vector<uint32_t> order;
+    for(size_t i = 0; i < entries.size(); i++) {
+        Entry& e = entries[i];
+        if (e.num == 0) {
+            e.at = 0;
+            e.cap = 0;
+        } else {
+            order.push_back(i);
+        }
+    }
+    std::sort(order.begin(), order.end(), [&](const uint32_t a, const uint32_t b) {
+        return entries[a].at < entries[b].at;
+    });
+
+    uint32_t to = 0;
+    for(const uint32_t i: order) {
+        Entry& e = entries[i];
+        if (e.at != to) {
+            std::copy(arena.begin() + e.at, arena.begin() + e.at + e.num, arena.begin() + to);
+        }
+        e.at = to;
+        e.cap = e.num;
+        to += e.num;
+    }
+    arena.resize(to);
+    if (arena.capacity() > 2*arena.size()) {
+        arena.shrink_to_fit();
+    }
+    garbage = 0;
+}
+
+size_t ImplCache::evict_to(const size_t bytes)
+{
+    vector<uint32_t> order;
+    size_t live = 0;
+    for(size_t i = 0; i < entries.size(); i++) {
+        if (entries[i].num > 0) {
+            order.push_back(i);
+            live += entries[i].num;
+        }
     }
 
+    //Least recently updated first
+    std::sort(order.begin(), order.end(), [&](const uint32_t a, const uint32_t b) {
+        return entries[a].last_used < entries[b].last_used;
+    });
+
+    size_t evicted = 0;
+    for(const uint32_t i: order) {
+        if (live*sizeof(LitExtra) <= bytes)
+            break;
+
+        live -= entries[i].num;
+        entries[i].num = 0;
+        evicted++;
+    }
+    num_evicted += evicted;
+    compact();
+
+    return evicted;
 }
 
 void ImplCache::updateVars(
@@ -648,9 +765,15 @@ void ImplCache::updateVars(
     , const std::vector< uint32_t >& interToOuter2
     , const size_t newMaxVar
 ) {
-    updateBySwap(implCache, seen, interToOuter2);
-    for(size_t i = 0; i < implCache.size(); i++) {
-        implCache[i].updateVars(outerToInter, newMaxVar);
+    //Only checked in debug builds
+    (void)newMaxVar;
+
+    updateBySwap(entries, seen, interToOuter2);
+    for(const Entry& e: entries) {
+        for(size_t i = e.at; i < e.at + e.num; i++) {
+            arena[i] = LitExtra(getUpdatedLit(arena[i].getLit(), outerToInter), arena[i].getOnlyIrredBin());
+            assert(arena[i].getLit().var() < newMaxVar);
+        }
     }
 }
 
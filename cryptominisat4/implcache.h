@@ -78,112 +78,124 @@ private:
 
 };
 
+/**
+@brief Read-only view of the literals cached for one literal
+
+Points into the arena of ImplCache, so it's only valid until the cache is next
+changed.
+*/
 class TransCache {
 public:
-    TransCache()
-        //conflictLastUpdated(std::numeric_limits<uint64_t>::max())
+    TransCache(const LitExtra* _lits, const uint32_t _num) :
+        lits(_lits)
+        , num(_num)
     {}
 
-    bool merge(
-        const vector<LitExtra>& otherLits
-        , const Lit extraLit
-        , const bool red
-        , const Var leaveOut
-        , vector<uint16_t>& seen
-    );
-    bool merge(
-        const vector<Lit>& otherLits //Lits to add
-        , const Lit extraLit //Add this, too to the list of lits
-        , const bool red //The step was a redundant-dependent step?
-        , const Var leaveOut //Leave this literal out
-        , vector<uint16_t>& seen
-    );
-    void makeAllRed();
+    const LitExtra* begin() const
+    {
+        return lits;
+    }
 
-    void updateVars(
-        const std::vector< uint32_t >& outerToInter
-        , const size_t newMaxVars
-    );
+    const LitExtra* end() const
+    {
+        return lits + num;
+    }
 
-    std::vector<LitExtra> lits;
-    //uint64_t conflictLastUpdated;
+    const LitExtra& operator[](const size_t at) const
+    {
+        return lits[at];
+    }
+
+    size_t size() const
+    {
+        return num;
+    }
+
+    bool empty() const
+    {
+        return num == 0;
+    }
 
 private:
-    bool mergeHelper(
-        const Lit extraLit //Add this, too to the list of lits
-        , const bool red //The step was a redundant-dependent step?
-        , vector<uint16_t>& seen
-    );
+    const LitExtra* lits;
+    uint32_t num;
 };
 
 inline std::ostream& operator<<(std::ostream& os, const TransCache& tc)
 {
-    for (size_t i = 0; i < tc.lits.size(); i++) {
-        os << tc.lits[i].getLit()
-        << "(" << (tc.lits[i].getOnlyIrredBin() ? "NL" : "L") << ") ";
+    for (const LitExtra l: tc) {
+        os << l.getLit()
+        << "(" << (l.getOnlyIrredBin() ? "NL" : "L") << ") ";
     }
     return os;
 }
 
+/**
+@brief Literals implied by each literal, all kept in one arena
+
+Every literal owns a range of the arena, and lists that outgrow their range
+are moved to the end of the arena. Moving leaves garbage behind, which is
+compacted away once it's half the arena. If the arena would grow over the
+memory limit, the lists that were least recently updated are evicted.
+*/
 class ImplCache  {
 public:
     void print_stats(const Solver* solver) const;
     void print_statsSort(const Solver* solver) const;
     size_t mem_used() const;
-    void makeAllRed();
-    void save_on_var_memorys(uint32_t newNumVars)
-    {
-        implCache.resize(newNumVars*2);
-        implCache.shrink_to_fit();
-    }
-
-    std::vector<TransCache> implCache;
-
-    std::vector<TransCache>::iterator begin()
+    size_t mem_used_by_lits() const
     {
-        return implCache.begin();
-    }
-
-    std::vector<TransCache>::iterator end()
-    {
-        return implCache.end();
+        return (arena.size() - garbage)*sizeof(LitExtra);
     }
+    void makeAllRed();
+    void save_on_var_memorys(uint32_t newNumVars);
 
-    std::vector<TransCache>::const_iterator begin() const
+    TransCache operator[](const size_t at) const
     {
-        return implCache.begin();
+        const Entry& e = entries[at];
+        return TransCache(arena.data() + e.at, e.num);
     }
 
-    std::vector<TransCache>::const_iterator end() const
-    {
-        return implCache.end();
-    }
+    bool merge(
+        const Lit into //Add to the list of this lit
+        , const Lit from //Lits to add are the list of this lit
+        , const Lit extraLit //Add this, too to the list of lits
+        , const bool red //The step was a redundant-dependent step?
+        , const Var leaveOut //Leave this literal out
+        , vector<uint16_t>& seen
+    );
+    bool merge(
+        const Lit into //Add to the list of this lit
+        , const vector<Lit>& otherLits //Lits to add
+        , const Lit extraLit //Add this, too to the list of lits
+        , const bool red //The step was a redundant-dependent step?
+        , const Var leaveOut //Leave this literal out
+        , vector<uint16_t>& seen
+    );
 
-    const TransCache& operator[](const size_t at) const
+    void new_var()
     {
-        return implCache[at];
+        entries.push_back(Entry());
+        entries.push_back(Entry());
     }
 
-    TransCache& operator[](const size_t at)
+    void new_vars(const size_t n)
     {
-        return implCache[at];
+        entries.resize(entries.size()+2*n);
     }
 
-    void new_var()
+    size_t size() const
     {
-        implCache.push_back(TransCache());
-        implCache.push_back(TransCache());
+        return entries.size();
     }
 
-    void new_vars(const size_t n)
+    void set_max_mem(const size_t bytes)
     {
-        implCache.resize(implCache.size()+2*n);
+        max_mem = bytes;
     }
 
-    size_t size() const
-    {
-        return implCache.size();
-    }
+    //Evicts the least recently updated lists until the rest fits in 'bytes'
+    size_t evict_to(const size_t bytes);
 
     void updateVars(
         vector<uint16_t>& seen
@@ -223,22 +235,39 @@ public:
 
     void free()
     {
-        vector<TransCache> tmp;
-        implCache.swap(tmp);
-    }
-
-    void clear()
-    {
-        for(vector<TransCache>::iterator
-            it = implCache.begin(), end = implCache.end()
-            ; it != end
-            ; ++it
-        ) {
-            it->lits.clear();
+        vector<LitExtra> tmp;
+        arena.swap(tmp);
+        garbage = 0;
+        for(Entry& e: entries) {
+            e = Entry();
         }
     }
 
 private:
+    struct Entry
+    {
+        uint32_t at = 0; ///<Start of the list in the arena
+        uint32_t num = 0;
+        uint32_t cap = 0; ///<Size of the range owned in the arena
+        uint32_t last_used = 0; ///<When the list was last updated
+    };
+    vector<Entry> entries;
+    vector<LitExtra> arena;
+    size_t garbage = 0; ///<Number of arena elements owned by no list
+    size_t max_mem = std::numeric_limits<size_t>::max();
+    uint32_t stamp = 0;
+    uint64_t num_evicted = 0;
+
+    void touch(const Lit lit);
+    void reserve_extra(const Lit lit, const size_t extra);
+    void compact();
+    bool mergeHelper(
+        const Lit into
+        , const Lit extraLit //Add this, too to the list of lits
+        , const bool red //The step was a redundant-dependent step?
+        , vector<uint16_t>& seen
+    );
+
     void tryVar(Solver* solver, Var var);
 
     void handleNewData(
@@ -254,18 +283,4 @@ private:
 
 } //end namespace
 
-namespace std
-{
-    template <>
-    inline void swap (CMSat::TransCache& m1, CMSat::TransCache& m2)
-    #ifdef _MSC_VER
-    throw()
-    #else
-    noexcept (true)
-    #endif
-    {
-         m1.lits.swap(m2.lits);
-    }
-}
-
 #endif //TRANSCACHE_H
@@ -127,6 +127,12 @@ void Main::readInAFile(const string& filename)
     if (conf.verbosity >= 1) {
         cout << "c Reading file '" << filename << "'" << endl;
     }
+
+    DimacsParser parser(solver, debugLib, conf.verbosity);
+    if (parser.parse_DIMACS_mmap(filename)) {
+        return;
+    }
+
     #ifndef USE_ZLIB
         FILE * in = fopen(filename.c_str(), "rb");
     #else
@@ -142,7 +148,6 @@ void Main::readInAFile(const string& filename)
         std::exit(1);
     }
 
-    DimacsParser parser(solver, debugLib, conf.verbosity);
     parser.parse_DIMACS(in);
 
     #ifndef USE_ZLIB
@@ -261,8 +266,20 @@ void Main::add_supported_options()
         ,"Number of threads")
     ("sync", po::value(&conf.sync_every_confl)->default_value(conf.sync_every_confl)
         , "Sync threads every N conflicts")
+    ("syncglue", po::value(&conf.sync_max_glue)->default_value(conf.sync_max_glue)
+        , "Share learnt clauses between threads with glue at most this")
+    ("syncsize", po::value(&conf.sync_max_size)->default_value(conf.sync_max_size)
+        , "Share learnt clauses between threads with at most this many literals (max 16)")
+    ("syncring", po::value(&conf.sync_ring_size)->default_value(conf.sync_ring_size)
+        , "Number of learnt clauses each thread keeps for the others to import")
+    ("cubedepth", po::value(&conf.cube_depth)->default_value(conf.cube_depth)
+        , "If non-zero and using multiple threads, split the problem with lookahead into (at most) 2^N cubes and let the threads solve them (cube-and-conquer) instead of racing on the whole problem")
+    ("cubecands", po::value(&conf.cube_lookahead_cands)->default_value(conf.cube_lookahead_cands)
+        , "Number of variables to look ahead on when splitting into cubes")
     ("maxtime", po::value(&conf.maxTime)->default_value(conf.maxTime, "MAX")
         , "Stop solving after this much time, print stats and exit")
+    ("maxtimewall", po::value(&conf.maxTimeIsWall)->default_value(conf.maxTimeIsWall)
+        , "Measure maxtime as wall-clock time instead of CPU time. Always so with more than one thread")
     ("maxconfl", po::value(&conf.maxConfl)->default_value(conf.maxConfl, "MAX")
         , "Stop solving after this many conflicts, print stats and exit")
     ("occsimp", po::value(&conf.perform_occur_based_simp)->default_value(conf.perform_occur_based_simp)
@@ -306,6 +323,12 @@ void Main::add_supported_options()
         , "Length of the long term trail size for blocking restart")
     ("blkrestmultip", po::value(&conf.blocking_restart_multip)->default_value(conf.blocking_restart_multip, s_blocking_multip.str())
         , "Multiplier used for blocking restart cut-off (called 'R' in Glucose 3.0)")
+    ("chrono", po::value(&conf.diff_declev_for_chrono)->default_value(conf.diff_declev_for_chrono)
+        , "Backtrack chronologically (only one level) if the backjump would be at least this many levels. -1 = never")
+    ("trailreuse", po::value(&conf.do_trail_reuse)->default_value(conf.do_trail_reuse)
+        , "At non-geometric restarts, keep the decisions that the variable ordering would make again")
+    ("trailreusemax", po::value(&conf.trail_reuse_max_in_row)->default_value(conf.trail_reuse_max_in_row)
+        , "Do a full restart after this many restarts in a row that reused the trail")
     ;
 
     std::ostringstream s_perf_multip;
@@ -318,6 +341,10 @@ void Main::add_supported_options()
     reduceDBOptions.add_options()
     ("cleanconflmult", po::value(&conf.clean_confl_multiplier)->default_value(conf.clean_confl_multiplier)
         , "If prop&confl are used to clean, by what value should we multiply the conflicts relative to propagations (conflicts are much more rare, but maybe more useful)")
+    ("gluemid", po::value(&conf.glue_put_mid_tier_if_below_or_eq)->default_value(conf.glue_put_mid_tier_if_below_or_eq)
+        , "Learnt clauses with glue above the core limit but at most this go to the mid tier, where they stay as long as they are used")
+    ("everymid", po::value(&conf.every_mid_tier_reduce)->default_value(conf.every_mid_tier_reduce)
+        , "Demote mid tier clauses to the local tier if they have not been used in this many conflicts. 0 = never")
     ("lockuip", po::value(&conf.lock_uip_per_dbclean)->default_value(conf.lock_uip_per_dbclean)
         , "How many clauses should be locked into DB per cleaning based on UIP usage")
     ("perfmult", po::value(&conf.multiplier_perf_values_after_cl_clean)->default_value(conf.multiplier_perf_values_after_cl_clean, s_perf_multip.str())
@@ -337,6 +364,14 @@ void Main::add_supported_options()
 
     po::options_description varPickOptions("Variable branching options");
     varPickOptions.add_options()
+    ("branch", po::value(&branch_strategy)->default_value(getNameOfBranchStrategy(conf.branch_strategy))
+        , "{vsids, vmtf, chb} Decision heuristic. 'vmtf' -> variable move-to-front. 'chb' -> conflict history-based branching")
+    ("chbstep", po::value(&conf.chb_step_start)->default_value(conf.chb_step_start)
+        , "CHB: starting step size of the exponential moving average")
+    ("chbstepmin", po::value(&conf.chb_step_min)->default_value(conf.chb_step_min)
+        , "CHB: step size never goes below this")
+    ("chbstepdecr", po::value(&conf.chb_step_decr)->default_value(conf.chb_step_decr)
+        , "CHB: step size is decreased by this much every conflict")
     ("vardecaystart", po::value(&conf.var_decay_start)->default_value(conf.var_decay_start)
         , "variable activity increase divider (MUST be smaller than multiplier)")
     ("vardecaymax", po::value(&conf.var_decay_max)->default_value(conf.var_decay_max)
@@ -386,6 +421,8 @@ void Main::add_supported_options()
         , "Carry out probing")
     ("probemaxm", po::value(&conf.probe_bogoprops_time_limitM)->default_value(conf.probe_bogoprops_time_limitM)
       , "Time in mega-bogoprops to perform probing")
+    ("probethreads", po::value(&conf.probe_threads)->default_value(conf.probe_threads)
+      , "Number of threads to probe with, before probing on one thread. Their work counts towards probemaxm")
     ("transred", po::value(&conf.doTransRed)->default_value(conf.doTransRed)
         , "Remove useless binary clauses (transitive reduction)")
     ("intree", po::value(&conf.doIntreeProbe)->default_value(conf.doIntreeProbe)
@@ -409,6 +446,10 @@ void Main::add_supported_options()
         , "Perform variable elimination as per Een and Biere")
     ("varelimto", po::value(&conf.varelim_time_limitM)->default_value(conf.varelim_time_limitM)
         , "Var elimination bogoprops M time limit")
+    ("varelimthreads", po::value(&conf.varelim_threads)->default_value(conf.varelim_threads)
+        , "Number of threads to calculate variable elimination resolvents with. The result does not depend on it")
+    ("varelimbatch", po::value(&conf.varelim_batch_size)->default_value(conf.varelim_batch_size)
+        , "Number of non-interacting variables tested for elimination together")
     ("emptyelim", po::value(&conf.do_empty_varelim)->default_value(conf.do_empty_varelim)
         , "Perform empty resolvent elimination using bit-map trick")
     ("elimstrgy", po::value(&var_elim_strategy)->default_value(getNameOfElimStrategy(conf.var_elim_strategy))
@@ -419,6 +460,10 @@ void Main::add_supported_options()
         , "How simple strategy (guessing, above) is calculated. Valid values: [0..1]")
     ("strengthen", po::value(&conf.do_strengthen_with_occur)->default_value(conf.do_strengthen_with_occur)
         , "Perform clause contraction through self-subsuming resolution as part of the occurrence-subsumption system")
+    ("subsumethreads", po::value(&conf.subsume_threads)->default_value(conf.subsume_threads)
+        , "Number of threads to search for subsumed and strengthenable long clauses with. The result does not depend on it")
+    ("subsumebatch", po::value(&conf.subsume_batch_size)->default_value(conf.subsume_batch_size)
+        , "Number of clauses whose subsumed and strengthenable clauses are searched for together")
     ("bva", po::value(&conf.do_bva)->default_value(conf.do_bva)
         , "Perform bounded variable addition")
     ("bvalim", po::value(&conf.bva_limit_per_call)->default_value(conf.bva_limit_per_call)
@@ -465,6 +510,26 @@ void Main::add_supported_options()
     //    , "Mix XORs and OrGates for new truths")
     ;
 
+    po::options_description gaussOptions("Gaussian elimination options");
+    gaussOptions.add_options()
+    ("gaussuntil", po::value(&conf.gaussconf.decision_until)->default_value(conf.gaussconf.decision_until)
+        , "Run Gaussian elimination on the XORs until this decision level. 0 switches it off")
+    ("savematrix", po::value(&conf.gaussconf.only_nth_gauss_save)->default_value(conf.gaussconf.only_nth_gauss_save)
+        , "Save the matrix state only every Nth decision level")
+    ("maxmatrixrows", po::value(&conf.gaussconf.maxMatrixRows)->default_value(conf.gaussconf.maxMatrixRows)
+        , "Don't build matrixes with more rows than this")
+    ("minmatrixrows", po::value(&conf.gaussconf.minMatrixRows)->default_value(conf.gaussconf.minMatrixRows)
+        , "Don't build matrixes with fewer rows than this")
+    ("maxnummatrixes", po::value(&conf.gaussconf.maxNumMatrixes)->default_value(conf.gaussconf.maxNumMatrixes)
+        , "Maximum number of matrixes to build")
+    ("nomatrixfind", po::value(&conf.gaussconf.noMatrixFind)->default_value(conf.gaussconf.noMatrixFind)
+        , "Put all XORs into one matrix instead of splitting them into independent ones")
+    ("ordercol", po::value(&conf.gaussconf.orderCols)->default_value(conf.gaussconf.orderCols)
+        , "Order the matrix columns by variable activity")
+    ("nodisablegauss", po::value(&conf.gaussconf.dontDisable)->default_value(conf.gaussconf.dontDisable)
+        , "Never disable a matrix, even if it is not useful")
+    ;
+
     po::options_description eqLitOpts("Equivalent literal options");
     eqLitOpts.add_options()
     ("scc", po::value(&conf.doFindAndReplaceEqLits)->default_value(conf.doFindAndReplaceEqLits)
@@ -526,6 +591,8 @@ void Main::add_supported_options()
         , "Update glues while analyzing")
     ("binpri", po::value(&conf.propBinFirst)->default_value(conf.propBinFirst)
         , "Propagated binary clauses strictly first")
+    ("nativexor", po::value(&conf.doNativeXor)->default_value(conf.doNativeXor)
+        , "Propagate XORs of 4 or more variables natively instead of cutting them into CNF")
     ("otfhyper", po::value(&conf.otfHyperbin)->default_value(conf.otfHyperbin)
         , "Perform hyper-binary resolution at dec. level 1 after every restart and during probing")
     ;
@@ -538,7 +605,7 @@ void Main::add_supported_options()
     ("cache", po::value(&conf.doCache)->default_value(conf.doCache)
         , "Use implication cache -- may use a lot of memory")
     ("cachesize", po::value(&conf.maxCacheSizeMB)->default_value(conf.maxCacheSizeMB)
-        , "Maximum size of the implication cache in MB. It may temporarily reach higher usage, but will be deleted&disabled if this limit is reached.")
+        , "Maximum size of the implication cache in MB. The least recently updated parts of the cache are evicted to stay under it.")
     ("calcreach", po::value(&conf.doCalcReach)->default_value(conf.doCalcReach)
         , "Calculate literal reachability")
     ("cachecutoff", po::value(&conf.cacheUpdateCutoff)->default_value(conf.cacheUpdateCutoff)
@@ -640,7 +707,9 @@ void Main::add_supported_options()
     ("compsvar", po::value(&conf.compVarLimit)->default_value(conf.compVarLimit)
         , "Only use components in case the number of variables is below this limit")
     ("compslimit", po::value(&conf.comp_find_time_limitM)->default_value(conf.comp_find_time_limitM)
-        , "Limit how much time is spent in component-finding");
+        , "Deprecated, has no effect. Component-finding is linear in the size of the problem")
+    ("compthreads", po::value(&conf.comp_threads)->default_value(conf.comp_threads)
+        , "Number of threads to find and solve the components with");
 
     p.add("input", 1);
     p.add("drup", 1);
@@ -666,6 +735,7 @@ void Main::add_supported_options()
     #ifdef USE_M4RI
     .add(xorOptions)
     #endif
+    .add(gaussOptions)
     .add(gateOptions)
     #if defined(USE_MYSQL) or defined(USE_SQLITE3)
     .add(sqlOptions)
@@ -857,6 +927,24 @@ void Main::parse_var_elim_strategy()
     }
 }
 
+void Main::parse_branch_strategy()
+{
+    if (branch_strategy == getNameOfBranchStrategy(branch_vsids)) {
+        conf.branch_strategy = branch_vsids;
+    } else if (branch_strategy == getNameOfBranchStrategy(branch_vmtf)) {
+        conf.branch_strategy = branch_vmtf;
+    } else if (branch_strategy == getNameOfBranchStrategy(branch_chb)) {
+        conf.branch_strategy = branch_chb;
+    } else {
+        std::cerr
+        << "ERROR: Cannot parse option given to '--branch'. It's '"
+        << branch_strategy << "'" << " but that none of the possiblities listed."
+        << endl;
+
+        std::exit(-1);
+    }
+}
+
 void Main::parse_restart_type()
 {
     if (vm.count("restart")) {
@@ -914,6 +1002,7 @@ void Main::manually_parse_some_options()
 
     parse_restart_type();
     parse_var_elim_strategy();
+    parse_branch_strategy();
 
     if (vm.count("input")) {
         filesToRead = vm["input"].as<vector<string> >();
@@ -206,24 +206,26 @@ int main(int argc, char** argv)
         gzclose(in);
         #endif
     } else {
-        #ifndef USE_ZLIB
-        FILE* in = fopen(argv[1], "rb");
-        #else
-        gzFile in = gzopen(argv[1], "rb");
-        #endif
-
-        if (in == NULL) {
-            printf("ERROR! Could not open file: %s\n", argc == 1 ? "<stdin>" : argv[1]), exit(1);
-            std::exit(1);
-        }
         DimacsParser parser(solver, false, conf.verbosity);
-        parser.parse_DIMACS(in);
+        if (!parser.parse_DIMACS_mmap(argv[1])) {
+            #ifndef USE_ZLIB
+            FILE* in = fopen(argv[1], "rb");
+            #else
+            gzFile in = gzopen(argv[1], "rb");
+            #endif
+
+            if (in == NULL) {
+                printf("ERROR! Could not open file: %s\n", argc == 1 ? "<stdin>" : argv[1]), exit(1);
+                std::exit(1);
+            }
+            parser.parse_DIMACS(in);
 
-        #ifndef USE_ZLIB
-        fclose(in);
-        #else
-        gzclose(in);
-        #endif
+            #ifndef USE_ZLIB
+            fclose(in);
+            #else
+            gzclose(in);
+            #endif
+        }
     }
 
     double parse_time = cpuTime() - cpu_time;
@@ -0,0 +1,197 @@
+/*
+ * CryptoMiniSat
+ *
+ * Copyright (c) 2009-2014, Mate Soos. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation
+ * version 2.0 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+*/
+
+#include "matrixfinder.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include "solver.h"
+#include "gaussian.h"
+#include "varreplacer.h"
+#include "time_mem.h"
+
+using namespace CMSat;
+using std::cout;
+using std::endl;
+
+MatrixFinder::MatrixFinder(Solver* _solver) :
+    solver(_solver)
+{
+}
+
+//Cancels out variables that are in the XOR twice and folds zero-level
+//assignments into the right hand side
+void MatrixFinder::clean_xor(Xor& x) const
+{
+    std::sort(x.vars.begin(), x.vars.end());
+    size_t j = 0;
+    for (size_t i = 0; i < x.vars.size(); i++) {
+        const Var var = x.vars[i];
+        if (i+1 < x.vars.size() && x.vars[i+1] == var) {
+            i++;
+            continue;
+        }
+
+        if (solver->value(var) != l_Undef) {
+            x.rhs ^= solver->value(var) == l_True;
+            continue;
+        }
+        x.vars[j++] = var;
+    }
+    x.vars.resize(j);
+}
+
+bool MatrixFinder::get_inter_xors(vector<Xor>& xors)
+{
+    for (const Xor& x: solver->xorclauses) {
+        Xor inter;
+        inter.rhs = x.rhs;
+        bool usable = true;
+        for (const Var outer: x.vars) {
+            Lit lit = solver->varReplacer->get_lit_replaced_with_outer(Lit(outer, false));
+            lit = solver->map_outer_to_inter(lit);
+            if (solver->varData[lit.var()].removed != Removed::none) {
+                usable = false;
+                break;
+            }
+            inter.rhs ^= lit.sign();
+            inter.vars.push_back(lit.var());
+        }
+        if (!usable)
+            continue;
+
+        clean_xor(inter);
+        if (inter.vars.empty()) {
+            if (inter.rhs) {
+                solver->ok = false;
+                return false;
+            }
+            continue;
+        }
+        xors.push_back(inter);
+    }
+
+    return true;
+}
+
+Var MatrixFinder::root(Var var)
+{
+    while (parent[var] != var) {
+        parent[var] = parent[parent[var]];
+        var = parent[var];
+    }
+    return var;
+}
+
+vector<vector<Xor> > MatrixFinder::split_into_sets(const vector<Xor>& xors)
+{
+    vector<vector<Xor> > sets;
+    if (solver->conf.gaussconf.noMatrixFind) {
+        sets.push_back(xors);
+        return sets;
+    }
+
+    parent.resize(solver->nVars());
+    for (Var var = 0; var < parent.size(); var++) {
+        parent[var] = var;
+    }
+    for (const Xor& x: xors) {
+        const Var first = root(x.vars[0]);
+        for (size_t i = 1; i < x.vars.size(); i++) {
+            const Var other = root(x.vars[i]);
+            if (other != first) {
+                parent[other] = first;
+            }
+        }
+    }
+
+    vector<uint32_t> set_of_root(parent.size(), std::numeric_limits<uint32_t>::max());
+    for (const Xor& x: xors) {
+        const Var r = root(x.vars[0]);
+        if (set_of_root[r] == std::numeric_limits<uint32_t>::max()) {
+            set_of_root[r] = sets.size();
+            sets.push_back(vector<Xor>());
+        }
+        sets[set_of_root[r]].push_back(x);
+    }
+
+    return sets;
+}
+
+bool MatrixFinder::find_matrixes()
+{
+    assert(solver->ok);
+    assert(solver->decisionLevel() == 0);
+    assert(solver->gauss_matrixes.empty());
+    const GaussConf& gconf = solver->conf.gaussconf;
+    const double myTime = cpuTime();
+
+    vector<Xor> xors;
+    if (!get_inter_xors(xors)) {
+        return false;
+    }
+    if (xors.size() < gconf.minMatrixRows) {
+        return true;
+    }
+
+    vector<vector<Xor> > sets = split_into_sets(xors);
+    std::stable_sort(sets.begin(), sets.end(),
+        [](const vector<Xor>& a, const vector<Xor>& b) {
+            return a.size() > b.size();
+        }
+    );
+
+    size_t unused = 0;
+    for (const vector<Xor>& set: sets) {
+        if (set.size() < gconf.minMatrixRows
+            || set.size() > gconf.maxMatrixRows
+            || solver->gauss_matrixes.size() >= gconf.maxNumMatrixes
+        ) {
+            unused += set.size();
+            continue;
+        }
+
+        Gaussian* gauss = new Gaussian(solver, gconf, solver->gauss_matrixes.size(), set);
+        solver->gauss_matrixes.push_back(gauss);
+        if (!gauss->init_until_fixedpoint()) {
+            break;
+        }
+        if (gauss->get_disabled()) {
+            delete gauss;
+            solver->gauss_matrixes.pop_back();
+        }
+    }
+
+    if (solver->conf.verbosity >= 2) {
+        cout
+        << "c [gauss] xors: " << xors.size()
+        << " sets: " << sets.size()
+        << " matrixes: " << solver->gauss_matrixes.size()
+        << " unused xors: " << unused
+        << " row-xor: " << PackedRow::xor_kernel_name()
+        << " T: " << std::fixed << std::setprecision(2)
+        << (cpuTime() - myTime)
+        << endl;
+    }
+
+    return solver->ok;
+}
@@ -0,0 +1,61 @@
+/*
+ * CryptoMiniSat
+ *
+ * Copyright (c) 2009-2014, Mate Soos. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation
+ * version 2.0 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+*/
+
+#ifndef MATRIXFINDER_H
+#define MATRIXFINDER_H
+
+#include <vector>
+#include "xor.h"
+
+namespace CMSat {
+
+class Solver;
+
+using std::vector;
+
+/**
+@brief Puts the XORs of the Solver into Gaussian matrixes
+
+The XORs the user added are stored in outer numbering. They are translated to
+the current internal numbering here, taking replaced variables and zero-level
+assignments into account. XORs that contain an eliminated or decomposed
+variable are left out. The rest are cut into independent sets (that share no
+variables), and the largest ones of these become the matrixes.
+*/
+class MatrixFinder
+{
+    public:
+        MatrixFinder(Solver* solver);
+        bool find_matrixes();
+
+    private:
+        bool get_inter_xors(vector<Xor>& xors);
+        void clean_xor(Xor& x) const;
+        Var root(Var var);
+        vector<vector<Xor> > split_into_sets(const vector<Xor>& xors);
+
+        vector<Var> parent;
+        Solver* solver;
+};
+
+}
+
+#endif //MATRIXFINDER_H
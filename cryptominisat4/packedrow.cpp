@@ -21,6 +21,11 @@
 
 #include "packedrow.h"
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define USE_X86_XOR_KERNELS
+#include <immintrin.h>
+#endif
+
 ::std::ostream& operator << (std::ostream& os, const CMSat::PackedRow& m)
 {
     for(uint32_t i = 0; i < m.getSize()*64; i++) {
@@ -32,6 +37,95 @@
 
 using namespace CMSat;
 
+static void xor_words_64(
+    uint64_t* __restrict a
+    , const uint64_t* __restrict b
+    , const uint32_t num
+) {
+    for (uint32_t i = 0; i != num; i++) {
+        a[i] ^= b[i];
+    }
+}
+
+#ifdef USE_X86_XOR_KERNELS
+__attribute__((target("avx2")))
+static void xor_words_avx2(
+    uint64_t* __restrict a
+    , const uint64_t* __restrict b
+    , const uint32_t num
+) {
+    uint32_t i = 0;
+    for (; i + 4 <= num; i += 4) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+        _mm256_storeu_si256((__m256i*)(a + i), _mm256_xor_si256(x, y));
+    }
+    for (; i != num; i++) {
+        a[i] ^= b[i];
+    }
+}
+
+__attribute__((target("avx512f")))
+static void xor_words_avx512(
+    uint64_t* __restrict a
+    , const uint64_t* __restrict b
+    , const uint32_t num
+) {
+    uint32_t i = 0;
+    for (; i + 8 <= num; i += 8) {
+        const __m512i x = _mm512_loadu_si512((const void*)(a + i));
+        const __m512i y = _mm512_loadu_si512((const void*)(b + i));
+        _mm512_storeu_si512((void*)(a + i), _mm512_xor_si512(x, y));
+    }
+    if (i + 4 <= num) {
+        const __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+        const __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+        _mm256_storeu_si256((__m256i*)(a + i), _mm256_xor_si256(x, y));
+        i += 4;
+    }
+    for (; i != num; i++) {
+        a[i] ^= b[i];
+    }
+}
+#endif //USE_X86_XOR_KERNELS
+
+typedef void (*xor_words_func)(uint64_t* __restrict, const uint64_t* __restrict, uint32_t);
+
+static xor_words_func select_xor_kernel()
+{
+    #ifdef USE_X86_XOR_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return xor_words_avx512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return xor_words_avx2;
+    }
+    #endif
+
+    return xor_words_64;
+}
+
+void (* const PackedRow::xor_words)(
+    uint64_t* __restrict a
+    , const uint64_t* __restrict b
+    , uint32_t num
+) = select_xor_kernel();
+
+const char* PackedRow::xor_kernel_name()
+{
+    #ifdef USE_X86_XOR_KERNELS
+    if (xor_words == xor_words_avx512) {
+        return "avx512";
+    }
+    if (xor_words == xor_words_avx2) {
+        return "avx2";
+    }
+    #endif
+
+    return "64-bit";
+}
+
 bool PackedRow::operator ==(const PackedRow& b) const
 {
     #ifdef DEBUG_ROW
@@ -57,12 +151,8 @@ bool PackedRow::operator !=(const PackedRow& b) const
 uint32_t PackedRow::popcnt() const
 {
     uint32_t popcnt = 0;
-    for (uint32_t i = 0; i < size; i++) if (mp[i]) {
-        uint64_t tmp = mp[i];
-        for (uint32_t i2 = 0; i2 < 64; i2++) {
-            popcnt += (tmp & 1);
-            tmp >>= 1;
-        }
+    for (uint32_t i = 0; i < size; i++) {
+        popcnt += popcount64(mp[i]);
     }
     return popcnt;
 }
@@ -70,52 +160,57 @@ uint32_t PackedRow::popcnt() const
 uint32_t PackedRow::popcnt(const uint32_t from) const
 {
     uint32_t popcnt = 0;
-    for (uint32_t i = from/64; i != size; i++) if (mp[i]) {
+    for (uint32_t i = from/64; i < size; i++) {
         uint64_t tmp = mp[i];
-        uint32_t i2;
         if (i == from/64) {
-            i2 = from%64;
-            tmp >>= i2;
-        } else
-            i2 = 0;
-        for (; i2 < 64; i2++) {
-            popcnt += (tmp & 1);
-            tmp >>= 1;
+            tmp >>= from%64;
         }
+        popcnt += popcount64(tmp);
     }
     return popcnt;
 }
 
+/**
+@brief Creates the clause the XOR in this (varset) row implies
+
+All variables of the row must be assigned, except at most one. If there is an
+unassigned one, it is put first in the clause, with the sign that satisfies
+the XOR, and true is returned. Otherwise the clause is conflicting, all its
+literals are false.
+*/
 bool PackedRow::fill(vector<Lit>& tmp_clause, const vector<lbool>& assigns, const vector<Var>& col_to_var_original) const
 {
     bool final = !is_true_internal;
 
     tmp_clause.clear();
-    uint32_t col = 0;
     bool wasundef = false;
-    for (uint32_t i = 0; i < size; i++) for (uint32_t i2 = 0; i2 < 64; i2++) {
-        if ((mp[i] >> i2) &1) {
-            const Var& var = col_to_var_original[col];
+    for (uint32_t i = 0; i < size; i++) {
+        uint64_t tmp = mp[i];
+        while(tmp) {
+            const uint32_t col = i*64 + lowest_bit64(tmp);
+            tmp &= tmp - 1;
+
+            const Var var = col_to_var_original[col];
             assert(var != std::numeric_limits<Var>::max());
 
             const lbool val = assigns[var];
-            const bool val_bool = val.getBool();
-            tmp_clause.push_back(Lit(var, val_bool));
-            final ^= val_bool;
             if (val == l_Undef) {
                 assert(!wasundef);
+                tmp_clause.push_back(Lit(var, false));
                 std::swap(tmp_clause[0], tmp_clause.back());
                 wasundef = true;
+            } else {
+                const bool val_bool = (val == l_True);
+                tmp_clause.push_back(Lit(var, val_bool));
+                final ^= val_bool;
             }
         }
-        col++;
     }
     if (wasundef) {
         tmp_clause[0] ^= final;
-        //assert(ps != ps_first+1);
-    } else
+    } else {
         assert(!final);
+    }
 
     return wasundef;
 }
-
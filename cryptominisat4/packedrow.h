@@ -36,6 +36,33 @@ namespace CMSat {
 
 class PackedMatrix;
 
+inline uint32_t popcount64(const uint64_t x)
+{
+    #if __GNUC__ >= 4
+    return __builtin_popcountll(x);
+    #else
+    uint32_t popcount = 0;
+    for(uint64_t tmp = x; tmp; tmp >>= 1) {
+        popcount += tmp & 1;
+    }
+    return popcount;
+    #endif
+}
+
+//x must not be zero
+inline uint32_t lowest_bit64(const uint64_t x)
+{
+    #if __GNUC__ >= 4
+    return __builtin_ctzll(x);
+    #else
+    uint32_t at = 0;
+    for(uint64_t tmp = x; !(tmp & 1); tmp >>= 1) {
+        at++;
+    }
+    return at;
+    #endif
+}
+
 class PackedRow
 {
 public:
@@ -50,7 +77,7 @@ public:
         assert(size == b.size);
         #endif
 
-        memcpy(mp-1, b.mp-1, size+1);
+        memcpy(mp-1, b.mp-1, sizeof(uint64_t)*(size+1));
         return *this;
     }
 
@@ -70,6 +97,9 @@ public:
         return *this;
     }
 
+    ///XORs both the matrix row and the varset row (and their right hand
+    ///sides) of 'b' into this one. The two halves are adjacent in memory,
+    ///so this is a single run of 2*(size+1) words
     void xorBoth(const PackedRow& b)
     {
         #ifdef DEBUG_ROW
@@ -78,38 +108,29 @@ public:
         assert(b.size == size);
         #endif
 
-        for (uint32_t i = 0; i != 2*size+1; i++) {
-            *(mp + i) ^= *(b.mp + i);
-        }
-
-        is_true_internal ^= b.is_true_internal;
+        xor_words(mp-1, b.mp-1, 2*(size+1));
     }
 
+    ///XORs 'num' words of 'b' into 'a'. Uses the widest of the AVX-512,
+    ///AVX2 or plain 64-bit kernels the CPU we are running on supports
+    static void (* const xor_words)(
+        uint64_t* __restrict a
+        , const uint64_t* __restrict b
+        , uint32_t num
+    );
+    static const char* xor_kernel_name();
 
     uint32_t popcnt() const;
     uint32_t popcnt(uint32_t from) const;
 
     bool popcnt_is_one() const
     {
-        #if __GNUC__ >= 4
-        int ret = 0;
+        uint32_t ret = 0;
         for (uint32_t i = 0; i != size; i++) {
-            ret += __builtin_popcount(mp[i]&0xffffffff);
-            ret += __builtin_popcount(mp[i]>>32);
+            ret += popcount64(mp[i]);
             if (ret > 1) return false;
         }
         return ret == 1;
-        #else
-        uint32_t popcount = 0;
-        for (uint32_t i = 0; i != size; i++) {
-            uint64_t tmp = mp[i];
-            while(tmp) {
-                popcount += tmp & 1;
-                tmp >>= 1;
-            }
-        }
-        return popcount == 1;
-        #endif
     }
 
     bool popcnt_is_one(uint32_t from) const
@@ -189,34 +210,43 @@ public:
     }
 
     template<class T>
-    void set(const T& v, const vector<uint16_t>& var_to_col, const uint32_t matrix_size)
+    void set(const T& v, const vector<uint32_t>& var_to_col)
     {
-        assert(size == (matrix_size/64) + ((bool)(matrix_size % 64)));
-        //mp = new uint64_t[size];
         setZero();
-        for (uint32_t i = 0; i != v.size(); i++) {
-            const uint32_t toset_var = var_to_col[v[i].var()];
+        for (uint32_t i = 0; i != v.vars.size(); i++) {
+            const uint32_t toset_var = var_to_col[v.vars[i]];
             assert(toset_var != std::numeric_limits<uint32_t>::max());
 
             setBit(toset_var);
         }
 
-        is_true_internal = !v.xorEqualFalse();
+        is_true_internal = v.rhs;
     }
 
     bool fill(vector<Lit>& tmp_clause, const vector<lbool>& assigns, const vector<Var>& col_to_var_original) const;
 
-    unsigned long int scan(const unsigned long int var) const
+    ///Returns the first set bit at or after 'from', or
+    ///std::numeric_limits<uint32_t>::max() if there is none
+    uint32_t scan(const uint32_t from) const
     {
         #ifdef DEBUG_ROW
         assert(size > 0);
         #endif
 
-        for(uint32_t i = var; i != size*64; i++) {
-            if (this->operator[](i)) return i;
-        }
+        uint32_t at = from/64;
+        if (at >= size)
+            return std::numeric_limits<uint32_t>::max();
 
-        return std::numeric_limits<unsigned long int>::max();
+        uint64_t tmp = mp[at] & (~(uint64_t)0 << (from%64));
+        while(true) {
+            if (tmp) {
+                return at*64 + lowest_bit64(tmp);
+            }
+            at++;
+            if (at == size)
+                return std::numeric_limits<uint32_t>::max();
+            tmp = mp[at];
+        }
     }
 
     //friend ::std::ostream& operator << (std::ostream& os, const PackedRow& m);
@@ -33,6 +33,7 @@
 #include "clausecleaner.h"
 #include "completedetachreattacher.h"
 #include "sqlstats.h"
+#include "batchworkers.h"
 
 using namespace CMSat;
 using std::make_pair;
@@ -54,7 +55,8 @@ Prober::Prober(Solver* _solver):
 
 uint64_t Prober::limit_used() const
 {
-    return solver->propStats.bogoProps + solver->propStats.otfHyperTime + extraTime + extraTimeCache;
+    return solver->propStats.bogoProps + solver->propStats.otfHyperTime
+        + extraTime + extraTimeCache + parallelWork;
 }
 
 void Prober::checkOTFRatio()
@@ -98,6 +100,7 @@ void Prober::reset_stats_and_state()
 {
     extraTime = 0;
     extraTimeCache = 0;
+    parallelWork = 0;
     solver->propStats.clear();
     runStats.clear();
     runStats.origNumBins = solver->binTri.redBins + solver->binTri.irredBins;
@@ -255,30 +258,25 @@ void Prober::check_if_must_disable_otf_hyperbin_and_tred(const uint64_t numProps
     }
 }
 
-void Prober::check_if_must_disable_cache_update()
+void Prober::check_if_must_shrink_cache()
 {
     //If time wasted on cache updating (extraTime) is large, stop cache
     //updation
-    double timeOnCache = (double)extraTimeCache
-            /(double)(solver->propStats.bogoProps
-               + solver->propStats.otfHyperTime
-               + extraTime + extraTimeCache
-             ) * 100.0;
+    double timeOnCache = (double)extraTimeCache/(double)limit_used() * 100.0;
 
 
     //More than 50% of the time is spent updating the cache... that's a lot
-    //Disable and free
+    //Evict the least recently updated half of it
     if (timeOnCache > 50.0 && solver->conf.doCache)  {
         if (solver->conf.verbosity >= 2) {
             cout
             << "c [probe] too much time spent on updating cache: "
             << std::fixed << std::setprecision(1) << timeOnCache
-            << "% during probing --> disabling cache"
+            << "% during probing --> evicting half of it"
             << endl;
         }
 
-        solver->conf.doCache = false;
-        solver->implCache.free();
+        solver->implCache.evict_to(solver->implCache.mem_used_by_lits()/2);
     } else {
         if (solver->conf.verbosity >= 2) {
             cout
@@ -364,10 +362,22 @@ bool Prober::probe()
 
     assert(solver->propStats.bogoProps == 0);
     assert(solver->propStats.otfHyperTime == 0);
-    for(size_t i = 0
+
+    //The threads go first, on the same budget. Probing on one thread
+    //carries on with the candidates they did not get to
+    size_t i = 0;
+    if (solver->conf.probe_threads > 1
+        && !solver->drup->enabled()
+    ) {
+        i = probe_in_parallel(poss_choice, numPropsTodo);
+        if (!solver->okay())
+            goto end;
+    }
+
+    for(
         ; i < poss_choice.size()
         && limit_used() < numPropsTodo
-        && cpuTime() <= solver->conf.maxTime
+        && !solver->out_of_time()
         && !solver->must_interrupt_asap()
         ; i++
     ) {
@@ -419,7 +429,7 @@ end:
 
     update_and_print_stats(myTime, numPropsTodo);
     check_if_must_disable_otf_hyperbin_and_tred(numPropsTodo);
-    check_if_must_disable_cache_update();
+    check_if_must_shrink_cache();
 
     solver->test_all_clause_attached();
     return solver->ok;
@@ -479,15 +489,16 @@ void Prober::update_cache(Lit thisLit, Lit lit, size_t numElemsSet)
         //Update stats/markings
         //cacheUpdated[(~ancestor).toInt()]++;
         extraTime += 1;
-        extraTimeCache += solver->implCache[(~ancestor).toInt()].lits.size()/30;
-        extraTimeCache += solver->implCache[(~thisLit).toInt()].lits.size()/30;
+        extraTimeCache += solver->implCache[(~ancestor).toInt()].size()/30;
+        extraTimeCache += solver->implCache[(~thisLit).toInt()].size()/30;
 
         const bool redStep = solver->varData[thisLit.var()].reason.isRedStep();
 
         //Update the cache now
         assert(ancestor != lit_Undef);
-        bool taut = solver->implCache[(~ancestor).toInt()].merge(
-            solver->implCache[(~thisLit).toInt()].lits
+        bool taut = solver->implCache.merge(
+            ~ancestor
+            , ~thisLit
             , thisLit
             , redStep
             , ancestor.var()
@@ -553,8 +564,9 @@ void Prober::add_rest_of_lits_to_cache(Lit lit)
         tmp_lits.push_back(thisLit);
     }
 
-    bool taut = solver->implCache[(~lit).toInt()].merge(
-        tmp_lits
+    bool taut = solver->implCache.merge(
+        ~lit
+        , tmp_lits
         , lit_Undef
         , true //Red step -- we don't know, so we assume
         , lit.var()
@@ -739,6 +751,481 @@ bool Prober::try_this(const Lit lit, const bool first, const uint64_t orig_num_p
     return solver->fully_enqueue_these(toEnqueue);
 }
 
+/**
+@brief Probes the candidates on many threads
+
+Every thread propagates on its own trail, and only reads the watchlists. A long
+clause is only looked at when one of its watched literals becomes false, so
+fewer literals may be implied than with propagate(), but all of them hold.
+Like propagate_bfs(), binary clauses are propagated first, and every literal
+on the trail has an ancestor that implies it. That gives the failed literal
+and the hyper-binary clauses.
+
+The failed literals, bothprop, equivalences, hyper-binaries and cache updates
+are committed after every batch, in the order of the candidates, so they do
+not depend on the number of threads or their timing.
+
+@return How many of the candidates were probed
+*/
+size_t Prober::probe_in_parallel(
+    const vector<Var>& poss_choice
+    , const uint64_t numPropsTodo
+) {
+    //Batches do not depend on the number of threads, so neither does the result
+    const size_t num_threads = solver->conf.probe_threads;
+    const size_t batch_size = 512;
+    vector<ProbeContext> contexts(num_threads);
+    BatchWorkers workers(num_threads);
+    for(ProbeContext& ctx: contexts) {
+        ctx.assigned.resize(solver->nVars()*2, 0);
+        ctx.implied.resize(solver->nVars()*2, 0);
+        ctx.ancestor.resize(solver->nVars(), lit_Undef);
+        ctx.depth.resize(solver->nVars(), 0);
+        ctx.red_step.resize(solver->nVars(), 0);
+    }
+
+    size_t at = 0;
+    vector<ProbeResult> results;
+    while(at < poss_choice.size()
+        && limit_used() < numPropsTodo
+        && !solver->out_of_time()
+        && !solver->must_interrupt_asap()
+    ) {
+        const size_t end = std::min(poss_choice.size(), at + batch_size);
+        results.clear();
+        results.resize(end - at);
+
+        workers.run(end - at, [&](const size_t i, const size_t thread) {
+            probe_var_in_context(contexts[thread], poss_choice[at + i], results[i]);
+        });
+
+        for(ProbeContext& ctx: contexts) {
+            parallelWork += ctx.work;
+            ctx.work = 0;
+        }
+        at = end;
+        if (!commit_probe_results(results))
+            break;
+    }
+
+    if (solver->conf.verbosity >= 2) {
+        cout
+        << "c [probe] threads: " << num_threads
+        << " candidates done: " << at << "/" << poss_choice.size()
+        << " work: " << std::setprecision(2) << (double)parallelWork/(1000.0*1000.0) << "M"
+        << endl;
+    }
+
+    return at;
+}
+
+void Prober::probe_var_in_context(
+    ProbeContext& ctx
+    , const Var var
+    , ProbeResult& res
+) {
+    if (solver->value(var) != l_Undef
+        || solver->varData[var].removed != Removed::none
+        || !solver->varData[var].is_decision
+    ) {
+        return;
+    }
+
+    res.var = var;
+    res.numProbed++;
+    const Lit lit = Lit(var, false);
+    if (!propagate_in_context(ctx, lit, res)) {
+        res.failed = ctx.failed;
+        return;
+    }
+    save_steps_in_context(ctx, res.steps[0]);
+    unassign_in_context(ctx, ctx.trail);
+    std::swap(ctx.trail, ctx.first_trail);
+    for(const Lit l: ctx.first_trail) {
+        ctx.implied[l.toInt()] = 1;
+    }
+
+    res.numProbed++;
+    if (!propagate_in_context(ctx, ~lit, res)) {
+        res.failed = ctx.failed;
+    } else {
+        //Index 0 is the probed literal itself
+        for(size_t i = 1; i < ctx.trail.size(); i++) {
+            const Lit l = ctx.trail[i];
+            if (ctx.implied[l.toInt()]) {
+                res.bothSame.push_back(l);
+            } else if (ctx.implied[(~l).toInt()]
+                //The same pair is found from the other var, too
+                && l.var() > var
+            ) {
+                res.equivs.push_back(~l);
+            }
+        }
+        save_steps_in_context(ctx, res.steps[1]);
+        unassign_in_context(ctx, ctx.trail);
+    }
+
+    for(const Lit l: ctx.first_trail) {
+        ctx.implied[l.toInt()] = 0;
+    }
+}
+
+//Long trails are not kept, same as the cache is not updated from them
+void Prober::save_steps_in_context(
+    const ProbeContext& ctx
+    , vector<ProbeStep>& steps
+) const {
+    if (ctx.trail.size() > solver->conf.cacheUpdateCutoff) {
+        return;
+    }
+
+    for(const Lit l: ctx.trail) {
+        ProbeStep step;
+        step.lit = l;
+        step.ancestor = ctx.ancestor[l.var()];
+        step.red = ctx.red_step[l.var()];
+        steps.push_back(step);
+    }
+}
+
+lbool Prober::value_in_context(const ProbeContext& ctx, const Lit lit) const
+{
+    const lbool val = solver->value(lit);
+    if (val != l_Undef) {
+        return val;
+    }
+    if (ctx.assigned[lit.toInt()]) {
+        return l_True;
+    }
+    if (ctx.assigned[(~lit).toInt()]) {
+        return l_False;
+    }
+    return l_Undef;
+}
+
+//False on the trail, but not at decision level 0
+bool Prober::false_in_context(const ProbeContext& ctx, const Lit lit) const
+{
+    return solver->value(lit) == l_Undef && ctx.assigned[(~lit).toInt()];
+}
+
+//Returns FALSE if the literal is false on the trail
+bool Prober::enqueue_in_context(
+    ProbeContext& ctx
+    , const Lit lit
+    , const Lit ancestor
+    , const bool red
+) {
+    const lbool val = value_in_context(ctx, lit);
+    if (val == l_Undef) {
+        ctx.assigned[lit.toInt()] = 1;
+        ctx.ancestor[lit.var()] = ancestor;
+        ctx.depth[lit.var()] = (ancestor == lit_Undef) ? 0 : ctx.depth[ancestor.var()] + 1;
+        ctx.red_step[lit.var()] = red;
+        ctx.trail.push_back(lit);
+    }
+    return val != l_False;
+}
+
+void Prober::unassign_in_context(ProbeContext& ctx, const vector<Lit>& lits)
+{
+    for(const Lit l: lits) {
+        ctx.assigned[l.toInt()] = 0;
+    }
+}
+
+Lit Prober::common_ancestor_in_context(ProbeContext& ctx, Lit a, Lit b) const
+{
+    //Both are on the trail, so they meet at the probed literal at the latest
+    while(a != b) {
+        if (ctx.depth[a.var()] < ctx.depth[b.var()]) {
+            std::swap(a, b);
+        }
+        a = ctx.ancestor[a.var()];
+        ctx.work++;
+    }
+
+    return a;
+}
+
+/**
+@brief Implies lit (or a conflict, if lit_Undef) from the literals in ctx.reasons
+
+Their deepest common ancestor implies lit, too. If there is more than one
+reason, the binary clause between them is the hyper-binary resolvent.
+*/
+void Prober::imply_in_context(ProbeContext& ctx, const Lit lit, ProbeResult& res)
+{
+    Lit ancestor = ctx.reasons[0];
+    for(size_t i = 1; i < ctx.reasons.size(); i++) {
+        ancestor = common_ancestor_in_context(ctx, ancestor, ctx.reasons[i]);
+    }
+
+    if (lit == lit_Undef) {
+        ctx.failed = ancestor;
+        return;
+    }
+
+    if (solver->conf.otfHyperbin && ctx.reasons.size() > 1) {
+        res.hyperBins.push_back(BinaryClause(~ancestor, lit, true));
+    }
+    enqueue_in_context(ctx, lit, ancestor, true);
+}
+
+void Prober::propagate_long_in_context(
+    ProbeContext& ctx
+    , const Lit p
+    , const Watched& w
+    , ProbeResult& res
+) {
+    ctx.reasons.clear();
+    ctx.reasons.push_back(p);
+    if (w.isTri()) {
+        const lbool val2 = value_in_context(ctx, w.lit2());
+        const lbool val3 = value_in_context(ctx, w.lit3());
+        if (val2 == l_True || val3 == l_True
+            || (val2 == l_Undef && val3 == l_Undef)
+        ) {
+            return;
+        }
+        Lit unset = lit_Undef;
+        for(const Lit l: {w.lit2(), w.lit3()}) {
+            if (false_in_context(ctx, l)) {
+                ctx.reasons.push_back(~l);
+            } else if (value_in_context(ctx, l) == l_Undef) {
+                unset = l;
+            }
+        }
+        imply_in_context(ctx, unset, res);
+    } else if (w.isClause()) {
+        if (value_in_context(ctx, w.getBlockedLit()) == l_True) {
+            return;
+        }
+
+        //The other watch is not moved, so look at the whole clause
+        const Clause& cl = *solver->cl_alloc.ptr(w.get_offset());
+        ctx.work += cl.size()/4;
+        Lit unset = lit_Undef;
+        size_t numUnset = 0;
+        for(const Lit l: cl) {
+            const lbool val = value_in_context(ctx, l);
+            if (val == l_True) {
+                return;
+            }
+            if (val == l_Undef) {
+                unset = l;
+                if (++numUnset > 1)
+                    return;
+            }
+        }
+        for(const Lit l: cl) {
+            if (l != ~p && false_in_context(ctx, l)) {
+                ctx.reasons.push_back(~l);
+            }
+        }
+        imply_in_context(ctx, unset, res);
+    }
+}
+
+//Returns FALSE and leaves nothing assigned on a conflict
+bool Prober::propagate_in_context(ProbeContext& ctx, const Lit lit, ProbeResult& res)
+{
+    ctx.trail.clear();
+    ctx.failed = lit_Undef;
+    enqueue_in_context(ctx, lit, lit_Undef, false);
+
+    size_t qhead_bin = 0;
+    size_t qhead_long = 0;
+    size_t ws_at = 0;
+    while(ctx.failed == lit_Undef) {
+        //All binary clauses first, see propagate_bfs(), which costs the same
+        if (qhead_bin < ctx.trail.size()) {
+            const Lit p = ctx.trail[qhead_bin++];
+            watch_subarray_const ws = solver->watches[(~p).toInt()];
+            ctx.work += 1 + ws.size()*4;
+            for(const Watched& w: ws) {
+                if (w.isBinary()
+                    && !enqueue_in_context(ctx, w.lit2(), p, w.red())
+                ) {
+                    ctx.reasons.clear();
+                    ctx.reasons.push_back(p);
+                    if (false_in_context(ctx, w.lit2())) {
+                        ctx.reasons.push_back(~w.lit2());
+                    }
+                    imply_in_context(ctx, lit_Undef, res);
+                    break;
+                }
+            }
+            continue;
+        }
+
+        if (qhead_long == ctx.trail.size())
+            break;
+
+        //Go back to binary clauses as soon as a long clause propagates
+        const Lit p = ctx.trail[qhead_long];
+        watch_subarray_const ws = solver->watches[(~p).toInt()];
+        const size_t trail_size = ctx.trail.size();
+        ctx.work += 1 + ws.size()*4;
+        for(; ws_at < ws.size()
+            && ctx.failed == lit_Undef
+            && ctx.trail.size() == trail_size
+            ; ws_at++
+        ) {
+            propagate_long_in_context(ctx, p, ws[ws_at], res);
+        }
+        if (ws_at == ws.size()) {
+            qhead_long++;
+            ws_at = 0;
+        }
+    }
+
+    if (ctx.failed != lit_Undef) {
+        unassign_in_context(ctx, ctx.trail);
+        return false;
+    }
+    return true;
+}
+
+bool Prober::commit_probe_results(const vector<ProbeResult>& results)
+{
+    assert(solver->decisionLevel() == 0);
+
+    vector<Lit> tmp;
+    for(const ProbeResult& res: results) {
+        runStats.numLoopIters++;
+        if (res.var == var_Undef) {
+            continue;
+        }
+        runStats.numVarProbed++;
+        runStats.numProbed += res.numProbed;
+
+        for(const BinaryClause& bin: res.hyperBins) {
+            if (solver->value(bin.getLit1()) == l_Undef
+                && solver->value(bin.getLit2()) == l_Undef
+            ) {
+                runStats.addedBin++;
+            }
+            tmp.clear();
+            tmp.push_back(bin.getLit1());
+            tmp.push_back(bin.getLit2());
+            solver->add_clause_int(tmp, true);
+            if (!solver->ok)
+                return false;
+        }
+
+        if (res.failed != lit_Undef) {
+            runStats.numFailed++;
+            tmp.clear();
+            tmp.push_back(~res.failed);
+            solver->add_clause_int(tmp, true);
+            if (!solver->ok)
+                return false;
+        }
+
+        for(const Lit lit: res.bothSame) {
+            runStats.bothSameAdded++;
+            tmp.clear();
+            tmp.push_back(lit);
+            solver->add_clause_int(tmp);
+            if (!solver->ok)
+                return false;
+        }
+
+        for(const vector<ProbeStep>& steps: res.steps) {
+            if (!commit_steps(steps))
+                return false;
+        }
+
+        if (!solver->conf.doFindAndReplaceEqLits) {
+            continue;
+        }
+        for(const Lit lit: res.equivs) {
+            runStats.equivFound++;
+            tmp.clear();
+            tmp.push_back(Lit(res.var, false));
+            tmp.push_back(Lit(lit.var(), false));
+            solver->add_xor_clause_inter(tmp, lit.sign(), true);
+            if (!solver->ok)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+@brief Marks the trail of a probe visited, and updates the cache from it
+
+Same as try_this() does, through update_cache() or add_rest_of_lits_to_cache()
+*/
+bool Prober::commit_steps(const vector<ProbeStep>& steps)
+{
+    if (steps.empty()) {
+        return true;
+    }
+
+    const Lit lit = steps[0].lit;
+    toEnqueue.clear();
+    tmp_lits.clear();
+    for(size_t c = steps.size(); c-- > 0;) {
+        extraTime += 2;
+        const ProbeStep& step = steps[c];
+        visitedAlready[step.lit.toInt()] = 1;
+        tmp_lits.push_back(step.lit);
+        if (!solver->conf.doCache
+            || !solver->conf.otfHyperbin
+            || step.lit == lit
+        ) {
+            continue;
+        }
+
+        extraTime += 1;
+        extraTimeCache += solver->implCache[(~step.ancestor).toInt()].size()/30;
+        extraTimeCache += solver->implCache[(~step.lit).toInt()].size()/30;
+        const bool taut = solver->implCache.merge(
+            ~step.ancestor
+            , ~step.lit
+            , step.lit
+            , step.red
+            , step.ancestor.var()
+            , solver->seen
+        );
+        if (taut) {
+            toEnqueue.push_back(~step.ancestor);
+        }
+    }
+
+    if (solver->conf.doCache
+        && !solver->conf.otfHyperbin
+    ) {
+        const bool taut = solver->implCache.merge(
+            ~lit
+            , tmp_lits
+            , lit_Undef
+            , true //Red step -- we don't know, so we assume
+            , lit.var()
+            , solver->seen
+        );
+        if (taut) {
+            toEnqueue.push_back(~lit);
+        }
+    }
+
+    runStats.bothSameAdded += toEnqueue.size();
+    extraTime += 3*toEnqueue.size();
+    vector<Lit> tmp;
+    for(const Lit unit: toEnqueue) {
+        tmp.clear();
+        tmp.push_back(unit);
+        solver->add_clause_int(tmp);
+        if (!solver->ok)
+            return false;
+    }
+
+    return true;
+}
+
 size_t Prober::mem_used() const
 {
     size_t mem = 0;
@@ -884,6 +1371,7 @@ void Prober::Stats::print_short(const Solver* solver, const bool time_out, const
     << "c [probe]"
     << " 0-depth assigns: " << zeroDepthAssigns
     << " bsame: " << bothSameAdded
+    << " equiv: " << equivFound
     << " Flit: " << numFailed
 
     // x2 because it's LITERAL visit
@@ -36,6 +36,7 @@ using std::map;
 using std::vector;
 
 class Solver;
+class Watched;
 
 //#define DEBUG_REMOVE_USELESS_BIN
 
@@ -83,6 +84,7 @@ class Prober {
 
                 //Bothprop
                 bothSameAdded += other.bothSameAdded;
+                equivFound += other.equivFound;
 
                 return *this;
             }
@@ -119,6 +121,12 @@ class Prober {
                     , "% visited"
                 );
 
+                print_stats_line("c bothprop equiv"
+                    , equivFound
+                    , stats_line_percent(equivFound, numVisited)
+                    , "% visited"
+                );
+
                 print_stats_line("c probed"
                     , numProbed
                     , ratio_for_stat(numProbed, cpu_time)
@@ -206,6 +214,7 @@ class Prober {
 
             //Bothprop
             uint64_t bothSameAdded = 0;
+            uint64_t equivFound = 0;
         };
 
         const Stats& get_stats() const;
@@ -224,7 +233,7 @@ class Prober {
         uint64_t update_numpropstodo_based_on_prev_performance(uint64_t numPropsTodo);
         void clean_clauses_after_probe();
         void check_if_must_disable_otf_hyperbin_and_tred(const uint64_t numPropsTodo);
-        void check_if_must_disable_cache_update();
+        void check_if_must_shrink_cache();
         vector<Var> randomize_possible_choices();
         vector<size_t> create_fast_random_lookup(const vector<Var>& poss_choice);
         Lit update_lit_for_dominator(
@@ -248,6 +257,50 @@ class Prober {
         void add_rest_of_lits_to_cache(Lit lit);
         void handle_failed_lit(Lit lit, Lit failed);
 
+        //For probing on many threads
+        struct ProbeContext
+        {
+            vector<char> assigned; ///<Literals set on this trail
+            vector<char> implied; ///<Literals set when probing the other polarity
+            vector<Lit> ancestor; ///<Of the var's literal on the trail, implies it
+            vector<uint32_t> depth; ///<Of the var's literal in the tree of ancestors
+            vector<char> red_step; ///<The var's literal was implied by a redundant step
+            vector<Lit> trail;
+            vector<Lit> first_trail;
+            vector<Lit> reasons; ///<True literals that make a clause propagate
+            Lit failed = lit_Undef;
+            uint64_t work = 0;
+        };
+        struct ProbeStep
+        {
+            Lit lit;
+            Lit ancestor;
+            bool red;
+        };
+        struct ProbeResult
+        {
+            Var var = var_Undef;
+            uint32_t numProbed = 0;
+            Lit failed = lit_Undef; ///<Literal that failed, its negation is a unit
+            vector<Lit> bothSame; ///<Implied by both polarities
+            vector<Lit> equivs; ///<Equivalent to the positive literal of the var
+            vector<BinaryClause> hyperBins;
+            vector<ProbeStep> steps[2]; ///<Trail of each polarity, for the cache
+        };
+        size_t probe_in_parallel(const vector<Var>& poss_choice, const uint64_t numPropsTodo);
+        void probe_var_in_context(ProbeContext& ctx, const Var var, ProbeResult& res);
+        bool propagate_in_context(ProbeContext& ctx, const Lit lit, ProbeResult& res);
+        void propagate_long_in_context(ProbeContext& ctx, const Lit p, const Watched& w, ProbeResult& res);
+        void imply_in_context(ProbeContext& ctx, const Lit lit, ProbeResult& res);
+        Lit common_ancestor_in_context(ProbeContext& ctx, Lit a, Lit b) const;
+        bool enqueue_in_context(ProbeContext& ctx, const Lit lit, const Lit ancestor, const bool red);
+        lbool value_in_context(const ProbeContext& ctx, const Lit lit) const;
+        bool false_in_context(const ProbeContext& ctx, const Lit lit) const;
+        void unassign_in_context(ProbeContext& ctx, const vector<Lit>& lits);
+        void save_steps_in_context(const ProbeContext& ctx, vector<ProbeStep>& steps) const;
+        bool commit_probe_results(const vector<ProbeResult>& results);
+        bool commit_steps(const vector<ProbeStep>& steps);
+
         //For hyper-bin resolution
         #ifdef DEBUG_REMOVE_USELESS_BIN
         void testBinRemoval(const Lit origLit);
@@ -265,6 +318,7 @@ class Prober {
         //Used to count extra time, must be cleared at every startup
         uint64_t extraTime;
         uint64_t extraTimeCache;
+        uint64_t parallelWork; ///<Of all threads of probe_in_parallel()
 
         //Stats
         Stats runStats;
@@ -32,19 +32,20 @@
 
 namespace CMSat {
 
-enum PropByType {null_clause_t = 0, clause_t = 1, binary_t = 2, tertiary_t = 3};
+enum PropByType {null_clause_t = 0, clause_t = 1, binary_t = 2, tertiary_t = 3, xor_t = 4};
 
 class PropBy
 {
     private:
         uint32_t red_step:1;
         uint32_t data1:31;
-        uint32_t type:2;
+        uint32_t type:3;
         //0: clause, NULL
         //1: clause, non-null
         //2: binary
         //3: tertiary
-        uint32_t data2:30;
+        //4: native xor
+        uint32_t data2:29;
 
     public:
         PropBy() :
@@ -106,6 +107,16 @@ class PropBy
         {
         }
 
+        //Reason is a native XOR, its index is in data1. The reason clause
+        //itself is only generated when conflict analysis asks for it
+        static PropBy xor_reason(const uint32_t xor_at)
+        {
+            PropBy pb;
+            pb.data1 = xor_at;
+            pb.type = xor_t;
+            return pb;
+        }
+
         bool isRedStep() const
         {
             return red_step;
@@ -175,6 +186,14 @@ class PropBy
             return data1;
         }
 
+        uint32_t get_xor_at() const
+        {
+            #ifdef DEBUG_PROPAGATEFROM
+            assert(type == xor_t);
+            #endif
+            return data1;
+        }
+
         bool isNULL() const
         {
             return type == null_clause_t;
@@ -210,6 +229,10 @@ inline std::ostream& operator<<(std::ostream& os, const PropBy& pb)
             os << " clause, num= " << pb.get_offset();
             break;
 
+        case xor_t :
+            os << " xor, num= " << pb.get_xor_at();
+            break;
+
         case null_clause_t :
             os << " NULL";
             break;
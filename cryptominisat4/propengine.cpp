@@ -62,6 +62,7 @@ PropEngine::~PropEngine()
 void PropEngine::new_var(const bool bva, Var orig_outer)
 {
     CNF::new_var(bva, orig_outer);
+    xor_watches.resize(nVars());
     //TODO
     //trail... update x->whatever
 }
@@ -69,6 +70,7 @@ void PropEngine::new_var(const bool bva, Var orig_outer)
 void PropEngine::new_vars(size_t n)
 {
     CNF::new_vars(n);
+    xor_watches.resize(nVars());
     //TODO
     //trail... update x->whatever
 }
@@ -76,6 +78,62 @@ void PropEngine::new_vars(size_t n)
 void PropEngine::save_on_var_memory()
 {
     CNF::save_on_var_memory();
+    xor_watches.resize(nVars());
+    xor_watches.shrink_to_fit();
+}
+
+void PropEngine::attach_native_xor(const uint32_t at)
+{
+    const Xor& x = native_xors[at];
+    assert(decisionLevel() == 0);
+    assert(x.vars.size() >= 2);
+    for(const Var var: x.vars) {
+        assert(value(var) == l_Undef);
+        varData[var].in_xor = true;
+    }
+    xor_watches[x.vars[0]].push_back(at);
+    xor_watches[x.vars[1]].push_back(at);
+}
+
+void PropEngine::attach_native_xors()
+{
+    for(vector<uint32_t>& ws: xor_watches) {
+        ws.clear();
+    }
+    for(VarData& dat: varData) {
+        dat.in_xor = false;
+    }
+    for(size_t i = 0; i < native_xors.size(); i++) {
+        attach_native_xor(i);
+    }
+}
+
+/**
+@brief Builds the clause that a native XOR implies under the current assignment
+
+It is a clause of the XOR's literals that are all FALSE, except for the
+propagated one (if any) which is TRUE and at position 0, just like with long
+clauses. The returned vector is only valid until the next call.
+*/
+const vector<Lit>& PropEngine::get_xor_reason(
+    const PropBy& reason
+    , const Var propagated
+) {
+    const Xor& x = native_xors[reason.get_xor_at()];
+    xor_reason.clear();
+    if (propagated != var_Undef) {
+        assert(value(propagated) != l_Undef);
+        xor_reason.push_back(Lit(propagated, value(propagated) == l_False));
+    }
+    for(const Var var: x.vars) {
+        if (var == propagated)
+            continue;
+
+        assert(value(var) != l_Undef);
+        xor_reason.push_back(Lit(var, value(var) == l_True));
+    }
+
+    return xor_reason;
 }
 
 
@@ -263,15 +321,17 @@ void PropEngine::update_glue(Clause& c)
         && conf.update_glues_on_prop
     ) {
         const uint32_t new_glue = calc_glue_using_seen2(c);
-        if (new_glue < c.stats.glue
-            && new_glue < conf.protect_clause_if_imrpoved_glue_below_this_glue_for_one_turn
-        ) {
-            if (red_long_cls_is_reducedb(c)) {
+        if (new_glue < c.stats.glue) {
+            const bool was_reducedb = red_long_cls_is_reducedb(c);
+            if (new_glue < conf.protect_clause_if_imrpoved_glue_below_this_glue_for_one_turn) {
+                c.stats.ttl = 1;
+            }
+            c.stats.glue = new_glue;
+            promote_to_mid_tier_if_needed(c);
+            if (was_reducedb && !red_long_cls_is_reducedb(c)) {
                 num_red_cls_reducedb--;
             }
-            c.stats.ttl = 1;
         }
-        c.stats.glue = std::min(c.stats.glue, new_glue);
     }
 }
 
@@ -320,7 +380,13 @@ PropResult PropEngine::prop_normal_helper(
             c.stats.visited_literals+= numLitVisited;
             #endif
             *k = ~p;
+            #ifdef WATCH_TWO_BLOCKERS
+            //Literals before k are all false, the ones after are not known
+            const Lit blocker2 = (k+1 != end2) ? *(k+1) : c[2];
+            watches[c[1].toInt()].push(Watched(offset, c[0], blocker2));
+            #else
             watches[c[1].toInt()].push(Watched(offset, c[0]));
+            #endif
             return PROP_NOTHING;
         }
     }
@@ -367,7 +433,7 @@ inline PropResult PropEngine::propNormalClause(
     , PropBy& confl
 ) {
     //Blocked literal is satisfied, so clause is satisfied
-    if (value(i->getBlockedLit()) == l_True) {
+    if (watch_blocked(*i)) {
         *j++ = *i;
         return PROP_NOTHING;
     }
@@ -413,7 +479,7 @@ bool PropEngine::propNormalClauseAnyOrder(
 ) {
     //Blocked literal is satisfied, so clause is satisfied
     const Lit blocker = i->getBlockedLit();
-    if (value(blocker) == l_True) {
+    if (watch_blocked(*i)) {
         *j++ = *i;
         return true;
     }
@@ -443,7 +509,11 @@ bool PropEngine::propNormalClauseAnyOrder(
     // If 0th watch is true, then clause is already satisfied.
     const Lit first = c[0];
     if (first != blocker && value(first) == l_True) {
+        #ifdef WATCH_TWO_BLOCKERS
+        *j = Watched(offset, first, blocker);
+        #else
         *j = Watched(offset, first);
+        #endif
         j++;
         return true;
     }
@@ -467,7 +537,12 @@ bool PropEngine::propNormalClauseAnyOrder(
             c.stats.visited_literals+= numLitVisited;
             #endif
             *k = ~p;
+            #ifdef WATCH_TWO_BLOCKERS
+            const Lit blocker2 = (k+1 != end2) ? *(k+1) : c[2];
+            watches[c[1].toInt()].push(Watched(offset, c[0], blocker2));
+            #else
             watches[c[1].toInt()].push(Watched(offset, c[0]));
+            #endif
             return true;
         }
     }
@@ -672,6 +747,74 @@ inline void PropEngine::propTriHelperAnyOrder(
     enqueue<update_bogoprops>(lit2, PropBy(~lit1, lit3, red));
 }
 
+/**
+@brief Visits the native XORs watched on the just-assigned var
+
+Moves the watch to another unassigned var if there is one. Otherwise the
+other watched var is the only one left: it is either propagated (its reason
+is generated lazily, see get_xor_reason()) or, if it is also set, the
+parity of the XOR is checked.
+*/
+template<bool update_bogoprops>
+bool PropEngine::prop_xors(const Var var, PropBy& confl)
+{
+    vector<uint32_t>& ws = xor_watches[var];
+    if (update_bogoprops) {
+        propStats.bogoProps += ws.size()/4 + 1;
+    }
+
+    size_t i = 0;
+    size_t j = 0;
+    for(const size_t end = ws.size(); i < end; i++) {
+        const uint32_t at = ws[i];
+        vector<Var>& vars = native_xors[at].vars;
+        if (vars[0] == var) {
+            std::swap(vars[0], vars[1]);
+        }
+        assert(vars[1] == var);
+
+        bool found = false;
+        for(size_t k = 2; k < vars.size(); k++) {
+            if (value(vars[k]) == l_Undef) {
+                std::swap(vars[1], vars[k]);
+                xor_watches[vars[1]].push_back(at);
+                found = true;
+                break;
+            }
+        }
+        if (found) {
+            continue;
+        }
+
+        //Every var but vars[0] is set, keep watching
+        ws[j++] = at;
+        bool rhs = native_xors[at].rhs;
+        for(size_t k = 1; k < vars.size(); k++) {
+            rhs ^= value(vars[k]) == l_True;
+        }
+
+        const lbool val = value(vars[0]);
+        if (val == l_Undef) {
+            enqueue<update_bogoprops>(
+                Lit(vars[0], !rhs)
+                , PropBy::xor_reason(at)
+            );
+        } else if ((val == l_True) != rhs) {
+            confl = PropBy::xor_reason(at);
+            lastConflictCausedBy = ConflCausedBy::xorcl;
+            qhead = trail.size();
+            i++;
+            break;
+        }
+    }
+    for(const size_t end = ws.size(); i < end; i++) {
+        ws[j++] = ws[i];
+    }
+    ws.resize(j);
+
+    return confl.isNULL();
+}
+
 template<bool update_bogoprops>
 PropBy PropEngine::propagateAnyOrder()
 {
@@ -749,6 +892,10 @@ PropBy PropEngine::propagateAnyOrder()
         }
         ws.shrink_(end-j);
 
+        if (confl.isNULL()) {
+            prop_xors<update_bogoprops>(p.var(), confl);
+        }
+
         qhead++;
     }
 
@@ -856,6 +1003,14 @@ void PropEngine::updateVars(
         if (!watches[i].empty())
             updateWatch(watches[i], outerToInter);
     }
+
+    //All vars in native XORs are unset, so they can simply be re-attached
+    for(Xor& x: native_xors) {
+        for(Var& var: x.vars) {
+            var = outerToInter[var];
+        }
+    }
+    attach_native_xors();
 }
 
 inline void PropEngine::updateWatch(
@@ -893,6 +1048,11 @@ inline void PropEngine::updateWatch(
             it->setBlockedLit(
                 getUpdatedLit(it->getBlockedLit(), outerToInter)
             );
+            #ifdef WATCH_TWO_BLOCKERS
+            it->setBlockedLit2(
+                getUpdatedLit(it->getBlockedLit2(), outerToInter)
+            );
+            #endif
         }
     }
 }
@@ -999,6 +1159,16 @@ PropBy PropEngine::propagateBinFirst(
             goto startAgain;
         }
 
+        //XORs last, they are the most expensive to visit
+        if (confl.isNULL()) {
+            const size_t trail_size_before = trail.size();
+            prop_xors<true>(p.var(), confl);
+            if (trail.size() != trail_size_before) {
+                qheadlong++;
+                goto startAgain;
+            }
+        }
+
         qheadlong++;
     }
 
@@ -1074,6 +1244,13 @@ bool PropEngine::propagate_occur()
                     return false;
             }
         }
+
+        //Native XORs are not in the occur lists
+        PropBy confl;
+        if (!prop_xors<true>(p.var(), confl)) {
+            ok = false;
+            return false;
+        }
     }
 
     return true;
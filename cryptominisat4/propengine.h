@@ -39,6 +39,7 @@
 #include "clause.h"
 #include "boundedqueue.h"
 #include "cnf.h"
+#include "xor.h"
 
 namespace CMSat {
 
@@ -127,6 +128,26 @@ protected:
         #endif
     );
     PropBy propagateIrredBin();  ///<For debug purposes, to test binary clause removal
+
+    //Native XORs, each watched on its first two variables
+    vector<Xor> native_xors;
+    vector<vector<uint32_t> > xor_watches; ///<var -> indexes into native_xors
+    void attach_native_xor(const uint32_t at);
+    void attach_native_xors();
+    const vector<Lit>& get_xor_reason(const PropBy& reason, const Var propagated);
+
+    ///Whether the long clause behind the watch is known to be satisfied
+    ///without dereferencing it
+    bool watch_blocked(const Watched& w) const
+    {
+        #ifdef WATCH_TWO_BLOCKERS
+        return value(w.getBlockedLit()) == l_True
+            || value(w.getBlockedLit2()) == l_True;
+        #else
+        return value(w.getBlockedLit()) == l_True;
+        #endif
+    }
+
     PropResult prop_normal_helper(
         Clause& c
         , ClOffset offset
@@ -203,6 +224,14 @@ protected:
         mem += trail.capacity()*sizeof(Lit);
         mem += trail_lim.capacity()*sizeof(uint32_t);
         mem += toClear.capacity()*sizeof(Lit);
+        mem += native_xors.capacity()*sizeof(Xor);
+        for(const Xor& x: native_xors) {
+            mem += x.vars.capacity()*sizeof(Var);
+        }
+        mem += xor_watches.capacity()*sizeof(vector<uint32_t>);
+        for(const vector<uint32_t>& ws: xor_watches) {
+            mem += ws.capacity()*sizeof(uint32_t);
+        }
         return mem;
     }
 
@@ -260,6 +289,11 @@ private:
         , const Lit p
         , PropBy& confl
     );
+
+    ///Propagate the native XORs watched on var
+    template<bool update_bogoprops>
+    bool prop_xors(const Var var, PropBy& confl);
+    vector<Lit> xor_reason;
 };
 
 
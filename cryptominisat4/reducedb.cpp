@@ -24,134 +24,28 @@
 #include "sqlstats.h"
 #include "clausecleaner.h"
 #include <functional>
+#include <algorithm>
+#include <cstring>
+#include <limits>
 
 using namespace CMSat;
 
-struct SortRedClsGlue
+//For non-negative doubles, the order of the bit patterns is that of the values
+static inline uint64_t ordered_bits(const double val)
 {
-    SortRedClsGlue(ClauseAllocator& _cl_alloc) :
-        cl_alloc(_cl_alloc)
-    {}
-    ClauseAllocator& cl_alloc;
-
-    bool operator () (const ClOffset xOff, const ClOffset yOff) const
-    {
-        const Clause* x = cl_alloc.ptr(xOff);
-        const Clause* y = cl_alloc.ptr(yOff);
-        return x->stats.glue < y->stats.glue;
-    }
-};
-
-struct SortRedClsSize
-{
-    SortRedClsSize(ClauseAllocator& _cl_alloc) :
-        cl_alloc(_cl_alloc)
-    {}
-    ClauseAllocator& cl_alloc;
-
-    bool operator () (const ClOffset xOff, const ClOffset yOff) const
-    {
-        const Clause* x = cl_alloc.ptr(xOff);
-        const Clause* y = cl_alloc.ptr(yOff);
-        return x->size() < y->size();
-    }
-};
-
-struct SortRedClsAct
-{
-    SortRedClsAct(ClauseAllocator& _cl_alloc) :
-        cl_alloc(_cl_alloc)
-    {}
-    ClauseAllocator& cl_alloc;
-
-    bool operator () (const ClOffset xOff, const ClOffset yOff) const
-    {
-        const Clause* x = cl_alloc.ptr(xOff);
-        const Clause* y = cl_alloc.ptr(yOff);
-        return x->stats.activity > y->stats.activity;
-    }
-};
+    assert(val >= 0);
+    uint64_t bits;
+    memcpy(&bits, &val, sizeof(bits));
+    return bits;
+}
 
 #ifdef STATS_NEEDED
-struct SortRedClsPropConfl
-{
-    SortRedClsPropConfl(
-        ClauseAllocator& _cl_alloc
-        , double _confl_weight
-        , double _prop_weight
-    ) :
-        cl_alloc(_cl_alloc)
-        , confl_weight(_confl_weight)
-        , prop_weight(_prop_weight)
-    {}
-    ClauseAllocator& cl_alloc;
-    double confl_weight;
-    double prop_weight;
-
-    bool operator () (const ClOffset xOff, const ClOffset yOff) const
-    {
-        const Clause* x = cl_alloc.ptr(xOff);
-        const Clause* y = cl_alloc.ptr(yOff);
-
-        const uint32_t xsize = x->size();
-        const uint32_t ysize = y->size();
-
-        //No clause should be less than 3-long: 2&3-long are not removed
-        assert(xsize > 2 && ysize > 2);
-
-        const double x_useful = x->stats.weighted_prop_and_confl(prop_weight, confl_weight);
-        const double y_useful = y->stats.weighted_prop_and_confl(prop_weight, confl_weight);
-        if (x_useful != y_useful) {
-            return x_useful > y_useful;
-        }
-
-        //Second tie: UIP usage
-        if (x->stats.used_for_uip_creation != y->stats.used_for_uip_creation) {
-            return x->stats.used_for_uip_creation > y->stats.used_for_uip_creation;
-        }
-
-        return x->size() < y->size();
-    }
-};
-
-struct SortRedClsConflDepth
+//Ties are broken by more UIP usage first, then by shorter size
+static inline uint32_t uip_and_size_tie(const Clause* cl)
 {
-    SortRedClsConflDepth(ClauseAllocator& _cl_alloc) :
-        cl_alloc(_cl_alloc)
-    {}
-    ClauseAllocator& cl_alloc;
-
-    bool operator () (const ClOffset xOff, const ClOffset yOff) const
-    {
-        const Clause* x = cl_alloc.ptr(xOff);
-        const Clause* y = cl_alloc.ptr(yOff);
-
-        const uint32_t xsize = x->size();
-        const uint32_t ysize = y->size();
-
-        //No clause should be less than 3-long: 2&3-long are not removed
-        assert(xsize > 2 && ysize > 2);
-
-        if (x->stats.weighted_prop_and_confl(1.0, 1.0) == 0 && y->stats.weighted_prop_and_confl(1.0, 1.0) == 0)
-            return false;
-
-        if (y->stats.weighted_prop_and_confl(1.0, 1.0) == 0)
-            return true;
-        if (x->stats.weighted_prop_and_confl(1.0, 1.0) == 0)
-            return false;
-
-        const double x_useful = x->stats.calc_usefulness_depth();
-        const double y_useful = y->stats.calc_usefulness_depth();
-        if (x_useful != y_useful)
-            return x_useful > y_useful;
-
-        //Second tie: UIP usage
-        if (x->stats.used_for_uip_creation != y->stats.used_for_uip_creation)
-            return x->stats.used_for_uip_creation > y->stats.used_for_uip_creation;
-
-        return x->size() < y->size();
-    }
-};
+    return ((63U - cl->stats.used_for_uip_creation) << 26)
+        | std::min<uint32_t>(cl->size(), (1U << 26) - 1);
+}
 #endif
 
 ReduceDB::ReduceDB(Solver* _solver) :
@@ -159,63 +53,108 @@ ReduceDB::ReduceDB(Solver* _solver) :
 {
 }
 
-void ReduceDB::sort_red_cls(ClauseCleaningTypes clean_type)
-{
+uint32_t ReduceDB::calc_tie(
+    const Clause* cl
+    , const ClauseCleaningTypes clean_type
+) const {
+    #ifdef STATS_NEEDED
+    if (clean_type == ClauseCleaningTypes::clean_sum_prop_confl_based
+        || clean_type == ClauseCleaningTypes::clean_sum_confl_depth_based
+    ) {
+        return uip_and_size_tie(cl);
+    }
+    #else
+    (void)cl;
+    (void)clean_type;
+    #endif
+
+    return 0;
+}
+
+uint64_t ReduceDB::calc_key(
+    const Clause* cl
+    , const ClauseCleaningTypes clean_type
+) const {
     switch (clean_type) {
-        case ClauseCleaningTypes::clean_glue_based : {
-            std::sort(solver->longRedCls.begin(), solver->longRedCls.end(), SortRedClsGlue(solver->cl_alloc));
-            break;
-        }
+        case ClauseCleaningTypes::clean_glue_based :
+            return cl->stats.glue;
 
-        case ClauseCleaningTypes::clean_size_based : {
-            std::sort(solver->longRedCls.begin(), solver->longRedCls.end(), SortRedClsSize(solver->cl_alloc));
-            break;
-        }
+        case ClauseCleaningTypes::clean_size_based :
+            return cl->size();
 
-        case ClauseCleaningTypes::clean_sum_activity_based : {
-            std::sort(solver->longRedCls.begin(), solver->longRedCls.end(), SortRedClsAct(solver->cl_alloc));
-            break;
-        }
+        case ClauseCleaningTypes::clean_sum_activity_based :
+            return ~ordered_bits(cl->stats.activity);
 
         #ifdef STATS_NEEDED
         case ClauseCleaningTypes::clean_sum_prop_confl_based : {
-            std::sort(solver->longRedCls.begin()
-                , solver->longRedCls.end()
-                , SortRedClsPropConfl(solver->cl_alloc
-                    , solver->conf.clean_confl_multiplier
-                    , solver->conf.clean_prop_multiplier
-                )
+            const double useful = cl->stats.weighted_prop_and_confl(
+                solver->conf.clean_prop_multiplier
+                , solver->conf.clean_confl_multiplier
             );
-            break;
+            return ~ordered_bits(useful);
         }
 
         case ClauseCleaningTypes::clean_sum_confl_depth_based : {
-            std::sort(solver->longRedCls.begin(), solver->longRedCls.end(), SortRedClsConflDepth(solver->cl_alloc));
-            break;
+            //Clauses that never did anything go last
+            if (cl->stats.weighted_prop_and_confl(1.0, 1.0) == 0) {
+                return std::numeric_limits<uint64_t>::max();
+            }
+            const double useful = cl->stats.calc_usefulness_depth();
+            return ~ordered_bits(useful);
         }
         #endif
 
         default: {
             cout << "Unknown cleaning type: " << clean_type << endl;
             assert(false);
+            std::exit(-1);
+        }
+    }
+}
+
+/**
+@brief Scores the clauses that can still be marked for keeping
+
+Each clause is looked at exactly once, the ordering then only touches the
+(key, offset) array. The comparator-based sort used to dereference two
+clauses per comparison.
+*/
+void ReduceDB::calc_red_cl_keys(
+    const ClauseCleaningTypes clean_type
+    , CleaningStats& tmpStats
+) {
+    red_cl_keys.clear();
+    for(const ClOffset offset: solver->longRedCls) {
+        const Clause* cl = solver->cl_alloc.ptr(offset);
+        tmpStats.clause_lookups++;
+
+        //All other clauses that must be kept are in never_cleaned
+        if (!cl->stats.marked_clause) {
+            red_cl_keys.push_back(RedClKey(
+                calc_key(cl, clean_type)
+                , calc_tie(cl, clean_type)
+                , offset
+            ));
         }
     }
 }
 
-void ReduceDB::print_best_red_clauses_if_required() const
+void ReduceDB::print_best_red_clauses_if_required()
 {
-    if (solver->longRedCls.empty()
+    if (red_cl_keys.empty()
         || solver->conf.doPrintBestRedClauses == 0
     ) {
         return;
     }
 
+    //Only printing needs a full order
+    std::sort(red_cl_keys.begin(), red_cl_keys.end());
     size_t at = 0;
-    for(long i = ((long)solver->longRedCls.size())-1
-        ; i > ((long)solver->longRedCls.size())-1-solver->conf.doPrintBestRedClauses && i >= 0
+    for(long i = ((long)red_cl_keys.size())-1
+        ; i > ((long)red_cl_keys.size())-1-solver->conf.doPrintBestRedClauses && i >= 0
         ; i--
     ) {
-        ClOffset offset = solver->longRedCls[i];
+        ClOffset offset = red_cl_keys[i].offset;
         const Clause* cl = solver->cl_alloc.ptr(offset);
         cout
         << "c [best-red-cl] Red " << nbReduceDB
@@ -238,7 +177,9 @@ CleaningStats ReduceDB::reduceDB(bool lock_clauses_in)
     const uint64_t sumConfl = solver->sumConflicts();
 
     if (lock_clauses_in) {
-        lock_most_UIP_used_clauses();
+        const double sortTime = cpuTime();
+        lock_most_UIP_used_clauses(tmpStats);
+        tmpStats.sort_time += cpuTime() - sortTime;
     }
 
     move_to_never_cleaned();
@@ -249,15 +190,18 @@ CleaningStats ReduceDB::reduceDB(bool lock_clauses_in)
         if (keep_num == 0) {
             continue;
         }
-        sort_red_cls(static_cast<ClauseCleaningTypes>(keep_type));
+        const double sortTime = cpuTime();
+        calc_red_cl_keys(static_cast<ClauseCleaningTypes>(keep_type), tmpStats);
         print_best_red_clauses_if_required();
         mark_top_N_clauses(keep_num);
+        tmpStats.sort_time += cpuTime() - sortTime;
     }
     move_from_never_cleaned();
     assert(delayed_clause_free.empty());
     cl_locked = 0;
     cl_marked = 0;
     cl_glue = 0;
+    cl_mid = 0;
     cl_ttl = 0;
     cl_locked_solver = 0;
     remove_cl_from_array_and_count_stats(tmpStats, sumConfl);
@@ -265,6 +209,7 @@ CleaningStats ReduceDB::reduceDB(bool lock_clauses_in)
         cout << "c [DBclean] locked:" << cl_locked
         << " marked: " << cl_marked
         << " glue: " << cl_glue
+        << " mid: " << cl_mid
         << " ttl:" << cl_ttl
         << " locked_solver:" << cl_locked_solver
         << endl;
@@ -328,66 +273,60 @@ void ReduceDB::move_from_never_cleaned()
     never_cleaned.clear();
 }
 
+//The keep_num best clauses are put to the front of red_cl_keys, in no order
 void ReduceDB::mark_top_N_clauses(const uint64_t keep_num)
 {
-    size_t marked = 0;
-    for(size_t i = 0
-        ; i < solver->longRedCls.size() && marked < keep_num
-        ; i++
-    ) {
-        const ClOffset offset = solver->longRedCls[i];
-        Clause* cl = solver->cl_alloc.ptr(offset);
-        if ( cl->stats.locked
-            || cl->stats.marked_clause
-            || cl->stats.glue <= solver->conf.glue_must_keep_clause_if_below_or_eq
-            || cl->stats.ttl > 0
-            || solver->clause_locked(*cl, offset)
-        ) {
-            //no need to mark, skip
-            continue;
-        }
+    if (keep_num < red_cl_keys.size()) {
+        std::nth_element(
+            red_cl_keys.begin()
+            , red_cl_keys.begin() + keep_num
+            , red_cl_keys.end()
+        );
+    }
 
-        if (!cl->stats.marked_clause) {
-            marked++;
-            cl->stats.marked_clause = true;
-        }
+    const size_t marked = std::min<size_t>(keep_num, red_cl_keys.size());
+    for(size_t i = 0; i < marked; i++) {
+        Clause* cl = solver->cl_alloc.ptr(red_cl_keys[i].offset);
+        assert(!cl->stats.marked_clause);
+        cl->stats.marked_clause = true;
     }
 }
 
-void ReduceDB::lock_most_UIP_used_clauses()
+void ReduceDB::lock_most_UIP_used_clauses(CleaningStats& tmpStats)
 {
     if (solver->conf.lock_uip_per_dbclean == 0)
         return;
 
-    std::function<bool (const ClOffset, const ClOffset)> uipsort
-        = [&] (const ClOffset a, const ClOffset b) -> bool {
-            const Clause& a_cl = *solver->cl_alloc.ptr(a);
-            const Clause& b_cl = *solver->cl_alloc.ptr(b);
-
-            return a_cl.stats.used_for_uip_creation > b_cl.stats.used_for_uip_creation;
-    };
-    std::sort(solver->longRedCls.begin(), solver->longRedCls.end(), uipsort);
-
-    size_t locked = 0;
+    //Most UIP usage first
+    red_cl_keys.clear();
     size_t skipped = 0;
-    for(size_t i = 0
-        ; i < solver->longRedCls.size() && locked < solver->conf.lock_uip_per_dbclean
-        ; i++
-    ) {
-        const ClOffset offs = solver->longRedCls[i];
-        Clause& cl = *solver->cl_alloc.ptr(offs);
+    for(const ClOffset offs: solver->longRedCls) {
+        const Clause& cl = *solver->cl_alloc.ptr(offs);
+        tmpStats.clause_lookups++;
         if (!cl.stats.locked
             && cl.stats.glue > solver->conf.glue_must_keep_clause_if_below_or_eq
         ) {
-            cl.stats.locked = true;
-            locked++;
-            //std::cout << "Locked: " << cl << endl;
+            red_cl_keys.push_back(RedClKey(63U - cl.stats.used_for_uip_creation, 0, offs));
         } else {
             skipped++;
-            //std::cout << "skipped: " << cl << endl;
         }
     }
 
+    const size_t locked = std::min<size_t>(
+        solver->conf.lock_uip_per_dbclean
+        , red_cl_keys.size()
+    );
+    if (locked < red_cl_keys.size()) {
+        std::nth_element(
+            red_cl_keys.begin()
+            , red_cl_keys.begin() + locked
+            , red_cl_keys.end()
+        );
+    }
+    for(size_t i = 0; i < locked; i++) {
+        solver->cl_alloc.ptr(red_cl_keys[i].offset)->stats.locked = true;
+    }
+
     if (solver->conf.verbosity >= 2) {
         cout << "c [DBclean] UIP"
         << " Locked: " << locked << " skipped: " << skipped << endl;
@@ -412,7 +351,7 @@ bool ReduceDB::cl_needs_removal(const Clause* cl, const ClOffset offset) const
         #endif
          && !cl->stats.marked_clause
          && cl->stats.ttl == 0
-         && cl->stats.glue > solver->conf.glue_must_keep_clause_if_below_or_eq
+         && solver->red_tier(*cl) == red_tier_local
          && !solver->clause_locked(*cl, offset);
 }
 
@@ -437,6 +376,8 @@ void ReduceDB::remove_cl_from_array_and_count_stats(
             cl_ttl++;
         } else if (cl->stats.glue <= solver->conf.glue_must_keep_clause_if_below_or_eq) {
             cl_glue++;
+        } else if (cl->stats.mid_tier) {
+            cl_mid++;
         } else if (solver->clause_locked(*cl, offset)) {
             cl_locked_solver++;
         }
@@ -447,6 +388,7 @@ void ReduceDB::remove_cl_from_array_and_count_stats(
             }
             solver->longRedCls[j++] = offset;
             tmpStats.remain.incorporate(cl);
+            tmpStats.remain_in_tier[solver->red_tier(*cl)]++;
             #ifdef STATS_NEEDED
             tmpStats.remain.age += sumConfl - cl->stats.introduced_at_conflict;
             #endif
@@ -469,6 +411,46 @@ void ReduceDB::remove_cl_from_array_and_count_stats(
     solver->longRedCls.resize(solver->longRedCls.size() - (i - j));
 }
 
+/**
+@brief Moves the mid tier clauses that were not used lately to the local tier
+
+Clauses only ever come back to the mid tier if their glue improves.
+*/
+void ReduceDB::demote_unused_mid_tier_clauses()
+{
+    const double myTime = cpuTime();
+    const uint32_t now = solver->sumConflicts();
+    size_t demoted = 0;
+    size_t remain = 0;
+    for(const ClOffset offset: solver->longRedCls) {
+        Clause* cl = solver->cl_alloc.ptr(offset);
+        if (solver->red_tier(*cl) != red_tier_mid) {
+            continue;
+        }
+
+        //Unsigned difference, survives the wrap-around of last_touched
+        if (now - cl->stats.last_touched >= solver->conf.every_mid_tier_reduce) {
+            cl->stats.mid_tier = false;
+            demoted++;
+        } else {
+            remain++;
+        }
+    }
+    next_mid_tier_reduce = solver->sumConflicts() + solver->conf.every_mid_tier_reduce;
+
+    const double time_used = cpuTime() - myTime;
+    cleaningStats.mid_tier_reduces++;
+    cleaningStats.mid_tier_demoted += demoted;
+    cleaningStats.mid_tier_time += time_used;
+    if (solver->conf.verbosity >= 2) {
+        cout
+        << "c [DBclean mid] demoted: " << demoted
+        << " remain: " << remain
+        << solver->conf.print_times(time_used)
+        << endl;
+    }
+}
+
 void ReduceDB::reduce_db_and_update_reset_stats(bool lock_clauses_in)
 {
     ClauseUsageStats irred_cl_usage_stats = sumClauseData(solver->longIrredCls, false);
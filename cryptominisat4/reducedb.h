@@ -37,6 +37,11 @@ public:
     ReduceDB(Solver* solver);
     void reduce_db_and_update_reset_stats(bool lock_clauses_in = true);
     const CleaningStats& get_cleaning_stats() const;
+    void demote_unused_mid_tier_clauses();
+    uint64_t get_next_mid_tier_reduce() const
+    {
+        return next_mid_tier_reduce;
+    }
 
     uint64_t get_nbReduceDB() const
     {
@@ -46,6 +51,7 @@ public:
 private:
     Solver* solver;
     uint64_t nbReduceDB = 0;
+    uint64_t next_mid_tier_reduce = 0;
     vector<ClOffset> delayed_clause_free;
     CleaningStats cleaningStats;
 
@@ -57,6 +63,7 @@ private:
     unsigned cl_marked;
     unsigned cl_ttl;
     unsigned cl_glue;
+    unsigned cl_mid;
     unsigned cl_locked_solver;
 
     size_t last_reducedb_num_conflicts = 0;
@@ -70,11 +77,38 @@ private:
     );
 
     CleaningStats reduceDB(bool lock_clauses_in);
-    void lock_most_UIP_used_clauses();
+    void lock_most_UIP_used_clauses(CleaningStats& tmpStats);
 
-    void sort_red_cls(ClauseCleaningTypes clean_type);
+    ///Sort key of a redundant clause, smaller is better
+    struct RedClKey
+    {
+        RedClKey(const uint64_t _key, const uint32_t _tie, const ClOffset _offset) :
+            key(_key)
+            , tie(_tie)
+            , offset(_offset)
+        {}
+
+        bool operator<(const RedClKey& other) const
+        {
+            if (key != other.key) {
+                return key < other.key;
+            }
+            return tie < other.tie;
+        }
+
+        uint64_t key;
+        uint32_t tie; ///<Decides between equal keys
+        ClOffset offset;
+    };
+    vector<RedClKey> red_cl_keys;
+    uint64_t calc_key(const Clause* cl, const ClauseCleaningTypes clean_type) const;
+    uint32_t calc_tie(const Clause* cl, const ClauseCleaningTypes clean_type) const;
+    void calc_red_cl_keys(
+        const ClauseCleaningTypes clean_type
+        , CleaningStats& tmpStats
+    );
     void mark_top_N_clauses(const uint64_t keep_num);
-    void print_best_red_clauses_if_required() const;
+    void print_best_red_clauses_if_required();
     ClauseUsageStats sumClauseData(
         const vector<ClOffset>& toprint
         , bool red
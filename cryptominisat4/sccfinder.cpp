@@ -99,14 +99,14 @@ void SCCFinder::tarjan(const uint32_t vertex)
     if (solver->varData[vertexVar].removed == Removed::none) {
         Lit vertLit = Lit::toLit(vertex);
 
-        vector<LitExtra>* transCache = NULL;
+        TransCache transCache(NULL, 0);
 
         if (solver->conf.doCache
             && solver->conf.doExtendedSCC
             && (!solver->drup->enabled() || solver->conf.otfHyperbin)
         ) {
-            transCache = &(solver->implCache[(~vertLit).toInt()].lits);
-            __builtin_prefetch(transCache->data());
+            transCache = solver->implCache[(~vertLit).toInt()];
+            __builtin_prefetch(transCache.begin());
         }
 
         //Go through the watch
@@ -128,10 +128,10 @@ void SCCFinder::tarjan(const uint32_t vertex)
             doit(lit, vertex);
         }
 
-        if (transCache) {
-            runStats.bogoprops += transCache->size()/4;
-            for (vector<LitExtra>::iterator
-                it = transCache->begin(), end = transCache->end()
+        if (!transCache.empty()) {
+            runStats.bogoprops += transCache.size()/4;
+            for (const LitExtra
+                *it = transCache.begin(), *end = transCache.end()
                 ; it != end
                 ; ++it
             ) {
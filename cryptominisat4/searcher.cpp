@@ -33,6 +33,8 @@
 #include "sqlstats.h"
 #include "datasync.h"
 #include "reducedb.h"
+#include "gaussian.h"
+#include "matrixfinder.h"
 //#define DEBUG_RESOLV
 
 using namespace CMSat;
@@ -65,6 +67,7 @@ Searcher::Searcher(const SolverConf *_conf, Solver* _solver, bool* _needToInterr
 {
     var_decay = conf.var_decay_start;
     var_inc = conf.var_inc_start;
+    chb_step = conf.chb_step_start;
     more_red_minim_limit_binary_actual = conf.more_red_minim_limit_binary;
     more_red_minim_limit_cache_actual = conf.more_red_minim_limit_cache;
     mtrand.seed(conf.origSeed);
@@ -81,6 +84,11 @@ void Searcher::new_var(const bool bva, const Var orig_outer)
 
     //Activity heap
     activities.push_back(0);
+    if (conf.branch_strategy == branch_vmtf) {
+        vmtf_queue.new_var();
+    } else if (conf.branch_strategy == branch_chb) {
+        chb_last_conflict.push_back(0);
+    }
     solver->set_decision_var(nVars()-1);
 }
 
@@ -88,6 +96,13 @@ void Searcher::new_vars(size_t n)
 {
     PropEngine::new_vars(n);
     activities.resize(activities.size() + n, 0);
+    if (conf.branch_strategy == branch_vmtf) {
+        for(size_t i = 0; i < n; i++) {
+            vmtf_queue.new_var();
+        }
+    } else if (conf.branch_strategy == branch_chb) {
+        chb_last_conflict.resize(chb_last_conflict.size() + n, 0);
+    }
     for(int i = n-1; i >= 0; i--) {
         insertVarOrder((int)nVars()-i-1);
     }
@@ -98,6 +113,12 @@ void Searcher::save_on_var_memory()
     PropEngine::save_on_var_memory();
     activities.resize(nVars());
     activities.shrink_to_fit();
+    if (conf.branch_strategy == branch_vmtf) {
+        vmtf_queue.shrink(nVars());
+    } else if (conf.branch_strategy == branch_chb) {
+        chb_last_conflict.resize(nVars());
+        chb_last_conflict.shrink_to_fit();
+    }
 }
 
 void Searcher::updateVars(
@@ -106,6 +127,17 @@ void Searcher::updateVars(
 ) {
     updateArray(activities, interToOuter);
     //activities are not updated, they are taken from backup, which is updated
+    if (conf.branch_strategy == branch_vmtf) {
+        //Re-linked at the start of search
+        vmtf_queue.update_vars(interToOuter);
+    } else if (conf.branch_strategy == branch_chb) {
+        updateArray(chb_last_conflict, interToOuter);
+    }
+
+    //The heap is rebuilt at the start of search, but new_var() may insert
+    //into it before that, and its old entries may be past the end of
+    //the (possibly shrunk) activities
+    order_heap.clear();
 
     renumber_assumptions(outerToInter);
 
@@ -287,6 +319,7 @@ void Searcher::normalClMinim()
         const PropBy& reason = varData[learnt_clause[i].var()].reason;
         size_t size;
         Clause* cl = NULL;
+        const vector<Lit>* xor_cl = NULL;
         PropByType type = reason.getType();
         if (type == null_clause_t) {
             learnt_clause[j++] = learnt_clause[i];
@@ -299,6 +332,11 @@ void Searcher::normalClMinim()
                 size = cl->size()-1;
                 break;
 
+            case xor_t:
+                xor_cl = &get_xor_reason(reason, learnt_clause[i].var());
+                size = xor_cl->size()-1;
+                break;
+
             case binary_t:
                 size = 1;
                 break;
@@ -321,6 +359,10 @@ void Searcher::normalClMinim()
                     p = (*cl)[k+1];
                     break;
 
+                case xor_t:
+                    p = (*xor_cl)[k+1];
+                    break;
+
                 case binary_t:
                     p = reason.lit2();
                     break;
@@ -371,6 +413,11 @@ void Searcher::debug_print_resolving_clause(const PropBy confl) const
             break;
         }
 
+        case xor_t: {
+            cout << "resolv (xor): " << native_xors[confl.get_xor_at()] << endl;
+            break;
+        }
+
         case null_clause_t: {
             assert(false);
             break;
@@ -391,17 +438,16 @@ void Searcher::update_clause_glue_from_analysis(Clause* cl)
         //tot_lbds = tot_lbds - c.lbd() + lbd;
         //c.delta_lbd(c.delta_lbd() + c.lbd() - lbd);
 
-        if (new_glue <= conf.glue_must_keep_clause_if_below_or_eq && red_long_cls_is_reducedb(*cl)) {
-            num_red_cls_reducedb--;
-        }
+        const bool was_reducedb = red_long_cls_is_reducedb(*cl);
         cl->stats.glue = new_glue;
+        promote_to_mid_tier_if_needed(*cl);
 
         if (new_glue <= conf.protect_clause_if_imrpoved_glue_below_this_glue_for_one_turn) {
-            if (red_long_cls_is_reducedb(*cl)) {
-                num_red_cls_reducedb--;
-            }
             cl->stats.ttl = 1;
         }
+        if (was_reducedb && !red_long_cls_is_reducedb(*cl)) {
+            num_red_cls_reducedb--;
+        }
     }
 }
 
@@ -423,6 +469,13 @@ Clause* Searcher::add_literals_from_confl_to_learnt(
             }
 
             add_lit_to_learnt(confl.lit2());
+            if (confl.isRedStep()) {
+                solver->datasync->signalTriClauseUsed(
+                    p == lit_Undef ? failBinLit : p
+                    , confl.lit2()
+                    , confl.lit3()
+                );
+            }
             break;
         }
 
@@ -441,11 +494,16 @@ Clause* Searcher::add_literals_from_confl_to_learnt(
             if (cl->red()) {
                 resolutions.redL++;
                 stats.resolvs.redL++;
+                cl->stats.last_touched = sumConflicts();
             } else {
                 resolutions.irredL++;
                 stats.resolvs.irredL++;
             }
             cl->stats.used_for_uip_creation++;
+            if (cl->imported()) {
+                cl->set_imported(false);
+                solver->datasync->signalImportedClauseUsed();
+            }
             if (cl->red() && update_polarity_and_activity) {
                 bumpClauseAct(cl);
                 if (conf.update_glues_on_analyze) {
@@ -461,6 +519,24 @@ Clause* Searcher::add_literals_from_confl_to_learnt(
 
                 add_lit_to_learnt((*cl)[j]);
             }
+
+            //Temporary clause of Gaussian elimination, cannot be OTF subsumed
+            if (cl->gauss_temp_cl()) {
+                cl = NULL;
+            }
+            break;
+        }
+
+        case xor_t : {
+            resolutions.irredL++;
+            stats.resolvs.irredL++;
+            const vector<Lit>& xor_cl = get_xor_reason(
+                confl
+                , p == lit_Undef ? var_Undef : p.var()
+            );
+            for (size_t j = (p == lit_Undef ? 0 : 1); j < xor_cl.size(); j++) {
+                add_lit_to_learnt(xor_cl[j]);
+            }
             break;
         }
 
@@ -568,8 +644,11 @@ inline Clause* Searcher::create_learnt_clause(PropBy confl)
 
         last_resolved_long_cl = add_literals_from_confl_to_learnt(confl, p);
 
-        // Select next implication to look at
-        while (!seen[trail[index--].var()]);
+        // Select next implication to look at. After chronological
+        // backtracking, lower level literals may follow it on the trail
+        do {
+            while (!seen[trail[index--].var()]);
+        } while (varData[trail[index+1].var()].level < decisionLevel());
 
         p = trail[index+1];
         assert(p != lit_Undef);
@@ -707,7 +786,8 @@ bool Searcher::litRedundant(const Lit p, uint32_t abstract_levels)
         cout << "At point in litRedundant: " << analyze_stack.top() << endl;
         #endif
 
-        const PropBy reason = varData[analyze_stack.top().var()].reason;
+        const Var top_var = analyze_stack.top().var();
+        const PropBy reason = varData[top_var].reason;
         PropByType type = reason.getType();
         analyze_stack.pop();
 
@@ -716,12 +796,18 @@ bool Searcher::litRedundant(const Lit p, uint32_t abstract_levels)
 
         size_t size;
         Clause* cl = NULL;
+        const vector<Lit>* xor_cl = NULL;
         switch (type) {
             case clause_t:
                 cl = cl_alloc.ptr(reason.get_offset());
                 size = cl->size()-1;
                 break;
 
+            case xor_t:
+                xor_cl = &get_xor_reason(reason, top_var);
+                size = xor_cl->size()-1;
+                break;
+
             case binary_t:
                 size = 1;
                 break;
@@ -748,6 +834,10 @@ bool Searcher::litRedundant(const Lit p, uint32_t abstract_levels)
                     p2 = (*cl)[i+1];
                     break;
 
+                case xor_t:
+                    p2 = (*xor_cl)[i+1];
+                    break;
+
                 case binary_t:
                     p2 = reason.lit2();
                     break;
@@ -818,7 +908,10 @@ void Searcher::analyze_final_confl_with_assumptions(const Lit p, vector<Lit>& ou
     out_conflict.clear();
     out_conflict.push_back(p);
 
-    if (decisionLevel() == 0) {
+    //Set at level 0, the var may have been renumbered beyond nVars() already
+    if (decisionLevel() == 0
+        || varData[p.var()].level == 0
+    ) {
         return;
     }
 
@@ -859,6 +952,15 @@ void Searcher::analyze_final_confl_with_assumptions(const Lit p, vector<Lit>& ou
                         break;
                     }
 
+                    case PropByType::xor_t: {
+                        for(const Lit lit: get_xor_reason(reason, x)) {
+                            if (varData[lit.var()].level > 0) {
+                                seen[lit.var()] = 1;
+                            }
+                        }
+                        break;
+                    }
+
                     default:
                         assert(false);
                         break;
@@ -954,8 +1056,9 @@ void Searcher::hyper_bin_update_cache(vector<Lit>& to_enqueue_toplevel)
             const bool redStep = varData[thisLit.var()].reason.isRedStep();
 
             assert(ancestor != lit_Undef);
-            bool taut = solver->implCache[(~ancestor).toInt()].merge(
-                solver->implCache[(~thisLit).toInt()].lits
+            bool taut = solver->implCache.merge(
+                ~ancestor
+                , ~thisLit
                 , thisLit
                 , redStep
                 , ancestor.var()
@@ -1068,6 +1171,7 @@ lbool Searcher::search()
     //Loop until restart or finish (SAT/UNSAT)
     last_decision_ended_in_conflict = false;
     blocked_restart = false;
+    trail_reuse_in_row = 0;
     PropBy confl;
 
     while (
@@ -1078,6 +1182,7 @@ lbool Searcher::search()
     ) {
         if (!confl.isNULL()) {
             if (((stats.conflStats.numConflicts % 5000) == 0)
+                && conf.branch_strategy == branch_vsids
                 && var_decay < conf.var_decay_max
             ) {
                 var_decay += 0.01;
@@ -1104,19 +1209,36 @@ lbool Searcher::search()
             reduce_db_if_needed();
             check_need_restart();
             last_decision_ended_in_conflict = false;
-            const lbool ret = new_decision();
-            if (ret != l_Undef) {
-                dump_search_sql(myTime);
-                return ret;
+            if (params.needToStopSearch
+                && restart_reusing_trail()
+            ) {
+                //Restarted in place, propagate what was kept, if needed
+            } else {
+                const lbool ret = new_decision();
+                if (ret != l_Undef) {
+                    dump_search_sql(myTime);
+                    return ret;
+                }
             }
         }
 
         //Decision level is higher than 1, so must do normal propagation
+        const size_t trail_at = qhead;
         confl = propagate<false>(
             #ifdef STATS_NEEDED
             &hist.watchListSizeTraversed
             #endif
         );
+        if (confl.isNULL()
+            && !gauss_matrixes.empty()
+            && !find_truths_gauss(confl)
+        ) {
+            dump_search_sql(myTime);
+            return l_False;
+        }
+        if (conf.branch_strategy == branch_chb) {
+            chb_update_after_propagation(trail_at, !confl.isNULL());
+        }
     }
 
     cancelUntil(0);
@@ -1201,13 +1323,12 @@ void Searcher::check_need_restart()
         if (conf.verbosity >= 3)
             cout << "c must_interrupt_asap() is set, restartig as soon as possible!" << endl;
         params.needToStopSearch = true;
+        params.mustLeaveSearch = true;
     }
 
-    if ((stats.conflStats.numConflicts & 0xff) == 0xff) {
-        //It's expensive to check time all the time
-        if (cpuTime() > conf.maxTime) {
-            params.needToStopSearch = true;
-        }
+    if (out_of_time()) {
+        params.needToStopSearch = true;
+        params.mustLeaveSearch = true;
     }
 
     switch (params.rest_type) {
@@ -1282,7 +1403,93 @@ void Searcher::check_need_restart()
             << "c Over limit of conflicts for this restart"
             << " -- restarting as soon as possible!" << endl;
         params.needToStopSearch = true;
+        params.mustLeaveSearch = true;
+    }
+}
+
+/**
+@brief Restarts without leaving search(), keeping the decision levels that
+would be made again anyway
+
+As per van der Tak, Ramos and Heule: Reusing the Assignment Trail in CDCL
+Solvers. Only done for the glue and agility-based restarts. Every once in a
+while a full restart is needed so that the level 0 tasks between search()-es
+(clause cleaning, data sharing, etc.) are not delayed for too long.
+
+@returns false if a full restart must be done
+*/
+bool Searcher::restart_reusing_trail()
+{
+    if (!conf.do_trail_reuse
+        || params.mustLeaveSearch
+        || params.rest_type == restart_type_geom
+        || trail_reuse_in_row >= conf.trail_reuse_max_in_row
+    ) {
+        return false;
+    }
+
+    const uint32_t level = find_trail_reuse_level();
+    if (level == 0) {
+        return false;
+    }
+
+    trail_reuse_in_row++;
+    stats.trailReuseRestarts++;
+    stats.trailReuseLitsKept +=
+        (level < decisionLevel() ? trail_lim[level] : trail.size()) - trail_lim[0];
+    cancelUntil(level);
+
+    //Same as at the start of search()
+    if (params.update)
+        stats.numRestarts++;
+    agility.reset(conf.agilityLimit);
+    hist.clear();
+    blocked_restart = false;
+    params.needToStopSearch = false;
+    params.numAgilityNeedRestart = 0;
+
+    return true;
+}
+
+bool Searcher::ranked_higher(const Var a, const Var b) const
+{
+    if (conf.branch_strategy == branch_vmtf) {
+        return vmtf_queue.bumped_at(a) > vmtf_queue.bumped_at(b);
+    }
+
+    return activities[a] > activities[b];
+}
+
+uint32_t Searcher::find_trail_reuse_level()
+{
+    //The variable that would be decided on next
+    Var next = var_Undef;
+    if (conf.branch_strategy == branch_vmtf) {
+        next = pick_var_vmtf();
+    } else {
+        while (!order_heap.empty()) {
+            const Var var = order_heap.get_min();
+            if (value(var) == l_Undef && varData[var].is_decision) {
+                next = var;
+                break;
+            }
+            order_heap.remove_min();
+        }
+    }
+    if (next == var_Undef) {
+        return decisionLevel();
+    }
+
+    //Assumptions are always re-made in the same order
+    uint32_t level = std::min<uint32_t>(assumptions.size(), decisionLevel());
+    for(; level < decisionLevel(); level++) {
+        const Var decision = trail[trail_lim[level]].var();
+        if (!ranked_higher(decision, next)) {
+            break;
+        }
     }
+
+    return level;
 }
 
 void Searcher::add_otf_subsume_long_clauses()
@@ -1458,8 +1665,11 @@ void Searcher::update_history_stats(size_t backtrack_level, size_t glue)
     #endif
 }
 
-void Searcher::attach_and_enqueue_learnt_clause(Clause* cl)
-{
+void Searcher::attach_and_enqueue_learnt_clause(
+    Clause* cl
+    , const uint32_t glue
+    , const uint32_t level
+) {
     switch (learnt_clause.size()) {
         case 0:
             assert(false);
@@ -1489,6 +1699,7 @@ void Searcher::attach_and_enqueue_learnt_clause(Clause* cl)
         case 3:
             //3-long learnt
             stats.learntTris++;
+            solver->datasync->signalNewLongClause(learnt_clause, glue);
             solver->attach_tri_clause(learnt_clause[0], learnt_clause[1], learnt_clause[2], true);
             enqueue(learnt_clause[0], PropBy(learnt_clause[1], learnt_clause[2], true));
 
@@ -1501,6 +1712,7 @@ void Searcher::attach_and_enqueue_learnt_clause(Clause* cl)
             //Long learnt
             cl->stats.resolutions = resolutions;
             stats.learntLongs++;
+            solver->datasync->signalNewLongClause(learnt_clause, glue);
             solver->attachClause(*cl);
             enqueue(learnt_clause[0], PropBy(cl_alloc.get_offset(cl)));
 
@@ -1510,6 +1722,53 @@ void Searcher::attach_and_enqueue_learnt_clause(Clause* cl)
 
             break;
     }
+
+    //After chronological backtracking the asserted literal's level is
+    //that of the clause's other literals, below the current one
+    varData[learnt_clause[0].var()].level = level;
+}
+
+bool Searcher::chrono_backtrack_allowed() const
+{
+    //Gaussian elimination's matrix states assume an ordered trail
+    return conf.diff_declev_for_chrono > -1
+        && gauss_matrixes.empty();
+}
+
+uint32_t Searcher::find_conflict_level(const PropBy confl)
+{
+    uint32_t level = 0;
+    switch (confl.getType()) {
+        case tertiary_t:
+            level = std::max(level, varData[confl.lit3().var()].level);
+            level = std::max(level, varData[failBinLit.var()].level);
+            level = std::max(level, varData[confl.lit2().var()].level);
+            break;
+
+        case binary_t:
+            level = std::max(level, varData[failBinLit.var()].level);
+            level = std::max(level, varData[confl.lit2().var()].level);
+            break;
+
+        case clause_t:
+            for(const Lit lit: *cl_alloc.ptr(confl.get_offset())) {
+                level = std::max(level, varData[lit.var()].level);
+            }
+            break;
+
+        case xor_t:
+            for(const Lit lit: get_xor_reason(confl, var_Undef)) {
+                level = std::max(level, varData[lit.var()].level);
+            }
+            break;
+
+        case null_clause_t:
+        default:
+            assert(false);
+            break;
+    }
+
+    return level;
 }
 
 void Searcher::print_learning_debug_info() const
@@ -1545,6 +1804,8 @@ Clause* Searcher::handle_last_confl_otf_subsumption(
         if (learnt_clause.size() > 3) {
             cl = cl_alloc.Clause_new(learnt_clause, Searcher::sumConflicts());
             cl->makeRed(glue);
+            cl->stats.last_touched = sumConflicts();
+            promote_to_mid_tier_if_needed(*cl);
             ClOffset offset = cl_alloc.get_offset(cl);
             solver->longRedCls.push_back(offset);
             return cl;
@@ -1576,6 +1837,7 @@ Clause* Searcher::handle_last_confl_otf_subsumption(
     //Update stats
     if (cl->red() && cl->stats.glue > glue) {
         cl->stats.glue = glue;
+        promote_to_mid_tier_if_needed(*cl);
     }
     #ifdef STATS_NEEDED
     cl->stats.conflicts_made += conf.rewardShortenedClauseWithConfl;
@@ -1597,6 +1859,19 @@ bool Searcher::handle_conflict(const PropBy confl)
     if (decisionLevel() == 0)
         return false;
 
+    //Due to chronological backtracking, the conflict may be below the
+    //current level. Analysis must start from the conflict's own level
+    const bool chrono = chrono_backtrack_allowed();
+    if (chrono) {
+        const uint32_t conflict_level = find_conflict_level(confl);
+        if (conflict_level == 0) {
+            return false;
+        }
+        if (conflict_level < decisionLevel()) {
+            cancelUntil(conflict_level);
+        }
+    }
+
     Clause* cl = analyze_conflict(
         confl
         , backtrack_level  //return backtrack level here
@@ -1608,7 +1883,16 @@ bool Searcher::handle_conflict(const PropBy confl)
     if (params.update) {
         update_history_stats(backtrack_level, glue);
     }
-    cancelUntil(backtrack_level);
+    if (chrono
+        && learnt_clause.size() > 1
+        && (int)decisionLevel() - (int)backtrack_level >= conf.diff_declev_for_chrono
+    ) {
+        stats.chronoBacktracks++;
+        stats.chronoPropsSaved += trail_lim[decisionLevel()-1] - trail_lim[backtrack_level];
+        cancelUntil(decisionLevel()-1);
+    } else {
+        cancelUntil(backtrack_level);
+    }
 
     add_otf_subsume_long_clauses();
     add_otf_subsume_implicit_clause();
@@ -1617,7 +1901,7 @@ bool Searcher::handle_conflict(const PropBy confl)
     glue = std::min<uint32_t>(glue, std::numeric_limits<uint32_t>::max());
     cl = handle_last_confl_otf_subsumption(cl, glue);
     assert(learnt_clause.size() <= 3 || cl != NULL);
-    attach_and_enqueue_learnt_clause(cl);
+    attach_and_enqueue_learnt_clause(cl, glue, backtrack_level);
 
     varDecayActivity();
     decayClauseAct();
@@ -1937,7 +2221,13 @@ void Searcher::setup_restart_print()
 
 void Searcher::restore_order_heap()
 {
-    order_heap.clear();
+    if (conf.branch_strategy == branch_vmtf) {
+        if (!vmtf_queue.is_linked()) {
+            vmtf_queue.rebuild();
+        }
+    } else {
+        order_heap.clear();
+    }
     for(size_t var = 0; var < nVars(); var++) {
         if (solver->varData[var].is_decision
             && value(var) == l_Undef
@@ -1951,6 +2241,14 @@ void Searcher::restore_order_heap()
 
 void Searcher::reduce_db_if_needed()
 {
+    //The mid tier has its own, conflict-based interval
+    if (conf.every_mid_tier_reduce != 0
+        && sumConflicts() >= solver->reduceDB->get_next_mid_tier_reduce()
+    ) {
+        solver->reduceDB->demote_unused_mid_tier_clauses();
+        num_red_cls_reducedb = count_num_red_cls_reducedb();
+    }
+
     //Check if we should do DBcleaning
     if (num_red_cls_reducedb > conf.max_temporary_learnt_clauses) {
         if (conf.verbosity >= 3) {
@@ -2048,7 +2346,7 @@ bool Searcher::must_abort(const lbool status) {
         return true;
     }
 
-    if (cpuTime() >= conf.maxTime) {
+    if (out_of_time()) {
         if (conf.verbosity >= 3) {
             cout
             << "c search over max time"
@@ -2104,6 +2402,10 @@ lbool Searcher::solve(const uint64_t _maxConfls)
     resetStats();
     num_red_cls_reducedb = count_num_red_cls_reducedb();
     lbool status = l_Undef;
+    if (!init_gauss()) {
+        status = l_False;
+        goto end;
+    }
     if (conf.burst_search_len > 0) {
         restore_order_heap();
         setup_restart_print();
@@ -2160,10 +2462,22 @@ lbool Searcher::solve(const uint64_t _maxConfls)
 
         clean_clauses_if_needed();
         if (!conf.never_stop_search) {
+            const size_t replaced_before = solver->varReplacer->get_num_replaced_vars();
             status = perform_scc_and_varreplace_if_needed();
             if (status != l_Undef) {
                 goto end;
             }
+
+            //Matrixes may contain variables that have just been replaced
+            if (!gauss_matrixes.empty()
+                && replaced_before != solver->varReplacer->get_num_replaced_vars()
+            ) {
+                clear_gauss();
+                if (!init_gauss()) {
+                    status = l_False;
+                    goto end;
+                }
+            }
         }
 
         save_search_loop_stats();
@@ -2219,9 +2533,88 @@ void Searcher::print_solution_type(const lbool status) const
     }
 }
 
+bool Searcher::init_gauss()
+{
+    assert(gauss_matrixes.empty());
+    if (conf.gaussconf.decision_until == 0
+        || solver->xorclauses.empty()
+        //Gauss-derived reasons cannot be checked by DRUP
+        || drup->enabled()
+    ) {
+        return true;
+    }
+
+    MatrixFinder finder(solver);
+    return finder.find_matrixes();
+}
+
+void Searcher::clear_gauss()
+{
+    for (Gaussian* gauss: gauss_matrixes) {
+        stats.gaussCalled += gauss->get_called();
+        stats.gaussUsefulProp += gauss->get_useful_prop();
+        stats.gaussUsefulConfl += gauss->get_useful_confl();
+        stats.gaussUnitTruths += gauss->get_unit_truths();
+        if (conf.verbosity >= 2) {
+            gauss->print_matrix_stats();
+        }
+        delete gauss;
+    }
+    gauss_matrixes.clear();
+}
+
+void Searcher::canceling_gauss(const uint32_t level)
+{
+    for (Gaussian* gauss: gauss_matrixes) {
+        gauss->canceling(level);
+    }
+}
+
+/**
+@brief Runs the Gaussian matrixes, propagating what they find, until fixedpoint
+
+@returns false if the problem has been found UNSAT. Conflict is returned in
+         'confl'
+*/
+bool Searcher::find_truths_gauss(PropBy& confl)
+{
+    bool again = true;
+    while (again) {
+        again = false;
+        for (Gaussian* gauss: gauss_matrixes) {
+            switch (gauss->find_truths(confl, failBinLit)) {
+                case Gaussian::gauss_false:
+                    return false;
+
+                case Gaussian::gauss_confl:
+                    lastConflictCausedBy = ConflCausedBy::gauss;
+                    return true;
+
+                case Gaussian::gauss_prop:
+                    again = true;
+                    break;
+
+                case Gaussian::gauss_nothing:
+                    break;
+            }
+            if (again)
+                break;
+        }
+
+        if (again) {
+            confl = propagate<false>();
+            if (!confl.isNULL())
+                return true;
+        }
+    }
+
+    return true;
+}
+
 void Searcher::finish_up_solve(const lbool status)
 {
     print_solution_type(status);
+    clear_gauss();
 
     if (status == l_True) {
         model = assigns;
@@ -2309,8 +2702,10 @@ Lit Searcher::pickBranchLit()
     if (conf.random_var_freq > 0) {
         double rand = mtrand.randDblExc();
         double frq = conf.random_var_freq;
-        if (rand < frq && !order_heap.empty()) {
-            const Var next_var = order_heap.random_element(mtrand);
+        const bool vmtf = conf.branch_strategy == branch_vmtf;
+        if (rand < frq && (vmtf ? nVars() > 0 : !order_heap.empty())) {
+            const Var next_var = vmtf ?
+                mtrand.randInt(nVars()-1) : order_heap.random_element(mtrand);
 
             if (value(next_var) == l_Undef
                 && solver->varData[next_var].is_decision
@@ -2322,18 +2717,27 @@ Lit Searcher::pickBranchLit()
     }
 
     // Activity based decision:
-    while (next == lit_Undef
-      || value(next.var()) != l_Undef
-      || !solver->varData[next.var()].is_decision
-    ) {
-        //There is no more to branch on. Satisfying assignment found.
-        if (order_heap.empty()) {
-            next = lit_Undef;
-            break;
+    if (conf.branch_strategy == branch_vmtf) {
+        if (next == lit_Undef) {
+            const Var next_var = pick_var_vmtf();
+            if (next_var != var_Undef) {
+                next = Lit(next_var, !pickPolarity(next_var));
+            }
         }
+    } else {
+        while (next == lit_Undef
+          || value(next.var()) != l_Undef
+          || !solver->varData[next.var()].is_decision
+        ) {
+            //There is no more to branch on. Satisfying assignment found.
+            if (order_heap.empty()) {
+                next = lit_Undef;
+                break;
+            }
 
-        const Var next_var = order_heap.remove_min();
-        next = Lit(next_var, !pickPolarity(next_var));
+            const Var next_var = order_heap.remove_min();
+            next = Lit(next_var, !pickPolarity(next_var));
+        }
     }
 
     //Flip polaritiy if need be
@@ -2398,9 +2802,9 @@ void Searcher::cache_based_more_minim(vector<Lit>& cl)
             continue;
 
         assert(solver->implCache.size() > lit.toInt());
-        const TransCache& cache1 = solver->implCache[lit.toInt()];
-        limit -= (int64_t)cache1.lits.size()/2;
-        for (const LitExtra litExtra: cache1.lits) {
+        const TransCache cache1 = solver->implCache[lit.toInt()];
+        limit -= (int64_t)cache1.size()/2;
+        for (const LitExtra litExtra: cache1) {
             assert(seen.size() > litExtra.getLit().toInt());
             if (seen[(~(litExtra.getLit())).toInt()]) {
                 stats.cacheShrinkedClause++;
@@ -2969,6 +3373,9 @@ size_t Searcher::mem_used() const
     mem += otf_subsuming_long_cls.capacity()*sizeof(ClOffset);
     mem += activities.capacity()*sizeof(uint32_t);
     mem += order_heap.mem_used();
+    mem += vmtf_queue.mem_used();
+    mem += vmtf_bumped.capacity()*sizeof(Var);
+    mem += chb_last_conflict.capacity()*sizeof(uint64_t);
     mem += learnt_clause.capacity()*sizeof(Lit);
     mem += hist.mem_used();
     mem += conflict.capacity()*sizeof(Lit);
@@ -3096,7 +3503,62 @@ inline void Searcher::varDecayActivity()
         return;
     }
 
-    var_inc *= (1.0 / var_decay);
+    switch (conf.branch_strategy) {
+        case branch_vsids:
+            var_inc *= (1.0 / var_decay);
+            break;
+
+        case branch_vmtf:
+            vmtf_queue.bump(vmtf_bumped);
+            for(const Var var: vmtf_bumped) {
+                if (value(var) == l_Undef) {
+                    vmtf_queue.update_unassigned(var);
+                }
+            }
+            vmtf_bumped.clear();
+            break;
+
+        case branch_chb:
+            chb_step = std::max(conf.chb_step_min, chb_step - conf.chb_step_decr);
+            break;
+    }
+}
+
+//Walks the queue from the last known unassigned variable towards the front
+Var Searcher::pick_var_vmtf()
+{
+    Var var = vmtf_queue.get_unassigned();
+    while (var != var_Undef
+        && (value(var) != l_Undef || !varData[var].is_decision)
+    ) {
+        var = vmtf_queue.prev(var);
+    }
+    if (var != var_Undef) {
+        vmtf_queue.set_unassigned(var);
+    }
+
+    return var;
+}
+
+//Conflict history-based branching, as per Liang et al., AAAI'16
+void Searcher::chb_update_after_propagation(
+    const size_t trail_from
+    , const bool conflict
+) {
+    if (!update_polarity_and_activity) {
+        return;
+    }
+
+    const uint64_t confls = sumConflicts();
+    const double multiplier = conflict ? 1.0 : 0.9;
+    for(size_t i = trail_from; i < trail.size(); i++) {
+        const Var var = trail[i].var();
+        const double reward = multiplier / (double)(confls - chb_last_conflict[var] + 1);
+        activities[var] = (1.0 - chb_step)*activities[var] + chb_step*reward;
+        if (order_heap.in_heap(var)) {
+            order_heap.update(var);
+        }
+    }
 }
 
 inline void Searcher::bump_var_activitiy(Var var)
@@ -3105,6 +3567,14 @@ inline void Searcher::bump_var_activitiy(Var var)
         return;
     }
 
+    if (conf.branch_strategy == branch_vmtf) {
+        vmtf_bumped.push_back(var);
+        return;
+    } else if (conf.branch_strategy == branch_chb) {
+        chb_last_conflict[var] = sumConflicts();
+        return;
+    }
+
     activities[var] += var_inc;
 
     #ifdef SLOW_DEBUG
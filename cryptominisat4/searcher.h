@@ -34,12 +34,14 @@
 #include "hyperengine.h"
 #include "MersenneTwister.h"
 #include "minisat_rnd.h"
+#include "vmtf.h"
 
 namespace CMSat {
 
 class Solver;
 class SQLStats;
 class VarReplacer;
+class Gaussian;
 
 using std::string;
 using std::cout;
@@ -267,6 +269,18 @@ class Searcher : public HyperEngine
                 transReduRemIrred += other.transReduRemIrred;
                 transReduRemRed += other.transReduRemRed;
 
+                //Gaussian elimination
+                gaussCalled += other.gaussCalled;
+                gaussUsefulProp += other.gaussUsefulProp;
+                gaussUsefulConfl += other.gaussUsefulConfl;
+                gaussUnitTruths += other.gaussUnitTruths;
+
+                //Chronological backtracking
+                chronoBacktracks += other.chronoBacktracks;
+                chronoPropsSaved += other.chronoPropsSaved;
+                trailReuseRestarts += other.trailReuseRestarts;
+                trailReuseLitsKept += other.trailReuseLitsKept;
+
                 //Stat structs
                 resolvs += other.resolvs;
                 conflStats += other.conflStats;
@@ -324,6 +338,18 @@ class Searcher : public HyperEngine
                 transReduRemIrred -= other.transReduRemIrred;
                 transReduRemRed -= other.transReduRemRed;
 
+                //Gaussian elimination
+                gaussCalled -= other.gaussCalled;
+                gaussUsefulProp -= other.gaussUsefulProp;
+                gaussUsefulConfl -= other.gaussUsefulConfl;
+                gaussUnitTruths -= other.gaussUnitTruths;
+
+                //Chronological backtracking
+                chronoBacktracks -= other.chronoBacktracks;
+                chronoPropsSaved -= other.chronoPropsSaved;
+                trailReuseRestarts -= other.trailReuseRestarts;
+                trailReuseLitsKept -= other.trailReuseLitsKept;
+
                 //Stat structs
                 resolvs -= other.resolvs;
                 conflStats -= other.conflStats;
@@ -364,6 +390,38 @@ class Searcher : public HyperEngine
                 print_stats_line("c decisions/conflicts"
                     , (double)decisions/(double)conflStats.numConflicts
                 );
+
+                print_stats_line("c decisions/sec"
+                    , ratio_for_stat(decisions, cpu_time)
+                );
+
+                if (chronoBacktracks > 0) {
+                    print_stats_line("c chrono backtracks"
+                        , chronoBacktracks
+                        , stats_line_percent(chronoBacktracks, conflStats.numConflicts)
+                        , "% of conflicts"
+                    );
+
+                    print_stats_line("c chrono props saved"
+                        , chronoPropsSaved
+                        , ratio_for_stat(chronoPropsSaved, chronoBacktracks)
+                        , "lits/backtrack"
+                    );
+                }
+
+                if (trailReuseRestarts > 0) {
+                    print_stats_line("c trail reuse restarts"
+                        , trailReuseRestarts
+                        , stats_line_percent(trailReuseRestarts, numRestarts)
+                        , "% of restarts"
+                    );
+
+                    print_stats_line("c trail reuse lits kept"
+                        , trailReuseLitsKept
+                        , ratio_for_stat(trailReuseLitsKept, trailReuseRestarts)
+                        , "lits/restart"
+                    );
+                }
             }
 
             void print_short() const
@@ -463,6 +521,26 @@ class Searcher : public HyperEngine
                     , "bin/call"
                 );
 
+                if (gaussCalled > 0) {
+                    cout << "c GAUSS stats" << endl;
+                    print_stats_line("c gauss called"
+                        , gaussCalled
+                    );
+                    print_stats_line("c gauss useful prop"
+                        , gaussUsefulProp
+                        , stats_line_percent(gaussUsefulProp, gaussCalled)
+                        , "% of calls"
+                    );
+                    print_stats_line("c gauss useful confl"
+                        , gaussUsefulConfl
+                        , stats_line_percent(gaussUsefulConfl, gaussCalled)
+                        , "% of calls"
+                    );
+                    print_stats_line("c gauss unit truths"
+                        , gaussUnitTruths
+                    );
+                }
+
                 cout << "c CONFL LITS stats" << endl;
                 print_stats_line("c orig "
                     , litsRedNonMin
@@ -569,6 +647,20 @@ class Searcher : public HyperEngine
             uint64_t transReduRemIrred = 0;
             uint64_t transReduRemRed = 0;
 
+            //Gaussian elimination
+            uint64_t gaussCalled = 0;
+            uint64_t gaussUsefulProp = 0;
+            uint64_t gaussUsefulConfl = 0;
+            uint64_t gaussUnitTruths = 0;
+
+            //Chronological backtracking
+            uint64_t chronoBacktracks = 0;
+            uint64_t chronoPropsSaved = 0; ///<Assignments kept that a backjump would have undone
+
+            //Restarts reusing the trail
+            uint64_t trailReuseRestarts = 0;
+            uint64_t trailReuseLitsKept = 0;
+
             //Resolution Stats
             ResolutionTypes<uint64_t> resolvs;
 
@@ -594,6 +686,13 @@ class Searcher : public HyperEngine
         void cancelUntil(uint32_t level); ///<Backtrack until a certain level.
 
     protected:
+        //Gaussian elimination
+        vector<Gaussian*> gauss_matrixes;
+        bool init_gauss();
+        void clear_gauss();
+        bool find_truths_gauss(PropBy& confl);
+        void canceling_gauss(const uint32_t level);
+
         void new_var(const bool bva, const Var orig_outer) override;
         void new_vars(const size_t n) override;
         void save_on_var_memory();
@@ -652,7 +751,9 @@ class Searcher : public HyperEngine
         lbool burst_search();
         bool  handle_conflict(PropBy confl);// Handles the conflict clause
         void  update_history_stats(size_t backtrack_level, size_t glue);
-        void  attach_and_enqueue_learnt_clause(Clause* cl);
+        void  attach_and_enqueue_learnt_clause(Clause* cl, const uint32_t glue, const uint32_t level);
+        uint32_t find_conflict_level(const PropBy confl);
+        bool  chrono_backtrack_allowed() const;
         void  print_learning_debug_info() const;
         void  print_learnt_clause() const;
         void  add_otf_subsume_long_clauses();
@@ -660,6 +761,10 @@ class Searcher : public HyperEngine
         Clause* handle_last_confl_otf_subsumption(Clause* cl, const size_t glue);
         lbool new_decision();  // Handles the case when decision must be made
         void  check_need_restart();     // Helper function to decide if we need to restart during search
+        bool  restart_reusing_trail();
+        uint32_t find_trail_reuse_level();
+        bool  ranked_higher(const Var a, const Var b) const;
+        uint32_t trail_reuse_in_row;
         Lit   pickBranchLit();
         lbool otf_hyper_prop_first_dec_level(bool& must_continue);
         void  hyper_bin_update_cache(vector<Lit>& to_enqueue_toplevel);
@@ -677,11 +782,13 @@ class Searcher : public HyperEngine
             {
                 update = true;
                 needToStopSearch = false;
+                mustLeaveSearch = false;
                 conflictsDoneThisRestart = 0;
                 numAgilityNeedRestart = 0;
             }
 
             bool needToStopSearch;
+            bool mustLeaveSearch; ///<Stopping not (only) due to restart strategy, trail cannot be reused
             bool update;
             uint64_t conflictsDoneThisRestart;
             uint64_t conflictsToDo;
@@ -763,7 +870,7 @@ class Searcher : public HyperEngine
         // Variable activity
         vector<double> activities;
         double var_inc;
-        void              insertVarOrder(const Var x);  ///< Insert a variable in heap
+        void              insertVarOrder(const Var x);  ///< Insert a variable in heap/queue
 
 
         uint64_t more_red_minim_limit_binary_actual;
@@ -808,10 +915,20 @@ class Searcher : public HyperEngine
             bool operator()(uint32_t var) const;
         };
 
-        ///Decay all variables with the specified factor. Implemented by increasing the 'bump' value instead.
+        ///Called once per conflict, after the learnt clause has been added. For VSIDS decays all variables by increasing the 'bump' value instead.
         void     varDecayActivity ();
-        ///Increase a variable with the current 'bump' value.
+        ///Increase a variable with the current 'bump' value, or mark it as bumped for VMTF/CHB
         void     bump_var_activitiy  (Var v);
+        Var      pick_var_vmtf();
+        void     chb_update_after_propagation(size_t trail_from, bool conflict);
+
+        //VMTF
+        VmtfQueue vmtf_queue;
+        vector<Var> vmtf_bumped;
+
+        //CHB -- Q-scores are kept in 'activities' and ordered by 'order_heap'
+        vector<uint64_t> chb_last_conflict;
+        double chb_step;
         struct VarOrderLt { ///Order variables according to their activities
             const vector<double>&  activities;
             bool operator () (const Var x, const Var y) const
@@ -902,9 +1019,15 @@ inline void Searcher::cancelUntil(uint32_t level)
     #endif
 
     if (decisionLevel() > level) {
+        if (!gauss_matrixes.empty()) {
+            canceling_gauss(level);
+        }
 
         //Go through in reverse order, unassign & insert then
-        //back to the vars to be branched upon
+        //back to the vars to be branched upon. After chronological
+        //backtracking the trail may hold literals of lower levels than the
+        //decision before them, those at or below 'level' are kept
+        size_t kept = 0;
         for (int sublevel = trail.size()-1
             ; sublevel >= (int)trail_lim[level]
             ; sublevel--
@@ -922,13 +1045,29 @@ inline void Searcher::cancelUntil(uint32_t level)
 
             const Var var = trail[sublevel].var();
             assert(value(var) != l_Undef);
+            if (varData[var].level <= level) {
+                kept++;
+                continue;
+            }
             assigns[var] = l_Undef;
             if (also_insert_varorder) {
                 insertVarOrder(var);
             }
         }
         qhead = trail_lim[level];
-        trail.resize(trail_lim[level]);
+        if (kept == 0) {
+            trail.resize(trail_lim[level]);
+        } else {
+            //Kept literals must be propagated again, in their original order
+            size_t j = trail_lim[level];
+            for (size_t i = j; i < trail.size(); i++) {
+                if (value(trail[i]) != l_Undef) {
+                    trail[j++] = trail[i];
+                }
+            }
+            assert(j == trail_lim[level] + kept);
+            trail.resize(j);
+        }
         trail_lim.resize(level);
     }
 
@@ -942,6 +1081,11 @@ inline void Searcher::cancelUntil(uint32_t level)
 
 inline void Searcher::insertVarOrder(const Var x)
 {
+    if (conf.branch_strategy == branch_vmtf) {
+        vmtf_queue.update_unassigned(x);
+        return;
+    }
+
     if (!order_heap.in_heap(x)
     ) {
         #ifdef SLOW_DEUG
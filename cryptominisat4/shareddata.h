@@ -23,6 +23,7 @@
 #define SHARED_DATA_H
 
 #include "solvertypesmini.h"
+#include "clausering.h"
 
 #include <vector>
 #include <mutex>
@@ -34,9 +35,20 @@ namespace CMSat {
 class SharedData
 {
     public:
-        SharedData(const uint32_t _num_threads) :
+        SharedData(const uint32_t _num_threads, const uint32_t ring_size) :
             num_threads(_num_threads)
-        {}
+        {
+            for(uint32_t i = 0; i < num_threads; i++) {
+                rings.push_back(new ClauseRing(ring_size));
+            }
+        }
+
+        ~SharedData()
+        {
+            for(ClauseRing* ring: rings) {
+                delete ring;
+            }
+        }
 
         struct Spec {
             Spec() :
@@ -67,6 +79,9 @@ class SharedData
         mutex unit_mutex;
         mutex bin_mutex;
 
+        //Short learnt clauses, one ring per thread, no locking needed
+        vector<ClauseRing*> rings;
+
         uint32_t num_threads;
 
         size_t calc_memory_use_bins()
@@ -81,6 +96,15 @@ class SharedData
             }
             return mem;
         }
+
+        size_t calc_memory_use_rings() const
+        {
+            size_t mem = 0;
+            for(const ClauseRing* ring: rings) {
+                mem += ring->mem_used();
+            }
+            return mem;
+        }
 };
 
 }
@@ -43,6 +43,7 @@
 #include "gatefinder.h"
 #include "varreplacer.h"
 #include "varupdatehelper.h"
+#include "batchworkers.h"
 #include "completedetachreattacher.h"
 #include "subsumestrengthen.h"
 #include "watchalgos.h"
@@ -127,11 +128,19 @@ void Simplifier::save_on_var_memory()
 {
     clauses.clear();
     clauses.shrink_to_fit();
+    untouched_clauses.clear();
+    untouched_clauses.shrink_to_fit();
 
     cl_to_free_later.shrink_to_fit();
+    to_link.shrink_to_fit();
+    occur_num_added.clear();
+    occur_num_added.shrink_to_fit();
 
     touched.shrink_to_fit();
-    resolvents.shrink_to_fit();
+    elim_scratch.clear();
+    elim_scratch.shrink_to_fit();
+    varelim_batch.clear();
+    varelim_batch.shrink_to_fit();
     poss_gate_parts.shrink_to_fit();
     negs_gate_parts.shrink_to_fit();
     blockedClauses.shrink_to_fit();;
@@ -357,8 +366,8 @@ uint64_t Simplifier::calc_mem_usage_of_occur(const vector<ClOffset>& toAdd) cons
         ; ++it
     ) {
         Clause* cl = solver->cl_alloc.ptr(*it);
-        //*2 because of the overhead of allocation
-        memUsage += cl->size()*sizeof(Watched)*2;
+        //Lists are allocated at their final size, see reserve_occur()
+        memUsage += cl->size()*sizeof(Watched);
     }
 
     //Estimate malloc overhead
@@ -383,6 +392,13 @@ void Simplifier::print_linkin_data(const LinkInData link_in_data) const
     if (solver->conf.verbosity < 2)
         return;
 
+    if (incremental) {
+        cout
+        << "c [simp] Not linked in as untouched "
+        << link_in_data.cl_untouched
+        << endl;
+    }
+
     double val;
     if (link_in_data.cl_linked + link_in_data.cl_not_linked == 0) {
         val = 0;
@@ -409,6 +425,7 @@ Simplifier::LinkInData Simplifier::link_in_clauses(
 ) {
     LinkInData link_in_data;
     uint64_t linkedInLits = 0;
+    to_link.clear();
     for (const ClOffset offs: toAdd) {
         Clause* cl = solver->cl_alloc.ptr(offs);
 
@@ -418,6 +435,13 @@ Simplifier::LinkInData Simplifier::link_in_clauses(
             || (!irred && cl->red())
         );
 
+        //None of its variables can be eliminated, no need to look at it
+        if (incremental && !touched_since_last_run(*cl)) {
+            untouched_clauses.push_back(offs);
+            link_in_data.cl_untouched++;
+            continue;
+        }
+
         if (alsoOccur
             //If irreduntant or (small enough AND link in limit not reached)
             && (irred
@@ -425,7 +449,7 @@ Simplifier::LinkInData Simplifier::link_in_clauses(
                     && linkedInLits < (solver->conf.maxOccurRedLitLinkedM*1000ULL*1000ULL))
             )
         ) {
-            linkInClause(*cl);
+            to_link.push_back(offs);
             link_in_data.cl_linked++;
             linkedInLits += cl->size();
         } else {
@@ -438,9 +462,42 @@ Simplifier::LinkInData Simplifier::link_in_clauses(
     }
     clause_lits_added += linkedInLits;
 
+    reserve_occur(to_link);
+    for (const ClOffset offs: to_link) {
+        linkInClause(*solver->cl_alloc.ptr(offs));
+    }
+    to_link.clear();
+
     return link_in_data;
 }
 
+/**
+@brief Allocates the occur lists at the size they will have after link-in
+
+The occurrences of every literal are counted first, and each list is then
+allocated only once. Growing them by push() alone would leave up to half of
+every list unused, which is what used to trigger the memory cut-offs.
+*/
+void Simplifier::reserve_occur(const vector<ClOffset>& offsets)
+{
+    occur_num_added.clear();
+    occur_num_added.resize(solver->watches.size(), 0);
+    for (const ClOffset offs: offsets) {
+        const Clause& cl = *solver->cl_alloc.ptr(offs);
+        for (const Lit lit: cl) {
+            occur_num_added[lit.toInt()]++;
+        }
+    }
+
+    for (size_t i = 0; i < occur_num_added.size(); i++) {
+        if (occur_num_added[i] == 0)
+            continue;
+
+        watch_subarray ws = solver->watches[i];
+        ws.reserve(ws.size() + occur_num_added[i]);
+    }
+}
+
 bool Simplifier::decide_occur_limit(bool irred, uint64_t memUsage)
 {
     //over + irred -> exit
@@ -492,7 +549,7 @@ bool Simplifier::add_from_solver(
 
     LinkInData link_in_data = link_in_clauses(toAdd, irred, alsoOccur);
     toAdd.clear();
-    if (!irred)
+    if (!irred || incremental)
         print_linkin_data(link_in_data);
 
     return true;
@@ -533,10 +590,35 @@ bool Simplifier::check_varelim_when_adding_back_cl(const Clause* cl) const
     return notLinkedNeedFree;
 }
 
+bool Simplifier::touched_since_last_run(const Clause& cl) const
+{
+    for(const Lit lit: cl) {
+        if (solver->varData[lit.var()].added_since_simp) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Simplifier::clear_touched_since_last_run()
+{
+    for(VarData& dat: solver->varData) {
+        dat.added_since_simp = false;
+    }
+}
+
 void Simplifier::add_back_to_solver()
+{
+    add_back_to_solver(clauses);
+    add_back_to_solver(untouched_clauses);
+    untouched_clauses.clear();
+}
+
+void Simplifier::add_back_to_solver(const vector<ClOffset>& cls)
 {
     for (vector<ClOffset>::const_iterator
-        it = clauses.begin(), end = clauses.end()
+        it = cls.begin(), end = cls.end()
         ; it != end
         ; ++it
     ) {
@@ -716,6 +798,11 @@ bool Simplifier::can_eliminate_var(const Var var) const
     if (solver->value(var) != l_Undef
         || solver->varData[var].removed != Removed::none
         ||  solver->var_inside_assumptions(var)
+        ||  solver->varData[var].frozen
+        //Its native XORs are not in the occur lists
+        ||  solver->varData[var].in_xor
+        //Not all of its clauses are in the occur lists
+        || (incremental && !solver->varData[var].added_since_simp)
     ) {
         return false;
     }
@@ -735,39 +822,47 @@ bool Simplifier::eliminate_vars()
     limit_to_decrease = &norm_varelim_time_limit;
     cl_to_free_later.clear();
     assert(solver->watches.get_smudged_list().empty());
+    setup_elim_scratch();
+    varelim_batches = 0;
+    BatchWorkers workers(elim_scratch.size());
 
     order_vars_for_elim();
 
-    //Go through the ordered list of variables to eliminate
+    //Go through the ordered list of variables to eliminate, in batches
     while(!varElimOrder.empty()
         && *limit_to_decrease > 0
         && varelim_num_limit > 0
         && !solver->must_interrupt_asap()
     ) {
         assert(limit_to_decrease == &norm_varelim_time_limit);
-        Var var = varElimOrder.remove_min();
+        fill_varelim_batch(wenThrough);
+        test_varelim_batch(workers);
+
+        //Eliminate in order, so the result does not depend on the thread count
+        for(size_t i = 0; i < varelim_batch_size; i++) {
+            VarElimCand& cand = varelim_batch[i];
+            if (*limit_to_decrease <= 0
+                || varelim_num_limit <= 0
+            ) {
+                break;
+            }
 
-        //Stats
-        *limit_to_decrease -= 20;
-        wenThrough++;
+            if (!can_eliminate_var(cand.var))
+                continue;
 
-        //Print status
-        if (solver->conf.verbosity >= 5
-            && wenThrough % 200 == 0
-        ) {
-            cout << "toDecrease: " << *limit_to_decrease << endl;
+            //Try to eliminate
+            if (maybe_eliminate(cand)) {
+                vars_elimed++;
+                varelim_num_limit--;
+            }
+            if (!solver->ok)
+                goto end;
         }
 
-        if (!can_eliminate_var(var))
-            continue;
-
-        //Try to eliminate
-        if (maybe_eliminate(var)) {
-            vars_elimed++;
-            varelim_num_limit--;
+        //Print status
+        if (solver->conf.verbosity >= 5) {
+            cout << "toDecrease: " << *limit_to_decrease << endl;
         }
-        if (!solver->ok)
-            goto end;
     }
 
 end:
@@ -781,6 +876,7 @@ end:
         cout
         << "c  #try to eliminate: " << wenThrough << endl
         << "c  #var-elim: " << vars_elimed << endl
+        << "c  #batches: " << varelim_batches << endl
         << "c  #T-o: " << (time_out ? "Y" : "N") << endl
         << "c  #T-r: " << std::fixed << std::setprecision(2) << (time_remain*100.0) << "%" << endl
         << "c  #T: " << time_used << endl;
@@ -803,6 +899,148 @@ end:
     return solver->ok;
 }
 
+void Simplifier::setup_elim_scratch()
+{
+    const size_t num_threads = std::max<size_t>(1, solver->conf.varelim_threads);
+    elim_scratch.resize(num_threads);
+    for(ElimScratch& sc: elim_scratch) {
+        sc.seen.resize(solver->nVars()*2, 0);
+    }
+    gate_found_elim = false;
+}
+
+/**
+@brief Marks the variables of the clauses of var, unless it overlaps an earlier mark
+
+The neighbourhoods of the variables in a batch are disjoint. Hence the
+elimination of one of them cannot change the occurrence lists of the others
+(unless something gets propagated) and they can be tested in parallel.
+*/
+bool Simplifier::mark_varelim_neighbourhood(const Var var)
+{
+    const Lit lit(var, false);
+    for(int pass = 0; pass < 2; pass++) {
+        const bool set = (pass == 1);
+        for(const Lit l: {lit, ~lit}) {
+            watch_subarray_const ws = solver->watches[l.toInt()];
+            *limit_to_decrease -= (long)ws.size() + 2;
+            for(const Watched w: ws) {
+                //All our clauses contain var, no need to look at it
+                if (w.isBinary() || w.isTri()) {
+                    const Var v2 = w.lit2().var();
+                    const Var v3 = w.isTri() ? w.lit3().var() : var;
+                    for(const Var v: {v2, v3}) {
+                        if (!set && seen2[v]) {
+                            return false;
+                        }
+                        if (set && !seen2[v]) {
+                            seen2[v] = 1;
+                            varelim_batch_marked.push_back(v);
+                        }
+                    }
+                    continue;
+                }
+
+                assert(w.isClause());
+                const Clause& cl = *solver->cl_alloc.ptr(w.get_offset());
+                if (cl.getRemoved()) {
+                    continue;
+                }
+                *limit_to_decrease -= (long)cl.size();
+                for(const Lit cl_lit: cl) {
+                    const Var v = cl_lit.var();
+                    if (!set && seen2[v]) {
+                        return false;
+                    }
+                    if (set && !seen2[v]) {
+                        seen2[v] = 1;
+                        varelim_batch_marked.push_back(v);
+                    }
+                }
+            }
+        }
+    }
+    if (!seen2[var]) {
+        seen2[var] = 1;
+        varelim_batch_marked.push_back(var);
+    }
+
+    return true;
+}
+
+void Simplifier::fill_varelim_batch(size_t& wenThrough)
+{
+    varelim_batch_size = 0;
+    vector<Var> deferred;
+    while(!varElimOrder.empty()
+        && varelim_batch_size < solver->conf.varelim_batch_size
+        && deferred.size() < solver->conf.varelim_batch_size
+        && *limit_to_decrease > 0
+    ) {
+        const Var var = varElimOrder.remove_min();
+
+        //Stats
+        *limit_to_decrease -= 20;
+        wenThrough++;
+
+        if (!can_eliminate_var(var))
+            continue;
+
+        //Interacts with a variable already in the batch, try next time
+        if (seen2[var] || !mark_varelim_neighbourhood(var)) {
+            deferred.push_back(var);
+            continue;
+        }
+
+        if (varelim_batch.size() == varelim_batch_size) {
+            varelim_batch.push_back(VarElimCand());
+        }
+        varelim_batch[varelim_batch_size++].var = var;
+    }
+
+    for(const Var var: varelim_batch_marked) {
+        seen2[var] = 0;
+    }
+    varelim_batch_marked.clear();
+    for(const Var var: deferred) {
+        varElimOrder.insert(var);
+    }
+    varelim_batches++;
+}
+
+void Simplifier::test_varelim_cand(
+    VarElimCand& cand
+    , ElimScratch& sc
+    , const int64_t limit
+    , const int64_t aggressive_limit
+) {
+    sc.limit = limit;
+    sc.aggressive_limit = aggressive_limit;
+    sc.used_aggressive = false;
+    cand.cost = test_elim_and_fill_resolvents(cand.var, sc);
+    cand.time_used = limit - sc.limit;
+    cand.aggressive_time_used = aggressive_limit - sc.aggressive_limit;
+    cand.used_aggressive = sc.used_aggressive;
+    std::swap(cand.resolvents, sc.resolvents);
+}
+
+/**
+@brief Calculates the resolvents of all variables in the batch
+
+Every test starts from the same time limits and only reads the occurrence
+lists, so the outcome is the same whether it runs on one thread or many.
+*/
+void Simplifier::test_varelim_batch(BatchWorkers& workers)
+{
+    const int64_t limit = *limit_to_decrease;
+    const int64_t aggressive_limit = aggressive_elim_time_limit;
+    varelim_batch_trail_size = solver->trail_size();
+
+    workers.run(varelim_batch_size, [&](const size_t i, const size_t thread) {
+        test_varelim_cand(varelim_batch[i], elim_scratch[thread], limit, aggressive_limit);
+    });
+}
+
 void Simplifier::free_clauses_to_free()
 {
     for(ClOffset off: cl_to_free_later) {
@@ -861,6 +1099,9 @@ bool Simplifier::simplify(const bool _startup)
     }
 
     //Setup
+    incremental = startup
+        && solver->conf.incremental_simplify
+        && globalStats.numCalls > 0;
     clause_lits_added = 0;
     runStats.clear();
     runStats.numCalls++;
@@ -940,6 +1181,7 @@ end:
 
     remove_by_drup_recently_blocked_clauses(origBlockedSize);
     finishUp(origTrailSize);
+    clear_touched_since_last_run();
 
     //Print stats
     if (solver->conf.verbosity >= 1) {
@@ -1642,24 +1884,32 @@ bool Simplifier::skip_resolution_thanks_to_gate(
     return poss_gate_parts[at_poss] == negs_gate_parts[at_negs];
 }
 
-int Simplifier::test_elim_and_fill_resolvents(const Var var)
+/**
+@brief Calculates the resolvents and the cost of eliminating var
+
+Only reads the occurrence lists, except for sorting the ones of var. All
+temporaries and time limits are in sc, so that variables with disjoint
+neighbourhoods can be tested in parallel.
+*/
+int Simplifier::test_elim_and_fill_resolvents(const Var var, ElimScratch& sc)
 {
     assert(solver->ok);
     assert(solver->varData[var].removed == Removed::none);
     assert(solver->value(var) == l_Undef);
 
     //Gather data
-    HeuristicData pos = calc_data_for_heuristic(Lit(var, false));
-    HeuristicData neg = calc_data_for_heuristic(Lit(var, true));
+    HeuristicData pos = calc_data_for_heuristic(Lit(var, false), sc.limit);
+    HeuristicData neg = calc_data_for_heuristic(Lit(var, true), sc.limit);
+    sc.resolvents.clear();
 
     //Heuristic calculation took too much time
-    if (*limit_to_decrease < 0) {
+    if (sc.limit < 0) {
         return 1000;
     }
 
     //Check if we should do aggressive check or not
-    const bool aggressive = (aggressive_elim_time_limit > 0 && !startup);
-    runStats.usedAggressiveCheckToELim += aggressive;
+    const bool aggressive = (sc.aggressive_limit > 0 && !startup);
+    sc.used_aggressive = aggressive;
 
     //set-up
     const Lit lit = Lit(var, false);
@@ -1667,7 +1917,6 @@ int Simplifier::test_elim_and_fill_resolvents(const Var var)
     watch_subarray negs = solver->watches[(~lit).toInt()];
     std::sort(poss.begin(), poss.end(), watch_sort_smallest_first());
     std::sort(negs.begin(), negs.end(), watch_sort_smallest_first());
-    resolvents.clear();
 
     //Pure literal, no resolvents
     //we look at "pos" and "neg" (and not poss&negs) because we don't care about redundant clauses
@@ -1682,8 +1931,8 @@ int Simplifier::test_elim_and_fill_resolvents(const Var var)
         return 1000;
     }
 
-    gate_found_elim = false;
     if (solver->conf.skip_some_bve_resolvents) {
+        //Gate marking would need per-thread gate_found_elim & parts
         //mark_gate_in_poss_negs(lit, poss, negs);
     }
 
@@ -1701,7 +1950,7 @@ int Simplifier::test_elim_and_fill_resolvents(const Var var)
         ; it != end
         ; ++it, at_poss++
     ) {
-        *limit_to_decrease -= 3;
+        sc.limit -= 3;
         if (solver->redundant_or_removed(*it))
             continue;
 
@@ -1711,7 +1960,7 @@ int Simplifier::test_elim_and_fill_resolvents(const Var var)
             ; it2 != end2
             ; it2++, at_negs++
         ) {
-            *limit_to_decrease -= 3;
+            sc.limit -= 3;
             if (solver->redundant_or_removed(*it2))
                 continue;
 
@@ -1726,30 +1975,30 @@ int Simplifier::test_elim_and_fill_resolvents(const Var var)
             }
 
             //Resolve the two clauses
-            bool tautological = resolve_clauses(*it, *it2, lit, aggressive);
+            bool tautological = resolve_clauses(*it, *it2, lit, aggressive, sc);
             if (tautological)
                 continue;
 
             #ifdef VERBOSE_DEBUG_VARELIM
-            cout << "Adding new clause due to varelim: " << dummy << endl;
+            cout << "Adding new clause due to varelim: " << sc.dummy << endl;
             #endif
 
             //Update after-stats
             after_clauses++;
-            after_literals += dummy.size();
-            if (dummy.size() > 3)
+            after_literals += sc.dummy.size();
+            if (sc.dummy.size() > 3)
                 after_long++;
-            if (dummy.size() == 3)
+            if (sc.dummy.size() == 3)
                 after_tri++;
-            if (dummy.size() == 2)
+            if (sc.dummy.size() == 2)
                 after_bin++;
 
             //Early-abort or over time
             if (after_clauses > before_clauses
                 //Too long resolvent
-                || (solver->conf.velim_resolvent_too_large != -1 && ((int)dummy.size() > solver->conf.velim_resolvent_too_large))
+                || (solver->conf.velim_resolvent_too_large != -1 && ((int)sc.dummy.size() > solver->conf.velim_resolvent_too_large))
                 //Over-time
-                || *limit_to_decrease < -10LL*1000LL
+                || sc.limit < -10LL*1000LL
 
             ) {
                 return 1000;
@@ -1767,7 +2016,7 @@ int Simplifier::test_elim_and_fill_resolvents(const Var var)
                     , solver->cl_alloc.ptr(it2->get_offset())->stats
             );
 
-            resolvents.push_back(Resolvent(dummy, stats));
+            sc.resolvents.push_back(Resolvent(sc.dummy, stats));
         }
     }
 
@@ -2036,14 +2285,29 @@ void Simplifier::create_dummy_blocked_clause(const Lit lit)
     );
 }
 
-bool Simplifier::maybe_eliminate(const Var var)
+bool Simplifier::maybe_eliminate(VarElimCand& cand)
 {
     assert(solver->ok);
+    const Var var = cand.var;
     print_var_elim_complexity_stats(var);
     runStats.testedToElimVars++;
 
+    //Something got propagated since the batch was tested,
+    //the occurrence lists of var may have changed
+    if (solver->trail_size() != varelim_batch_trail_size) {
+        test_varelim_cand(
+            cand
+            , elim_scratch[0]
+            , *limit_to_decrease
+            , aggressive_elim_time_limit
+        );
+    }
+    *limit_to_decrease -= cand.time_used;
+    aggressive_elim_time_limit -= cand.aggressive_time_used;
+    runStats.usedAggressiveCheckToELim += cand.used_aggressive;
+
     //Heuristic says no, or we ran out of time
-    if (test_elim_and_fill_resolvents(var) == 1000
+    if (cand.cost == 1000
         || *limit_to_decrease < 0
     ) {
         return false;
@@ -2061,10 +2325,10 @@ bool Simplifier::maybe_eliminate(const Var var)
 
     //It's best to add resolvents with largest first. Then later, the smaller ones
     //can subsume the larger ones. While adding, we do subsumption check.
-    std::sort(resolvents.begin(), resolvents.end());
+    std::sort(cand.resolvents.begin(), cand.resolvents.end());
 
     //Add resolvents
-    for(Resolvent& resolvent: resolvents) {
+    for(Resolvent& resolvent: cand.resolvents) {
         bool ok = add_varelim_resolvent(resolvent.lits, resolvent.stats);
         if (!ok)
             goto end;
@@ -2118,29 +2382,30 @@ end:
 void Simplifier::add_pos_lits_to_dummy_and_seen(
     const Watched ps
     , const Lit posLit
-) {
+    , ElimScratch& sc
+) const {
     if (ps.isBinary() || ps.isTri()) {
-        *limit_to_decrease -= 1;
+        sc.limit -= 1;
         assert(ps.lit2() != posLit);
 
-        seen[ps.lit2().toInt()] = 1;
-        dummy.push_back(ps.lit2());
+        sc.seen[ps.lit2().toInt()] = 1;
+        sc.dummy.push_back(ps.lit2());
     }
 
     if (ps.isTri()) {
         assert(ps.lit2() < ps.lit3());
 
-        seen[ps.lit3().toInt()] = 1;
-        dummy.push_back(ps.lit3());
+        sc.seen[ps.lit3().toInt()] = 1;
+        sc.dummy.push_back(ps.lit3());
     }
 
     if (ps.isClause()) {
-        Clause& cl = *solver->cl_alloc.ptr(ps.get_offset());
-        *limit_to_decrease -= (long)cl.size();
+        const Clause& cl = *solver->cl_alloc.ptr(ps.get_offset());
+        sc.limit -= (long)cl.size();
         for (const Lit lit : cl){
             if (lit != posLit) {
-                seen[lit.toInt()] = 1;
-                dummy.push_back(lit);
+                sc.seen[lit.toInt()] = 1;
+                sc.dummy.push_back(lit);
             }
         }
     }
@@ -2149,46 +2414,47 @@ void Simplifier::add_pos_lits_to_dummy_and_seen(
 bool Simplifier::add_neg_lits_to_dummy_and_seen(
     const Watched qs
     , const Lit posLit
-) {
+    , ElimScratch& sc
+) const {
     if (qs.isBinary() || qs.isTri()) {
-        *limit_to_decrease -= 2;
+        sc.limit -= 2;
         assert(qs.lit2() != ~posLit);
 
-        if (seen[(~qs.lit2()).toInt()]) {
+        if (sc.seen[(~qs.lit2()).toInt()]) {
             return true;
         }
-        if (!seen[qs.lit2().toInt()]) {
-            dummy.push_back(qs.lit2());
-            seen[qs.lit2().toInt()] = 1;
+        if (!sc.seen[qs.lit2().toInt()]) {
+            sc.dummy.push_back(qs.lit2());
+            sc.seen[qs.lit2().toInt()] = 1;
         }
     }
 
     if (qs.isTri()) {
         assert(qs.lit2() < qs.lit3());
 
-        if (seen[(~qs.lit3()).toInt()]) {
+        if (sc.seen[(~qs.lit3()).toInt()]) {
             return true;
         }
-        if (!seen[qs.lit3().toInt()]) {
-            dummy.push_back(qs.lit3());
-            seen[qs.lit3().toInt()] = 1;
+        if (!sc.seen[qs.lit3().toInt()]) {
+            sc.dummy.push_back(qs.lit3());
+            sc.seen[qs.lit3().toInt()] = 1;
         }
     }
 
     if (qs.isClause()) {
-        Clause& cl = *solver->cl_alloc.ptr(qs.get_offset());
-        *limit_to_decrease -= (long)cl.size();
+        const Clause& cl = *solver->cl_alloc.ptr(qs.get_offset());
+        sc.limit -= (long)cl.size();
         for (const Lit lit: cl) {
             if (lit == ~posLit)
                 continue;
 
-            if (seen[(~lit).toInt()]) {
+            if (sc.seen[(~lit).toInt()]) {
                 return true;
             }
 
-            if (!seen[lit.toInt()]) {
-                dummy.push_back(lit);
-                seen[lit.toInt()] = 1;
+            if (!sc.seen[lit.toInt()]) {
+                sc.dummy.push_back(lit);
+                sc.seen[lit.toInt()] = 1;
             }
         }
     }
@@ -2200,7 +2466,8 @@ bool Simplifier::reverse_distillation_of_dummy(
     const Watched ps
     , const Watched qs
     , const Lit posLit
-) {
+    , ElimScratch& sc
+) const {
     /*
     //TODO
     //Use watchlists
@@ -2219,16 +2486,16 @@ bool Simplifier::reverse_distillation_of_dummy(
     }
 
     for (size_t i = 0
-        ; i < toClear.size() && aggressive_elim_time_limit > 0
+        ; i < sc.toClear.size() && sc.aggressive_limit > 0
         ; i++
     ) {
-        aggressive_elim_time_limit -= 3;
-        const Lit lit = toClear[i];
+        sc.aggressive_limit -= 3;
+        const Lit lit = sc.toClear[i];
         assert(lit.var() != posLit.var());
 
         //Use cache
-        const vector<LitExtra>& cache = solver->implCache[lit.toInt()].lits;
-        aggressive_elim_time_limit -= cache.size()/3;
+        const TransCache cache = solver->implCache[lit.toInt()];
+        sc.aggressive_limit -= cache.size()/3;
         for(const LitExtra litextra: cache) {
             //If redundant, that doesn't help
             if (!litextra.getOnlyIrredBin())
@@ -2240,13 +2507,13 @@ bool Simplifier::reverse_distillation_of_dummy(
 
             //If (a) was in original clause
             //then (a V b) means -b can be put inside
-            if (!seen[(~otherLit).toInt()]) {
-                toClear.push_back(~otherLit);
-                seen[(~otherLit).toInt()] = 1;
+            if (!sc.seen[(~otherLit).toInt()]) {
+                sc.toClear.push_back(~otherLit);
+                sc.seen[(~otherLit).toInt()] = 1;
             }
 
             //If (a V b) is irred in the clause, then done
-            if (seen[otherLit.toInt()]) {
+            if (sc.seen[otherLit.toInt()]) {
                 return true;
             }
         }
@@ -2258,15 +2525,16 @@ bool Simplifier::reverse_distillation_of_dummy(
 bool Simplifier::subsume_dummy_through_stamping(
     const Watched ps
     , const Watched qs
-) {
+    , ElimScratch& sc
+) const {
     //only if none of the clauses were binary
     //Otherwise we cannot tell if the value in the cache is dependent
     //on the binary clause itself, so that would cause a circular de-
     //pendency
 
     if (!ps.isBinary() && !qs.isBinary()) {
-        aggressive_elim_time_limit -= toClear.size()*5;
-        if (solver->stamp.stampBasedClRem(toClear)) {
+        sc.aggressive_limit -= sc.toClear.size()*5;
+        if (solver->stamp.stampBasedClRem(sc.toClear, sc.stampNorm, sc.stampInv)) {
             return true;
         }
     }
@@ -2279,7 +2547,8 @@ bool Simplifier::resolve_clauses(
     , const Watched qs
     , const Lit posLit
     , const bool aggressive
-) {
+    , ElimScratch& sc
+) const {
     //If clause has already been freed, skip
     if (ps.isClause()
         && solver->cl_alloc.ptr(ps.get_offset())->freed()
@@ -2292,28 +2561,28 @@ bool Simplifier::resolve_clauses(
         return false;
     }
 
-    dummy.clear();
-    assert(toClear.empty());
-    add_pos_lits_to_dummy_and_seen(ps, posLit);
-    bool tautological = add_neg_lits_to_dummy_and_seen(qs, posLit);
-    toClear = dummy;
+    sc.dummy.clear();
+    assert(sc.toClear.empty());
+    add_pos_lits_to_dummy_and_seen(ps, posLit, sc);
+    bool tautological = add_neg_lits_to_dummy_and_seen(qs, posLit, sc);
+    sc.toClear = sc.dummy;
 
     if (!tautological && aggressive) {
-        tautological = reverse_distillation_of_dummy(ps, qs, posLit);
+        tautological = reverse_distillation_of_dummy(ps, qs, posLit, sc);
     }
 
     if (!tautological && aggressive
         && solver->conf.doStamp
         && solver->conf.otfHyperbin
     ) {
-        tautological = subsume_dummy_through_stamping(ps, qs);
+        tautological = subsume_dummy_through_stamping(ps, qs, sc);
     }
 
-    *limit_to_decrease -= (long)toClear.size()/2 + 1;
-    for (const Lit lit: toClear) {
-        seen[lit.toInt()] = 0;
+    sc.limit -= (long)sc.toClear.size()/2 + 1;
+    for (const Lit lit: sc.toClear) {
+        sc.seen[lit.toInt()] = 0;
     }
-    toClear.clear();
+    sc.toClear.clear();
 
     return tautological;
 }
@@ -2396,12 +2665,14 @@ bool Simplifier::aggressiveCheck(
     return false;
 }
 
-Simplifier::HeuristicData Simplifier::calc_data_for_heuristic(const Lit lit)
-{
+Simplifier::HeuristicData Simplifier::calc_data_for_heuristic(
+    const Lit lit
+    , int64_t& limit
+) const {
     HeuristicData ret;
 
     watch_subarray_const ws_list = solver->watches[lit.toInt()];
-    *limit_to_decrease -= (long)ws_list.size()*3 + 100;
+    limit -= (long)ws_list.size()*3 + 100;
     for (const Watched ws: ws_list) {
         //Skip redundant clauses
         if (solver->redundant(ws))
@@ -2624,8 +2895,8 @@ int Simplifier::check_empty_resolvent_action(
 pair<int, int> Simplifier::heuristicCalcVarElimScore(const Var var)
 {
     const Lit lit(var, false);
-    const HeuristicData pos = calc_data_for_heuristic(lit);
-    const HeuristicData neg = calc_data_for_heuristic(~lit);
+    const HeuristicData pos = calc_data_for_heuristic(lit, *limit_to_decrease);
+    const HeuristicData neg = calc_data_for_heuristic(~lit, *limit_to_decrease);
 
     //Estimate cost
     int posTotalLonger = pos.longer + pos.tri;
@@ -2715,7 +2986,12 @@ std::pair<int, int> Simplifier::strategyCalcVarElimScore(const Var var)
     if (solver->conf.var_elim_strategy == elimstrategy_heuristic) {
         cost = heuristicCalcVarElimScore(var);
     } else {
-        int ret = test_elim_and_fill_resolvents(var);
+        ElimScratch& sc = elim_scratch[0];
+        sc.limit = *limit_to_decrease;
+        sc.aggressive_limit = aggressive_elim_time_limit;
+        int ret = test_elim_and_fill_resolvents(var, sc);
+        *limit_to_decrease = sc.limit;
+        aggressive_elim_time_limit = sc.aggressive_limit;
 
         cost.first = ret;
         cost.second = 0;
@@ -2761,6 +3037,8 @@ size_t Simplifier::mem_used() const
     b += negs_gate_parts.capacity()*sizeof(char);
     b += gate_lits_of_elim_cls.capacity()*sizeof(Lit);
     b += dummy.capacity()*sizeof(char);
+    b += to_link.capacity()*sizeof(ClOffset);
+    b += occur_num_added.capacity()*sizeof(uint32_t);
     b += subsumeStrengthen->mem_used();
     for(map<Var, vector<size_t> >::const_iterator
         it = blk_var_to_cl.begin(), end = blk_var_to_cl.end()
@@ -2782,6 +3060,7 @@ size_t Simplifier::mem_used() const
     b += varElimComplexity.capacity()*sizeof(int)*2;
     b += touched.mem_used();
     b += clauses.capacity()*sizeof(ClOffset);
+    b += untouched_clauses.capacity()*sizeof(ClOffset);
 
     return b;
 }
@@ -54,6 +54,7 @@ class GateFinder;
 class XorFinderAbst;
 class SubsumeStrengthen;
 class BVA;
+class BatchWorkers;
 
 struct BlockedClause {
     BlockedClause()
@@ -170,6 +171,7 @@ private:
     friend class BVA;
     BVA* bva;
     bool startup = false;
+    bool incremental = false; ///<Only touch the part of the problem added since the last run
     bool backward_subsume();
 
     //debug
@@ -181,6 +183,7 @@ private:
     bool fill_occur_and_print_stats();
     void finishUp(size_t origTrailSize);
     vector<ClOffset> clauses;
+    vector<ClOffset> untouched_clauses; ///<Not linked in, as nothing has been added to them
 
     //Persistent data
     Solver*  solver;              ///<The solver this simplifier is connected to
@@ -220,11 +223,15 @@ private:
 
         uint64_t cl_linked = 0;
         uint64_t cl_not_linked = 0;
+        uint64_t cl_untouched = 0;
     };
     uint64_t calc_mem_usage_of_occur(const vector<ClOffset>& toAdd) const;
     void     print_mem_usage_of_occur(bool irred, uint64_t memUsage) const;
     void     print_linkin_data(const LinkInData link_in_data) const;
     bool     decide_occur_limit(bool irred, uint64_t memUsage);
+    vector<ClOffset> to_link;
+    vector<uint32_t> occur_num_added;
+    void reserve_occur(const vector<ClOffset>& offsets);
     LinkInData link_in_clauses(
         const vector<ClOffset>& toAdd
         , bool irred
@@ -235,6 +242,9 @@ private:
     //Finish-up
     void remove_by_drup_recently_blocked_clauses(size_t origBlockedSize);
     void add_back_to_solver();
+    void add_back_to_solver(const vector<ClOffset>& cls);
+    bool touched_since_last_run(const Clause& cl) const;
+    void clear_touched_since_last_run();
     bool check_varelim_when_adding_back_cl(const Clause* cl) const;
     void remove_all_longs_from_watches();
     bool complete_clean_clause(Clause& ps);
@@ -295,11 +305,9 @@ private:
 
     TouchList   touched;
     vector<ClOffset> cl_to_free_later;
-    bool        maybe_eliminate(const Var x);
     void        free_clauses_to_free();
     void        try_to_subsume_with_new_bin_or_tri(const vector<Lit>& lits);
     void        create_dummy_blocked_clause(const Lit lit);
-    int         test_elim_and_fill_resolvents(Var var);
     void        mark_gate_in_poss_negs(Lit elim_lit, watch_subarray_const poss, watch_subarray_const negs);
     void        mark_gate_parts(
         Lit elim_lit
@@ -327,7 +335,50 @@ private:
             return lits.size() > other.lits.size();
         }
     };
-    vector<Resolvent> resolvents;
+
+    ///Scratch space of one thread testing variables for elimination
+    struct ElimScratch
+    {
+        vector<uint16_t> seen; ///<Indexed by literal, all-zero between uses
+        vector<Lit> dummy;
+        vector<Lit> toClear;
+        vector<Lit> stampNorm;
+        vector<Lit> stampInv;
+        vector<Resolvent> resolvents;
+        int64_t limit = 0; ///<Time limit, used instead of *limit_to_decrease
+        int64_t aggressive_limit = 0;
+        bool used_aggressive = false;
+    };
+    vector<ElimScratch> elim_scratch;
+    void setup_elim_scratch();
+    int test_elim_and_fill_resolvents(const Var var, ElimScratch& sc);
+
+    ///Variable tested for elimination as part of a batch
+    struct VarElimCand
+    {
+        Var var;
+        int cost = 0; ///<1000 means it must not be eliminated
+        int64_t time_used = 0;
+        int64_t aggressive_time_used = 0;
+        bool used_aggressive = false;
+        vector<Resolvent> resolvents;
+    };
+    vector<VarElimCand> varelim_batch;
+    size_t varelim_batch_size = 0;
+    size_t varelim_batch_trail_size = 0;
+    uint64_t varelim_batches = 0;
+    vector<Var> varelim_batch_marked;
+    bool mark_varelim_neighbourhood(const Var var);
+    void fill_varelim_batch(size_t& wenThrough);
+    void test_varelim_cand(
+        VarElimCand& cand
+        , ElimScratch& sc
+        , const int64_t limit
+        , const int64_t aggressive_limit
+    );
+    void test_varelim_batch(BatchWorkers& workers);
+    bool maybe_eliminate(VarElimCand& cand);
+
     vector<char> poss_gate_parts;
     vector<char> negs_gate_parts;
     bool gate_found_elim;
@@ -354,7 +405,7 @@ private:
         uint32_t lit;
         uint32_t count; //resolution count (if can be counted, otherwise MAX)
     };
-    HeuristicData calc_data_for_heuristic(const Lit lit);
+    HeuristicData calc_data_for_heuristic(const Lit lit, int64_t& limit) const;
     std::pair<int, int> strategyCalcVarElimScore(const Var var);
     uint64_t time_spent_on_calc_otf_update;
     uint64_t num_otf_update_until_now;
@@ -374,24 +425,29 @@ private:
         , const Watched qs
         , const Lit noPosLit
         , const bool useCache
-    );
+        , ElimScratch& sc
+    ) const;
     void add_pos_lits_to_dummy_and_seen(
         const Watched ps
         , const Lit posLit
-    );
+        , ElimScratch& sc
+    ) const;
     bool add_neg_lits_to_dummy_and_seen(
         const Watched qs
         , const Lit posLit
-    );
+        , ElimScratch& sc
+    ) const;
     bool reverse_distillation_of_dummy(
         const Watched ps
         , const Watched qs
         , const Lit posLit
-    );
+        , ElimScratch& sc
+    ) const;
     bool subsume_dummy_through_stamping(
        const Watched ps
         , const Watched qs
-    );
+        , ElimScratch& sc
+    ) const;
     bool aggressiveCheck(
         const Lit lit
         , const Lit noPosLit
@@ -244,6 +244,17 @@ bool Solver::add_xor_clause_inter(
     }
     //cout << "Cleaned ps is: " << ps << endl;
 
+    //Long XORs are propagated natively, there is no DRUP proof for that
+    if (ps.size() > 3
+        && attach
+        && conf.doNativeXor
+        && !drup->enabled()
+    ) {
+        native_xors.push_back(Xor(ps, rhs));
+        attach_native_xor(native_xors.size()-1);
+        return ok;
+    }
+
     if (!ps.empty()) {
         ps[0] ^= rhs;
     } else {
@@ -349,10 +360,124 @@ unsigned Solver::num_bits_set(const size_t x, const unsigned max_size) const
     return bits_set;
 }
 
+/**
+@brief Brings the native XORs up-to-date with the toplevel assignment and the
+replaced variables
+
+XORs that become 3-long or shorter are turned into clauses or units. Must be
+called before anything relies on native XORs only containing unset, active
+variables, e.g. renumbering.
+*/
+bool Solver::clean_xors()
+{
+    if (!ok) {
+        return false;
+    }
+    assert(decisionLevel() == 0);
+    assert(prop_at_head());
+    if (native_xors.empty()) {
+        return true;
+    }
+
+    //Toplevel reasons may point into native_xors, which is about to change
+    for(VarData& dat: varData) {
+        if (dat.reason.getType() == xor_t) {
+            dat.reason = PropBy();
+        }
+    }
+
+    vector<Xor> xors;
+    xors.swap(native_xors);
+    attach_native_xors();
+
+    size_t last_trail_size;
+    do {
+        last_trail_size = trail.size();
+        size_t j = 0;
+        for(size_t i = 0; i < xors.size(); i++) {
+            Xor& x = xors[i];
+
+            //Replace vars and fold the set ones into the rhs
+            size_t k2 = 0;
+            for(const Var var: x.vars) {
+                const Lit lit = varReplacer->get_lit_replaced_with(Lit(var, false));
+                x.rhs ^= lit.sign();
+                if (value(lit.var()) == l_Undef) {
+                    x.vars[k2++] = lit.var();
+                } else {
+                    x.rhs ^= value(lit.var()) == l_True;
+                }
+            }
+            x.vars.resize(k2);
+
+            //The same var twice cancels out
+            std::sort(x.vars.begin(), x.vars.end());
+            k2 = 0;
+            for(size_t k = 0; k < x.vars.size(); k++) {
+                if (k+1 < x.vars.size() && x.vars[k] == x.vars[k+1]) {
+                    k++;
+                    continue;
+                }
+                x.vars[k2++] = x.vars[k];
+            }
+            x.vars.resize(k2);
+
+            switch(x.vars.size()) {
+                case 0:
+                    if (x.rhs) {
+                        ok = false;
+                        return false;
+                    }
+                    break;
+
+                case 1:
+                    enqueue(Lit(x.vars[0], !x.rhs));
+                    break;
+
+                default:
+                    std::swap(xors[j++], x);
+                    break;
+            }
+        }
+        xors.resize(j);
+
+        ok = propagate().isNULL();
+        if (!ok) {
+            return false;
+        }
+    } while (trail.size() != last_trail_size);
+
+    vector<Lit> lits;
+    for(const Xor& x: xors) {
+        if (x.vars.size() > 3) {
+            native_xors.push_back(x);
+            attach_native_xor(native_xors.size()-1);
+            continue;
+        }
+
+        lits.clear();
+        for(const Var var: x.vars) {
+            lits.push_back(Lit(var, false));
+        }
+        if (!add_xor_clause_inter(lits, x.rhs, true, false)) {
+            return false;
+        }
+    }
+
+    return ok;
+}
+
 
 bool Solver::sort_and_clean_clause(vector<Lit>& ps, const vector<Lit>& origCl)
 {
     std::sort(ps.begin(), ps.end());
+    return clean_sorted_clause(ps, origCl);
+}
+
+//Removes false and duplicate literals of the sorted 'ps', in place.
+//Returns false if it is satisfied or a tautology
+bool Solver::clean_sorted_clause(vector<Lit>& ps, const vector<Lit>& origCl)
+{
     Lit p = lit_Undef;
     uint32_t i, j;
     for (i = j = 0; i != ps.size(); i++) {
@@ -397,20 +522,41 @@ Clause* Solver::add_clause_int(
     , bool addDrup
     , const Lit drup_first
 ) {
-    assert(ok);
-    assert(decisionLevel() == 0);
-    assert(!attach || qhead == trail.size());
     #ifdef VERBOSE_DEBUG
     cout << "add_clause_int clause " << lits << endl;
     #endif //VERBOSE_DEBUG
 
+    vector<Lit> ps = lits;
+    std::sort(ps.begin(), ps.end());
+    return add_clause_int_sorted(ps, red, stats, attach, finalLits, addDrup, drup_first);
+}
+
+/**
+@brief Same as add_clause_int(), but 'ps' must be sorted, and is cleaned in place
+
+Saves the copy and the sort of add_clause_int() for callers that have a
+scratch clause that is already sorted.
+*/
+Clause* Solver::add_clause_int_sorted(
+    vector<Lit>& ps
+    , const bool red
+    , ClauseStats stats
+    , const bool attach
+    , vector<Lit>* finalLits
+    , bool addDrup
+    , const Lit drup_first
+) {
+    assert(ok);
+    assert(decisionLevel() == 0);
+    assert(!attach || qhead == trail.size());
+    assert(std::is_sorted(ps.begin(), ps.end()));
+
     //Make stats sane
     #ifdef STATS_NEEDED
     stats.introduced_at_conflict = std::min<uint64_t>(Searcher::sumConflicts(), stats.introduced_at_conflict);
     #endif
 
-    vector<Lit> ps = lits;
-    if (!sort_and_clean_clause(ps, lits)) {
+    if (!clean_sorted_clause(ps, ps)) {
         return NULL;
     }
 
@@ -448,7 +594,7 @@ Clause* Solver::add_clause_int(
             if (conf.verbosity >= 6) {
                 cout
                 << "c solver received clause through addClause(): "
-                << lits
+                << ps
                 << " that became an empty clause at toplevel --> UNSAT"
                 << endl;
             }
@@ -476,6 +622,8 @@ Clause* Solver::add_clause_int(
             if (red)
                 c->makeRed(stats.glue);
             c->stats = stats;
+            if (red)
+                promote_to_mid_tier_if_needed(*c);
 
             //In class 'Simplifier' we don't need to attach normall
             if (attach) {
@@ -720,6 +868,13 @@ bool Solver::addClauseHelper(vector<Lit>& ps)
 }
 
 bool Solver::addClause(const vector<Lit>& lits)
+{
+    vector<Lit> ps = lits;
+    return addClauseInPlace(ps);
+}
+
+//Same as addClause(), but uses (and overwrites) 'ps' as scratch space
+bool Solver::addClauseInPlace(vector<Lit>& ps)
 {
     if (conf.perform_occur_based_simp && simplifier->getAnythingHasBeenBlocked()) {
         std::cerr
@@ -730,26 +885,35 @@ bool Solver::addClause(const vector<Lit>& lits)
     }
 
     #ifdef VERBOSE_DEBUG
-    cout << "Adding clause " << lits << endl;
+    cout << "Adding clause " << ps << endl;
     #endif //VERBOSE_DEBUG
     const size_t origTrailSize = trail.size();
 
-    vector<Lit> ps = lits;
-
     if (!addClauseHelper(ps)) {
         return false;
     }
+    mark_vars_added(ps);
+
+    //Pre-normalized clauses are usually still sorted after renumbering
+    if (!std::is_sorted(ps.begin(), ps.end())) {
+        std::sort(ps.begin(), ps.end());
+    }
 
+    //'ps' is cleaned in place, unless DRUP needs the original clause
     finalCl_tmp.clear();
-    std::sort(ps.begin(), ps.end());
-    Clause* cl = add_clause_int(
-        ps
-        , false //irred
-        , ClauseStats() //default stats
-        , true //yes, attach
-        , &finalCl_tmp
-        , false
-    );
+    Clause* cl;
+    if (drup->enabled()) {
+        cl = add_clause_int(
+            ps
+            , false //irred
+            , ClauseStats() //default stats
+            , true //yes, attach
+            , &finalCl_tmp
+            , false
+        );
+    } else {
+        cl = add_clause_int_sorted(ps, false, ClauseStats(), true, NULL, false);
+    }
 
     //Drup -- We manipulated the clause, delete
     if (drup->enabled()
@@ -1107,6 +1271,29 @@ void Solver::set_assumptions()
     fill_assumptions_set_from(assumptions);
 }
 
+void Solver::apply_frozen_changes()
+{
+    if (frozen_changes.empty()) {
+        return;
+    }
+
+    vector<Lit> lits;
+    for(const std::pair<Var, bool>& change: frozen_changes) {
+        lits.push_back(Lit(change.first, false));
+    }
+    check_too_large_variable_number(lits);
+    back_number_from_outside_to_outer(lits);
+    lits = back_number_from_outside_to_outer_tmp;
+
+    //Brings back eliminated and decomposed variables
+    if (addClauseHelper(lits)) {
+        for(size_t i = 0; i < lits.size(); i++) {
+            varData[lits[i].var()].frozen = frozen_changes[i].second;
+        }
+    }
+    frozen_changes.clear();
+}
+
 void Solver::check_model_for_assumptions() const
 {
     for(const AssumptionPair lit_pair: assumptions) {
@@ -1266,6 +1453,11 @@ void Solver::check_config_parameters() const
         std::cerr << "You MUST give a short term history size (\"--gluehist\")  greater than 0!" << endl;
         exit(-1);
     }
+
+    if (conf.gaussconf.only_nth_gauss_save == 0) {
+        std::cerr << "The Gauss matrix saving period (\"--savematrix\") must be at least 1" << endl;
+        exit(-1);
+    }
 }
 
 lbool Solver::solve()
@@ -1297,7 +1489,12 @@ lbool Solver::solve()
 
     //Clean up as a startup
     datasync->rebuild_bva_map();
+    apply_frozen_changes();
     set_assumptions();
+    if (must_remove_satisfied) {
+        clauseCleaner->remove_and_clean_all();
+        must_remove_satisfied = false;
+    }
     if (simplifier && conf.doStamp) {
         simplifier->clean_stamps_from_uneliminated_vars();
     }
@@ -1456,7 +1653,7 @@ lbool Solver::iterate_until_solved()
     lbool status = l_Undef;
     while (status == l_Undef
         && !must_interrupt_asap()
-        && cpuTime() < conf.maxTime
+        && !out_of_time()
         && sumStats.conflStats.numConflicts < (uint64_t)conf.maxConfl
     ) {
         iteration_num++;
@@ -1499,7 +1696,7 @@ lbool Solver::iterate_until_solved()
 
         //If we are over the limit, exit
         if (sumStats.conflStats.numConflicts >= (uint64_t)conf.maxConfl
-            || cpuTime() > conf.maxTime
+            || out_of_time()
             || must_interrupt_asap()
         ) {
             break;
@@ -1585,8 +1782,6 @@ lbool Solver::simplify_problem(const bool startup)
         && !startup
         && get_num_free_vars() < conf.compVarLimit
         && solveStats.numSimplify >= conf.handlerFromSimpNum
-        //Only every 2nd, since it can be costly to find parts
-        && solveStats.numSimplify % 2 == 0
         && !must_interrupt_asap()
     ) {
         if (!compHandler->handle())
@@ -1623,7 +1818,7 @@ lbool Solver::simplify_problem(const bool startup)
         subsumeImplicit->subsume_implicit();
     }
     if (sumStats.conflStats.numConflicts >= (uint64_t)conf.maxConfl
-        || cpuTime() > conf.maxTime
+        || out_of_time()
         || must_interrupt_asap()
     ) {
         goto end;
@@ -1644,7 +1839,7 @@ lbool Solver::simplify_problem(const bool startup)
         goto end;
     }
     if (sumStats.conflStats.numConflicts >= (uint64_t)conf.maxConfl
-        || cpuTime() > conf.maxTime
+        || out_of_time()
         || must_interrupt_asap()
     ) {
         goto end;
@@ -1664,7 +1859,7 @@ lbool Solver::simplify_problem(const bool startup)
         goto end;
     }
     if (sumStats.conflStats.numConflicts >= (uint64_t)conf.maxConfl
-        || cpuTime() > conf.maxTime
+        || out_of_time()
         || must_interrupt_asap()
     ) {
         goto end;
@@ -1679,7 +1874,7 @@ lbool Solver::simplify_problem(const bool startup)
         }
     }
     if (sumStats.conflStats.numConflicts >= (uint64_t)conf.maxConfl
-        || cpuTime() > conf.maxTime
+        || out_of_time()
         || must_interrupt_asap()
     ) {
         goto end;
@@ -1711,7 +1906,7 @@ lbool Solver::simplify_problem(const bool startup)
         subsumeImplicit->subsume_implicit();
     }
     if (sumStats.conflStats.numConflicts >= (uint64_t)conf.maxConfl
-        || cpuTime() > conf.maxTime
+        || out_of_time()
         || must_interrupt_asap()
     ) {
         goto end;
@@ -1733,7 +1928,7 @@ lbool Solver::simplify_problem(const bool startup)
         goto end;
     }
     if (sumStats.conflStats.numConflicts >= (uint64_t)conf.maxConfl
-        || cpuTime() > conf.maxTime
+        || out_of_time()
         || must_interrupt_asap()
     ) {
         goto end;
@@ -1746,40 +1941,29 @@ lbool Solver::simplify_problem(const bool startup)
         }
     }
 
-    //Delete and disable cache if too large
-    if (conf.doCache) {
-        const size_t memUsedMB = implCache.mem_used()/(1024UL*1024UL);
-        if (memUsedMB > conf.maxCacheSizeMB) {
-            if (conf.verbosity >= 2) {
-                cout
-                << "c Turning off cache, memory used, "
-                << memUsedMB/(1024UL*1024UL) << " MB"
-                << " is over limit of " << conf.maxCacheSizeMB  << " MB"
-                << endl;
-            }
-            implCache.free();
-            vector<LitReachData> tmp;
-            litReachable.swap(tmp);
-            conf.doCache = false;
-        }
-    }
     if (sumStats.conflStats.numConflicts >= (uint64_t)conf.maxConfl
-        || cpuTime() > conf.maxTime
+        || out_of_time()
         || must_interrupt_asap()
     ) {
         goto end;
     }
 
     if (conf.doRenumberVars) {
-        //Clean cache before renumber -- very important, otherwise
-        //we will be left with lits inside the cache that are out-of-bounds
-        if (conf.doCache) {
-            bool setSomething = true;
-            while(setSomething) {
-                if (!implCache.clean(this, &setSomething))
-                    goto end;
+        //Clean cache and native XORs before renumber -- very important,
+        //otherwise we will be left with lits inside them that are out-of-bounds
+        size_t last_trail_size;
+        do {
+            last_trail_size = trail.size();
+            if (conf.doCache) {
+                bool setSomething = true;
+                while(setSomething) {
+                    if (!implCache.clean(this, &setSomething))
+                        goto end;
+                }
             }
-        }
+            if (!clean_xors())
+                goto end;
+        } while (trail.size() != last_trail_size);
 
         renumber_variables();
     }
@@ -1795,6 +1979,9 @@ lbool Solver::simplify_problem(const bool startup)
 
 end:
     update_polarity_and_activity = true;
+    if (ok) {
+        datasync->remove_stale_imported_tris();
+    }
     if (conf.verbosity >= 3) {
         cout << "c Searcher::simplify_problem() finished" << endl;
     }
@@ -1902,6 +2089,8 @@ void Solver::print_stats() const
         , stats_line_percent(sumStats.cpu_time, cpu_time)
         , "% time"
     );
+    cout << "c branch strategy: "
+    << getNameOfBranchStrategy(conf.branch_strategy) << endl;
 
     if (conf.verbStats >= 1) {
         print_all_stats();
@@ -2107,6 +2296,12 @@ void Solver::print_all_stats() const
         implCache.print_stats(this);
     }
 
+    if (datasync->enabled()) {
+        datasync->get_stats().print();
+    }
+
+    cl_alloc.print_stats();
+
     //Other stats
     print_stats_line("c Conflicts in UIP"
         , sumStats.conflStats.numConflicts
@@ -3052,7 +3247,7 @@ void Solver::calculate_reachability()
             continue;
         }
 
-        const vector<LitExtra>& cache = implCache[lit.toInt()].lits;
+        const TransCache cache = implCache[lit.toInt()];
         uint32_t cacheSize = cache.size();
         for (const LitExtra litex: cache) {
             assert(litex.getLit() != lit);
@@ -3170,7 +3365,7 @@ bool Solver::add_clause_outer(const vector<Lit>& lits)
     }
     check_too_large_variable_number(lits);
     back_number_from_outside_to_outer(lits);
-    return addClause(back_number_from_outside_to_outer_tmp);
+    return addClauseInPlace(back_number_from_outside_to_outer_tmp);
 }
 
 bool Solver::add_xor_clause_outer(const vector<Var>& vars, bool rhs)
@@ -3186,12 +3381,129 @@ bool Solver::add_xor_clause_outer(const vector<Var>& vars, bool rhs)
     check_too_large_variable_number(lits);
 
     back_number_from_outside_to_outer(lits);
-    addClauseHelper(back_number_from_outside_to_outer_tmp);
+    xorclauses.push_back(Xor(back_number_from_outside_to_outer_tmp, rhs));
+    if (!addClauseHelper(back_number_from_outside_to_outer_tmp)) {
+        return false;
+    }
+    mark_vars_added(back_number_from_outside_to_outer_tmp);
     add_xor_clause_inter(back_number_from_outside_to_outer_tmp, rhs, true, false);
 
     return ok;
 }
 
+/**
+@brief Reserves watchlist space for a batch of clauses about to be added
+
+A clause is attached by its two smallest literals once it has been mapped to
+the internal numbering and sorted, which is what is counted here. Literals
+that get replaced, set or removed on the way make this an estimate only.
+*/
+void Solver::reserve_watches_for_batch(const Lit* lits, const size_t n)
+{
+    vector<uint32_t> extra(watches.size(), 0);
+    const Lit* end = lits + n;
+    for(const Lit* at = lits; at < end; at++) {
+        Lit smallest[2] = {lit_Undef, lit_Undef};
+        bool usable = true;
+        for(; at < end && *at != lit_Undef; at++) {
+            if (!usable) {
+                continue;
+            }
+            if (at->var() >= nVarsOutside()) {
+                usable = false;
+                continue;
+            }
+            const Lit outer = varReplacer->get_lit_replaced_with_outer(
+                map_to_with_bva(*at));
+            const Lit inter = map_outer_to_inter(outer);
+            if (inter.var() >= nVars()) {
+                usable = false;
+                continue;
+            }
+
+            if (smallest[0] == lit_Undef || inter < smallest[0]) {
+                smallest[1] = smallest[0];
+                smallest[0] = inter;
+            } else if (smallest[1] == lit_Undef || inter < smallest[1]) {
+                smallest[1] = inter;
+            }
+        }
+        if (usable && smallest[1] != lit_Undef) {
+            extra[smallest[0].toInt()]++;
+            extra[smallest[1].toInt()]++;
+        }
+    }
+
+    for(size_t i = 0; i < extra.size(); i++) {
+        if (extra[i] > 0) {
+            watch_subarray ws = watches[i];
+            ws.array.reserve(ws.size() + extra[i]);
+        }
+    }
+}
+
+/**
+@brief Adds a batch of clauses given in the outside numbering
+
+Every clause in lits[0..n) is terminated by lit_Undef. Watchlists are reserved
+up-front. Each clause is copied once, into a scratch buffer that is kept
+between calls, and is renumbered, sorted and cleaned there in place. Only
+DRUP makes a further copy.
+*/
+bool Solver::add_clauses_outer(const Lit* lits, const size_t n)
+{
+    if (!ok) {
+        return false;
+    }
+
+    if (n >= 10000) {
+        reserve_watches_for_batch(lits, n);
+    }
+
+    vector<Lit>& ps = add_clauses_tmp;
+    const Lit* end = lits + n;
+    for(const Lit* at = lits; at < end && ok; at++) {
+        const Lit* cl_end = std::find(at, end, lit_Undef);
+        ps.assign(at, cl_end);
+        at = cl_end;
+        check_too_large_variable_number(ps);
+        for(Lit& lit: ps) {
+            lit = map_to_with_bva(lit);
+        }
+        addClauseInPlace(ps);
+    }
+
+    return ok;
+}
+
+//XOR i is over vars[offsets[i]] .. vars[offsets[i+1]-1], with right-hand side rhs[i]
+bool Solver::add_xor_clauses_outer(
+    const Var* vars
+    , const size_t* offsets
+    , const bool* rhs
+    , const size_t num_xors
+) {
+    vector<Lit> ps;
+    for(size_t i = 0; i < num_xors && ok; i++) {
+        ps.clear();
+        for(size_t at = offsets[i]; at < offsets[i+1]; at++) {
+            ps.push_back(Lit(vars[at], false));
+        }
+        check_too_large_variable_number(ps);
+        for(Lit& lit: ps) {
+            lit = map_to_with_bva(lit);
+        }
+        xorclauses.push_back(Xor(ps, rhs[i]));
+        if (!addClauseHelper(ps)) {
+            break;
+        }
+        mark_vars_added(ps);
+        add_xor_clause_inter(ps, rhs[i], true, false);
+    }
+
+    return ok;
+}
+
 void Solver::check_too_large_variable_number(const vector<Lit>& lits) const
 {
     for (const Lit lit: lits) {
@@ -34,6 +34,7 @@
 #include "GitSHA1.h"
 #include "cleaningstats.h"
 #include "clauseusagestats.h"
+#include "xor.h"
 
 namespace CMSat {
 
@@ -84,8 +85,17 @@ class Solver : public Searcher
         void new_external_vars(size_t n);
         bool add_clause_outer(const vector<Lit>& lits);
         bool add_xor_clause_outer(const vector<Var>& vars, bool rhs);
+        bool add_clauses_outer(const Lit* lits, const size_t n);
+        bool add_xor_clauses_outer(
+            const Var* vars
+            , const size_t* offsets
+            , const bool* rhs
+            , const size_t num_xors
+        );
 
         lbool solve_with_assumptions(const vector<Lit>* _assumptions = NULL);
+        void remove_satisfied_at_next_solve();
+        void set_frozen_outer(const Var var, const bool frozen);
         void  set_shared_data(SharedData* shared_data, uint32_t thread_num);
         lbool model_value (const Lit p) const;  ///<Found model value for lit
         lbool model_value (const Var p) const;  ///<Found model value for var
@@ -145,6 +155,7 @@ class Solver : public Searcher
         DataSync *datasync = NULL;
         ReduceDB* reduceDB = NULL;
         vector<LitReachData> litReachable;
+        vector<Xor> xorclauses;
 
         Stats sumStats;
         PropStats sumPropStats;
@@ -160,12 +171,14 @@ class Solver : public Searcher
 
         uint64_t getNumLongClauses() const;
         bool addClause(const vector<Lit>& ps);
+        bool addClauseInPlace(vector<Lit>& ps);
         bool add_xor_clause_inter(
             const vector< Lit >& lits
             , bool rhs
             , bool attach
             , bool addDrup = true
         );
+        bool clean_xors();
         void new_var(const bool bva = false, const Var orig_outer = std::numeric_limits<Var>::max()) override;
         void new_vars(const size_t n) override;
         void bva_changed();
@@ -217,6 +230,15 @@ class Solver : public Searcher
             , bool addDrup = true
             , const Lit drup_first = lit_Undef
         );
+        Clause* add_clause_int_sorted(
+            vector<Lit>& ps
+            , const bool red = false
+            , const ClauseStats stats = ClauseStats()
+            , const bool attach = true
+            , vector<Lit>* finalLits = NULL
+            , bool addDrup = true
+            , const Lit drup_first = lit_Undef
+        );
         void clear_clauses_stats();
         template<class T> vector<Lit> clauseBackNumbered(const T& cl) const;
         void consolidate_mem();
@@ -224,6 +246,8 @@ class Solver : public Searcher
 
     private:
         friend class Prober;
+        friend class Gaussian;
+        friend class MatrixFinder;
         friend class ClauseDumper;
         lbool iterate_until_solved();
         void parse_sql_option();
@@ -231,7 +255,9 @@ class Solver : public Searcher
         uint64_t mem_used_vardata() const;
 
         vector<Lit> finalCl_tmp;
+        vector<Lit> add_clauses_tmp;
         bool sort_and_clean_clause(vector<Lit>& ps, const vector<Lit>& origCl);
+        bool clean_sorted_clause(vector<Lit>& ps, const vector<Lit>& origCl);
         void set_up_sql_writer();
         vector<std::pair<string, string> > sql_tags;
 
@@ -266,6 +292,7 @@ class Solver : public Searcher
                 assert(back_number_from_outside_to_outer_tmp.back().var() < nVarsOuter());
             }
         }
+        void reserve_watches_for_batch(const Lit* lits, const size_t n);
         void check_switchoff_limits_newvar(size_t n = 1);
         vector<Lit> outside_assumptions;
         void checkDecisionVarCorrectness() const;
@@ -319,6 +346,12 @@ class Solver : public Searcher
         // Data
         size_t               zeroLevAssignsByCNF = 0;
         size_t               zero_level_assigns_by_searcher = 0;
+        bool                 must_remove_satisfied = false;
+
+        //Frozen status changes since the last solve(), outside numbering
+        vector<std::pair<Var, bool> > frozen_changes;
+        void apply_frozen_changes();
+        void mark_vars_added(const vector<Lit>& lits);
         void calculate_reachability();
 
         //Main up stats
@@ -370,6 +403,26 @@ inline const Searcher::Stats& Solver::get_stats() const
     return sumStats;
 }
 
+///Satisfied clauses (e.g. those of a retired clause group, and the learnt
+///clauses derived from them) are removed at the start of the next solve()
+inline void Solver::remove_satisfied_at_next_solve()
+{
+    must_remove_satisfied = true;
+}
+
+///Takes effect at the start of the next solve()
+inline void Solver::set_frozen_outer(const Var var, const bool frozen)
+{
+    frozen_changes.push_back(std::make_pair(var, frozen));
+}
+
+inline void Solver::mark_vars_added(const vector<Lit>& lits)
+{
+    for(const Lit lit: lits) {
+        varData[lit.var()].added_since_simp = true;
+    }
+}
+
 inline const Solver::SolveStats& Solver::get_solve_stats() const
 {
     return solveStats;
@@ -451,7 +504,7 @@ inline bool Solver::find_with_stamp_a_or_b(Lit a, const Lit b) const
 
 inline bool Solver::find_with_cache_a_or_b(Lit a, Lit b, int64_t* limit) const
 {
-    const vector<LitExtra>& cache = solver->implCache[a.toInt()].lits;
+    const TransCache cache = solver->implCache[a.toInt()];
     *limit -= cache.size();
     for (LitExtra cacheLit: cache) {
         if (cacheLit.getOnlyIrredBin()
@@ -463,7 +516,7 @@ inline bool Solver::find_with_cache_a_or_b(Lit a, Lit b, int64_t* limit) const
 
     std::swap(a,b);
 
-    const vector<LitExtra>& cache2 = solver->implCache[a.toInt()].lits;
+    const TransCache cache2 = solver->implCache[a.toInt()];
     *limit -= cache2.size();
     for (LitExtra cacheLit: cache) {
         if (cacheLit.getOnlyIrredBin()
@@ -511,6 +564,7 @@ inline const vector<Lit>& Solver::get_final_conflict() const
 inline void Solver::setConf(const SolverConf _conf)
 {
     conf = _conf;
+    implCache.set_max_mem((size_t)conf.maxCacheSizeMB*1024UL*1024UL);
 }
 
 inline bool Solver::prop_at_head() const
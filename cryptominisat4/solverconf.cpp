@@ -28,9 +28,13 @@ using namespace CMSat;
 
 SolverConf::SolverConf() :
         //Variable activities
-        var_inc_start(1)
+        branch_strategy(branch_vsids)
+        , var_inc_start(1)
         , var_decay_start(0.8)
         , var_decay_max(0.95)
+        , chb_step_start(0.4)
+        , chb_step_min(0.06)
+        , chb_step_decr(0.000001)
         , random_var_freq(0)
         , polarity_mode(polarmode_automatic)
         , do_calc_polarity_first_time(true)
@@ -52,6 +56,8 @@ SolverConf::SolverConf() :
         , lock_uip_per_dbclean(0)
         , multiplier_perf_values_after_cl_clean(0)
         , glue_must_keep_clause_if_below_or_eq(5)
+        , glue_put_mid_tier_if_below_or_eq(8)
+        , every_mid_tier_reduce(10000)
 
         //Restarting
         , restart_first(300)
@@ -63,6 +69,9 @@ SolverConf::SolverConf() :
         , blocking_restart_multip(1.4)
         , local_glue_multiplier(0.80)
         , shortTermHistorySize (50)
+        , diff_declev_for_chrono(-1)
+        , do_trail_reuse(false)
+        , trail_reuse_max_in_row(50)
 
         //Clause minimisation
         , doRecursiveMinim (true)
@@ -86,6 +95,7 @@ SolverConf::SolverConf() :
 
         //Limits
         , maxTime          (std::numeric_limits<double>::max())
+        , maxTimeIsWall    (false)
         , maxConfl         (std::numeric_limits<long>::max())
 
         //Agilities
@@ -134,6 +144,8 @@ SolverConf::SolverConf() :
         , varElimRatioPerIter(0.70)
         , skip_some_bve_resolvents(true)
         , velim_resolvent_too_large(20)
+        , varelim_threads(1)
+        , varelim_batch_size(64)
 
         //Subs, str limits for simplifier
         , subsumption_time_limitM(300)
@@ -151,6 +163,7 @@ SolverConf::SolverConf() :
         , doProbe          (true)
         , doIntreeProbe    (true)
         , probe_bogoprops_time_limitM  (800ULL)
+        , probe_threads    (1)
         , intree_time_limitM(400ULL)
         , intree_scc_varreplace_time_limitM(30ULL)
         , doBothProp       (true)
@@ -178,11 +191,13 @@ SolverConf::SolverConf() :
 
         //Propagation & search
         , propBinFirst     (false)
+        , doNativeXor      (true)
         , dominPickFreq    (0)
 
         //Iterative Alo Scheduling
         , simplify_at_startup(true)
         , simplify_at_every_startup(false)
+        , incremental_simplify(true)
         , regularly_simplify_problem(true)
         , full_simplify_at_startup(false)
         , never_stop_search(false)
@@ -195,6 +210,8 @@ SolverConf::SolverConf() :
         , maxOccurRedMB    (800)
         , maxOccurRedLitLinkedM(50)
         , subsume_gothrough_multip(4.0)
+        , subsume_threads(1)
+        , subsume_batch_size(256)
 
         //Distillation
         , do_distill_clauses(true)
@@ -212,6 +229,7 @@ SolverConf::SolverConf() :
         , handlerFromSimpNum (0)
         , compVarLimit      (1ULL*1000ULL*1000ULL)
         , comp_find_time_limitM (500)
+        , comp_threads      (1)
 
         //Misc optimisations
         , doExtBinSubs     (true)
@@ -238,6 +256,11 @@ SolverConf::SolverConf() :
         , maxDumpRedsSize(std::numeric_limits<uint32_t>::max())
         , origSeed(0)
         , sync_every_confl(6000)
+        , sync_max_glue(3)
+        , sync_max_size(8)
+        , sync_ring_size(1U << 14)
+        , cube_depth(0)
+        , cube_lookahead_cands(100)
         , clean_after_perc_zero_depth_assigns(0.015)
 {
 
@@ -30,6 +30,7 @@ THE SOFTWARE.
 #else
     #include <stdint.h>
 #endif
+#include "gaussianconfig.h"
 
 namespace CMSat {
 
@@ -88,6 +89,33 @@ inline std::string getNameOfCleanType(ClauseCleaningTypes clauseCleaningType)
     return "";
 }
 
+enum BranchStrategy {
+    branch_vsids
+    , branch_vmtf
+    , branch_chb
+};
+
+inline std::string getNameOfBranchStrategy(BranchStrategy strategy)
+{
+    switch(strategy)
+    {
+        case branch_vsids:
+            return "vsids";
+
+        case branch_vmtf:
+            return "vmtf";
+
+        case branch_chb:
+            return "chb";
+
+        default:
+            std::exit(-1);
+            //assert(false);
+
+        return "";
+    }
+}
+
 enum ElimStrategy {
     elimstrategy_heuristic
     , elimstrategy_calculate_exactly
@@ -129,9 +157,13 @@ class SolverConf
         ) const;
 
         //Variable activities
+        BranchStrategy branch_strategy;
         double  var_inc_start;
         double  var_decay_start;
         double  var_decay_max;
+        double  chb_step_start; ///<CHB learning rate at start
+        double  chb_step_min; ///<CHB learning rate is never decreased below this
+        double  chb_step_decr; ///<CHB learning rate decrease per conflict
         double random_var_freq;
         PolarityMode polarity_mode;
         int do_calc_polarity_first_time;
@@ -154,6 +186,8 @@ class SolverConf
         size_t   lock_uip_per_dbclean;
         double   multiplier_perf_values_after_cl_clean;
         unsigned glue_must_keep_clause_if_below_or_eq;
+        unsigned glue_put_mid_tier_if_below_or_eq;
+        unsigned every_mid_tier_reduce; ///<Demote mid tier clauses unused for this many conflicts
 
         //For restarting
         unsigned    restart_first;      ///<The initial restart limit.                                                                (default 100)
@@ -165,6 +199,9 @@ class SolverConf
         double   blocking_restart_multip;
         double   local_glue_multiplier;
         unsigned  shortTermHistorySize; ///< Rolling avg. glue window size
+        int       diff_declev_for_chrono; ///<Backtrack only one level if backjump would be at least this long. -1 = never
+        int       do_trail_reuse; ///<At restart, keep the decisions that would be made again
+        unsigned  trail_reuse_max_in_row; ///<After this many restarts reusing the trail, do a full restart
 
         //Clause minimisation
         int doRecursiveMinim;
@@ -188,6 +225,7 @@ class SolverConf
 
         //Limits
         double   maxTime;
+        int      maxTimeIsWall; ///<maxTime is wall-clock time since start, not CPU time
         long maxConfl;
 
         //Agility
@@ -236,6 +274,8 @@ class SolverConf
         double    varElimRatioPerIter;
         int      skip_some_bve_resolvents;
         int velim_resolvent_too_large; //-1 == no limit
+        unsigned varelim_threads; ///<Threads to calculate resolvents with
+        unsigned varelim_batch_size; ///<Max. number of vars tested together
 
         //Subs, str limits for simplifier
         long long subsumption_time_limitM;
@@ -253,6 +293,7 @@ class SolverConf
         int      doProbe;
         int      doIntreeProbe;
         unsigned long long   probe_bogoprops_time_limitM;
+        unsigned  probe_threads; ///<Threads to look for failed literals with
         unsigned long long   intree_time_limitM;
         unsigned long long intree_scc_varreplace_time_limitM;
         int      doBothProp;
@@ -280,11 +321,13 @@ class SolverConf
 
         //Propagation & searching
         int      propBinFirst;
+        int      doNativeXor; ///<Watch long XORs natively instead of expanding them to CNF
         unsigned  dominPickFreq;
 
         //Iterative Alo Scheduling
         int      simplify_at_startup; //simplify at 1st startup (only)
         int      simplify_at_every_startup; //always simplify at startup, not only at 1st startup
+        int      incremental_simplify; //at startup, only simplify what has been added since the last simplification
         int      regularly_simplify_problem;
         int      full_simplify_at_startup;
         int      never_stop_search;
@@ -297,6 +340,8 @@ class SolverConf
         unsigned maxOccurRedMB;
         unsigned long long maxOccurRedLitLinkedM;
         double   subsume_gothrough_multip;
+        unsigned subsume_threads; ///<Threads to search for subsumed clauses with
+        unsigned subsume_batch_size; ///<Max. number of clauses searched with together
 
         //Distillation
         int      do_distill_clauses;
@@ -313,7 +358,8 @@ class SolverConf
         int       doCompHandler;
         unsigned  handlerFromSimpNum;
         size_t    compVarLimit;
-        unsigned long long  comp_find_time_limitM;
+        unsigned long long  comp_find_time_limitM; ///<Deprecated, not used
+        unsigned  comp_threads; ///<Threads to find and solve the components with
 
 
         //Misc Optimisations
@@ -324,6 +370,9 @@ class SolverConf
         long long  strengthen_implicit_time_limitM;
         int      doCalcReach; ///<Calculate reachability, and influence variable decisions with that
 
+        //Gauss
+        GaussConf gaussconf;
+
         //Gates
         int      doGateFind; ///< Find OR gates
         unsigned maxGateBasedClReduceSize;
@@ -341,6 +390,11 @@ class SolverConf
         unsigned  maxDumpRedsSize; ///<When dumping the redundant clauses, this is the maximum clause size that should be dumped
         unsigned origSeed;
         unsigned long long sync_every_confl;
+        unsigned sync_max_glue; ///<Share learnt clauses with glue at most this
+        unsigned sync_max_size; ///<Share learnt clauses with size at most this
+        unsigned sync_ring_size; ///<Number of clauses in each thread's share ring
+        unsigned cube_depth; ///<If non-zero, threads solve the (at most) 2^cube_depth cubes found by lookahead instead of racing
+        unsigned cube_lookahead_cands; ///<Number of variables looked ahead on at every split
         double clean_after_perc_zero_depth_assigns;
 };
 
@@ -467,6 +467,8 @@ enum class ConflCausedBy {
     , binirred
     , triirred
     , trired
+    , gauss
+    , xorcl
 };
 
 struct ConflStats
@@ -485,6 +487,8 @@ struct ConflStats
         conflsTriRed += other.conflsTriRed;
         conflsLongIrred += other.conflsLongIrred;
         conflsLongRed += other.conflsLongRed;
+        conflsGauss += other.conflsGauss;
+        conflsXor += other.conflsXor;
 
         numConflicts += other.numConflicts;
 
@@ -499,6 +503,8 @@ struct ConflStats
         conflsTriRed -= other.conflsTriRed;
         conflsLongIrred -= other.conflsLongIrred;
         conflsLongRed -= other.conflsLongRed;
+        conflsGauss -= other.conflsGauss;
+        conflsXor -= other.conflsXor;
 
         numConflicts -= other.numConflicts;
 
@@ -526,6 +532,12 @@ struct ConflStats
             case ConflCausedBy::longred :
                 conflsLongRed++;
                 break;
+            case ConflCausedBy::gauss :
+                conflsGauss++;
+                break;
+            case ConflCausedBy::xorcl :
+                conflsXor++;
+                break;
             default:
                 assert(false);
         }
@@ -576,10 +588,21 @@ struct ConflStats
             , "%"
         );
 
+        print_stats_line("c conflsGauss", conflsGauss
+            , stats_line_percent(conflsGauss, numConflicts)
+            , "%"
+        );
+
+        print_stats_line("c conflsXor", conflsXor
+            , stats_line_percent(conflsXor, numConflicts)
+            , "%"
+        );
+
         long diff = (long)numConflicts
             - (long)(conflsBinIrred + (long)conflsBinRed
                 + (long)conflsTriIrred + (long)conflsTriRed
                 + (long)conflsLongIrred + (long)conflsLongRed
+                + (long)conflsGauss + (long)conflsXor
             );
 
         if (diff != 0) {
@@ -603,6 +626,8 @@ struct ConflStats
     uint64_t conflsTriRed = 0;
     uint64_t conflsLongIrred = 0;
     uint64_t conflsLongRed = 0;
+    uint64_t conflsGauss = 0;
+    uint64_t conflsXor = 0;
 
     ///Number of conflicts
     uint64_t  numConflicts = 0;
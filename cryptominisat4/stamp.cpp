@@ -33,19 +33,27 @@ void Stamp::save_on_var_memory(const uint32_t newNumVars)
 
 bool Stamp::stampBasedClRem(
     const vector<Lit>& lits
+) const {
+    return stampBasedClRem(lits, stampNorm, stampInv);
+}
+
+bool Stamp::stampBasedClRem(
+    const vector<Lit>& lits
+    , vector<Lit>& norm
+    , vector<Lit>& inv
 ) const {
     StampSorter sortNorm(tstamp, STAMP_IRRED, false);
     StampSorterInv sortInv(tstamp, STAMP_IRRED, false);
 
-    stampNorm = lits;
-    stampInv = lits;
+    norm = lits;
+    inv = lits;
 
-    std::sort(stampNorm.begin(), stampNorm.end(), sortNorm);
-    std::sort(stampInv.begin(), stampInv.end(), sortInv);
+    std::sort(norm.begin(), norm.end(), sortNorm);
+    std::sort(inv.begin(), inv.end(), sortInv);
 
     assert(lits.size() > 0);
-    vector<Lit>::const_iterator lpos = stampNorm.begin();
-    vector<Lit>::const_iterator lneg = stampInv.begin();
+    vector<Lit>::const_iterator lpos = norm.begin();
+    vector<Lit>::const_iterator lneg = inv.begin();
 
     while(true) {
         if (tstamp[(~*lneg).toInt()].start[STAMP_IRRED]
@@ -53,14 +61,14 @@ bool Stamp::stampBasedClRem(
         ) {
             lpos++;
 
-            if (lpos == stampNorm.end())
+            if (lpos == norm.end())
                 return false;
         } else if (tstamp[(~*lneg).toInt()].end[STAMP_IRRED]
             <= tstamp[lpos->toInt()].end[STAMP_IRRED]
         ) {
             lneg++;
 
-            if (lneg == stampInv.end())
+            if (lneg == inv.end())
                 return false;
         } else {
             return true;
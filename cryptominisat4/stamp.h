@@ -57,6 +57,12 @@ class Stamp
 {
 public:
     bool stampBasedClRem(const vector<Lit>& lits) const;
+    ///Same, but with caller-owned temporaries, so it's thread-safe
+    bool stampBasedClRem(
+        const vector<Lit>& lits
+        , vector<Lit>& norm
+        , vector<Lit>& inv
+    ) const;
     std::pair<size_t, size_t> stampBasedLitRem(
         vector<Lit>& lits
         , StampType stampType
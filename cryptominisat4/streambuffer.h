@@ -26,48 +26,95 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include <zlib.h>
 #endif
 #include <stdio.h>
+#include <future>
+#include <utility>
 
+/**
+@brief Buffered reader over a (possibly compressed) stream
+
+The next chunk is read -- and, for gzip input, decompressed -- on a separate
+thread while the current one is being parsed, so decompression and parsing
+overlap.
+*/
 class StreamBuffer
 {
     #ifdef USE_ZLIB
     gzFile  in;
-    void assureLookahead() {
-        if (pos >= size) {
-            pos  = 0;
-            #ifdef VERBOSE_DEBUG
-            printf("buf = %08X\n", buf);
-            printf("sizeof(buf) = %u\n", sizeof(buf));
-            #endif //VERBOSE_DEBUG
-            size = gzread(in, buf, sizeof(buf));
-        }
+    int read_chunk(char* to) {
+        return gzread(in, to, CHUNK_LIMIT);
     }
     #else
     FILE *  in;
+    int read_chunk(char* to) {
+        return fread(to, 1, CHUNK_LIMIT, in);
+    }
+    #endif
+
+    void start_read_ahead() {
+        char* to = next_buf;
+        next_size = std::async(std::launch::async, [this, to]() {
+            return read_chunk(to);
+        });
+    }
+
     void assureLookahead() {
         if (pos >= size) {
             pos  = 0;
+            if (!next_size.valid()) {
+                size = 0;
+                return;
+            }
+            size = next_size.get();
+            std::swap(buf, next_buf);
             #ifdef VERBOSE_DEBUG
-            printf("buf = %08X\n", buf);
-            printf("sizeof(buf) = %u\n", sizeof(buf));
+            printf("buf = %p\n", (void*)buf);
+            printf("size = %d\n", size);
             #endif //VERBOSE_DEBUG
-            size = fread(buf, 1, sizeof(buf), in);
+            if (size > 0) {
+                start_read_ahead();
+            }
         }
     }
-    #endif
-    char    buf[CHUNK_LIMIT];
+
+    char*   buf;
+    char*   next_buf;
+    std::future<int> next_size;
     int     pos;
     int     size;
 
 public:
     #ifdef USE_ZLIB
-    StreamBuffer(gzFile i) : in(i), pos(0), size(0) {
-        assureLookahead();
-    }
+    StreamBuffer(gzFile i) :
     #else
-    StreamBuffer(FILE * i) : in(i), pos(0), size(0) {
+    StreamBuffer(FILE * i) :
+    #endif
+        in(i)
+        , buf(new char[CHUNK_LIMIT])
+        , next_buf(new char[CHUNK_LIMIT])
+        , pos(0)
+        , size(0)
+    {
+        start_read_ahead();
         assureLookahead();
     }
-    #endif
+
+    ~StreamBuffer() {
+        if (next_size.valid()) {
+            next_size.wait();
+        }
+        delete[] buf;
+        delete[] next_buf;
+    }
+
+    //Must be called before exit(), so no read is left running
+    void wait_read_ahead() {
+        if (next_size.valid()) {
+            next_size.wait();
+        }
+    }
+
+    StreamBuffer(const StreamBuffer&) = delete;
+    StreamBuffer& operator=(const StreamBuffer&) = delete;
 
     int  operator *  () {
         return (pos >= size) ? EOF : buf[pos];
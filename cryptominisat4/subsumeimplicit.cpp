@@ -105,10 +105,10 @@ void SubsumeImplicit::try_subsume_tri(
         && (solver->conf.otfHyperbin || !solver->drup->enabled())
     ) {
         for(size_t at = 0; at < tmplits.size() && !remove; at++) {
-            timeAvailable -= solver->implCache[lit.toInt()].lits.size();
-            for (vector<LitExtra>::const_iterator
-                it2 = solver->implCache[tmplits[at].toInt()].lits.begin()
-                , end2 = solver->implCache[tmplits[at].toInt()].lits.end()
+            timeAvailable -= solver->implCache[lit.toInt()].size();
+            for (const LitExtra
+                *it2 = solver->implCache[tmplits[at].toInt()].begin()
+                , *end2 = solver->implCache[tmplits[at].toInt()].end()
                 ; it2 != end2
                 ; it2++
             ) {
@@ -26,6 +26,7 @@
 #include "clauseallocator.h"
 #include "sqlstats.h"
 #include "solver.h"
+#include "batchworkers.h"
 #include <array>
 
 using namespace CMSat;
@@ -52,6 +53,11 @@ uint32_t SubsumeStrengthen::subsume_and_unlink_and_markirred(const ClOffset offs
         , cl.abst
     );
 
+    return markirred_and_combine_stats(cl, ret);
+}
+
+uint32_t SubsumeStrengthen::markirred_and_combine_stats(Clause& cl, const Sub0Ret& ret)
+{
     //If irred is subsumed by redundant, make the redundant into irred
     if (cl.red()
         && ret.subsumedIrred
@@ -86,14 +92,25 @@ SubsumeStrengthen::Sub0Ret SubsumeStrengthen::subsume_and_unlink(
     , const cl_abst_type abs
     , const bool removeImplicit
 ) {
-    Sub0Ret ret;
-
     subs.clear();
     find_subsumed(offset, ps, abs, subs, removeImplicit);
 
+    return unlink_subsumed(subs);
+}
+
+SubsumeStrengthen::Sub0Ret SubsumeStrengthen::unlink_subsumed(
+    const vector<ClOffset>& subsumed
+) {
+    Sub0Ret ret;
+
     //Go through each clause that can be subsumed
-    for (const ClOffset offs: subs) {
+    for (const ClOffset offs: subsumed) {
         Clause *tmp = solver->cl_alloc.ptr(offs);
+
+        //Removed by a clause that came earlier in the batch
+        if (tmp->freed() || tmp->getRemoved())
+            continue;
+
         ret.stats = ClauseStats::combineStats(tmp->stats, ret.stats);
         #ifdef VERBOSE_DEBUG
         cout << "-> subsume removing:" << *tmp << endl;
@@ -114,32 +131,34 @@ SubsumeStrengthen::Sub0Ret SubsumeStrengthen::subsume_and_unlink(
     return ret;
 }
 
-SubsumeStrengthen::Sub1Ret SubsumeStrengthen::strengthen_subsume_and_unlink_and_markirred(const ClOffset offset)
-{
-    subs.clear();
-    subsLits.clear();
+SubsumeStrengthen::Sub1Ret SubsumeStrengthen::strengthen_subsume_and_unlink_and_markirred(
+    const SubsCand& cand
+) {
     Sub1Ret ret;
-    Clause& cl = *solver->cl_alloc.ptr(offset);
-    assert(!cl.getRemoved());
-
-    if (solver->conf.verbosity >= 6)
-        cout << "strengthen_subsume_and_unlink_and_markirred-ing with clause:" << cl << endl;
-
-    findStrengthened(
-        offset
-        , cl
-        , cl.abst
-        , subs
-        , subsLits
-    );
-
+    const ClOffset offset = cand.offset;
     for (size_t j = 0
-        ; j < subs.size() && solver->okay()
+        ; j < cand.subs.size() && solver->okay()
         ; j++
     ) {
-        ClOffset offset2 = subs[j];
+        //Cleaning a strengthened clause may have removed this one, too
+        Clause& cl = *solver->cl_alloc.ptr(offset);
+        if (cl.freed() || cl.getRemoved())
+            break;
+
+        if (j == 0 && solver->conf.verbosity >= 6)
+            cout << "strengthen_subsume_and_unlink_and_markirred-ing with clause:" << cl << endl;
+
+        ClOffset offset2 = cand.subs[j];
         Clause& cl2 = *solver->cl_alloc.ptr(offset2);
-        if (subsLits[j] == lit_Undef) {  //Subsume
+        if (cl2.freed() || cl2.getRemoved())
+            continue;
+
+        //Either clause may have been strengthened since the search, re-check
+        const Lit litSub = subset1(cl, cl2, *simplifier->limit_to_decrease);
+        if (litSub == lit_Error)
+            continue;
+
+        if (litSub == lit_Undef) {  //Subsume
 
             if (solver->conf.verbosity >= 6)
                 cout << "subsumed clause " << cl2 << endl;
@@ -165,7 +184,7 @@ SubsumeStrengthen::Sub1Ret SubsumeStrengthen::strengthen_subsume_and_unlink_and_
             if (solver->conf.verbosity >= 6) {
                 cout << "strenghtened clause " << cl2 << endl;
             }
-            remove_literal(offset2, subsLits[j]);
+            remove_literal(offset2, litSub);
 
             ret.str++;
             if (!solver->ok)
@@ -180,21 +199,24 @@ SubsumeStrengthen::Sub1Ret SubsumeStrengthen::strengthen_subsume_and_unlink_and_
     return ret;
 }
 
-void SubsumeStrengthen::backward_subsumption_long_with_long()
-{
-    //If clauses are empty, the system below segfaults
-    if (simplifier->clauses.empty())
-        return;
+/**
+@brief Picks the next batch of candidate clauses at random
 
-    double myTime = cpuTime();
-    size_t wenThrough = 0;
-    size_t subsumed = 0;
-    const int64_t orig_limit = simplifier->subsumption_time_limit;
-    simplifier->limit_to_decrease = &simplifier->subsumption_time_limit;
+Only the random picks and the checks for removal are done here, the occur
+lists are searched by find_for_batch().
+*/
+void SubsumeStrengthen::fill_batch(
+    size_t& wenThrough
+    , const double max_through
+    , const int64_t pick_cost
+    , const int64_t cand_cost
+) {
+    batch_size = 0;
     while (*simplifier->limit_to_decrease > 0
-        && (double)wenThrough < solver->conf.subsume_gothrough_multip*(double)simplifier->clauses.size()
+        && (double)wenThrough < max_through
+        && batch_size < std::max<size_t>(1, solver->conf.subsume_batch_size)
     ) {
-        *simplifier->limit_to_decrease -= 3;
+        *simplifier->limit_to_decrease -= pick_cost;
         wenThrough++;
 
         //Print status
@@ -206,15 +228,85 @@ void SubsumeStrengthen::backward_subsumption_long_with_long()
 
         const size_t at = solver->mtrand.randInt(simplifier->clauses.size()-1);
         const ClOffset offset = simplifier->clauses[at];
-        Clause* cl = solver->cl_alloc.ptr(offset);
+        const Clause* cl = solver->cl_alloc.ptr(offset);
 
         //Has already been removed
         if (cl->freed() || cl->getRemoved())
             continue;
 
+        *simplifier->limit_to_decrease -= cand_cost;
+        if (batch.size() == batch_size) {
+            batch.push_back(SubsCand());
+        }
+        batch[batch_size++].offset = offset;
+    }
+}
+
+void SubsumeStrengthen::find_for_cand(
+    SubsCand& cand
+    , const bool strengthen
+    , const int64_t limit
+) const {
+    int64_t my_limit = limit;
+    cand.subs.clear();
+    cand.lits.clear();
+    const Clause& cl = *solver->cl_alloc.ptr(cand.offset);
+    if (strengthen) {
+        findStrengthened(cand.offset, cl, cl.abst, cand.subs, cand.lits, my_limit);
+    } else {
+        find_subsumed_readonly(cand.offset, cl, cl.abst, cand.subs, my_limit);
+    }
+    cand.time_used = limit - my_limit;
+}
+
+/**
+@brief Searches the occur lists for all candidates of the batch
+
+Nothing is changed here and every candidate starts from the same time limit,
+so the outcome is the same whether it runs on one thread or many.
+*/
+void SubsumeStrengthen::find_for_batch(const bool strengthen, BatchWorkers& workers)
+{
+    const int64_t limit = *simplifier->limit_to_decrease;
+    workers.run(batch_size, [&](const size_t i, const size_t) {
+        find_for_cand(batch[i], strengthen, limit);
+    });
+}
+
+void SubsumeStrengthen::backward_subsumption_long_with_long()
+{
+    //If clauses are empty, the system below segfaults
+    if (simplifier->clauses.empty())
+        return;
+
+    double myTime = cpuTime();
+    size_t wenThrough = 0;
+    size_t subsumed = 0;
+    const int64_t orig_limit = simplifier->subsumption_time_limit;
+    simplifier->limit_to_decrease = &simplifier->subsumption_time_limit;
+    const double max_through = solver->conf.subsume_gothrough_multip*(double)simplifier->clauses.size();
+    BatchWorkers workers(std::max<unsigned>(1, solver->conf.subsume_threads));
+    while (*simplifier->limit_to_decrease > 0
+        && (double)wenThrough < max_through
+    ) {
+        fill_batch(wenThrough, max_through, 3, 20);
+        find_for_batch(false, workers);
+
+        for(size_t i = 0
+            ; i < batch_size && *simplifier->limit_to_decrease > 0
+            ; i++
+        ) {
+            const SubsCand& cand = batch[i];
+            *simplifier->limit_to_decrease -= cand.time_used;
+            Clause& cl = *solver->cl_alloc.ptr(cand.offset);
+
+            //Subsumed by a clause that came earlier in the batch
+            if (cl.freed() || cl.getRemoved())
+                continue;
 
-        *simplifier->limit_to_decrease -= 20;
-        subsumed += subsume_and_unlink_and_markirred(offset);
+            Sub0Ret ret = unlink_subsumed(cand.subs);
+            subsumed += markirred_and_combine_stats(cl, ret);
+        }
     }
 
     const double time_used = cpuTime() - myTime;
@@ -253,31 +345,26 @@ bool SubsumeStrengthen::backward_strengthen_long_with_long()
     size_t wenThrough = 0;
     const int64_t orig_limit = simplifier->strengthening_time_limit;
     simplifier->limit_to_decrease = &simplifier->strengthening_time_limit;
+    const double max_through = 1.5*(double)2*simplifier->clauses.size();
     Sub1Ret ret;
+    BatchWorkers workers(std::max<unsigned>(1, solver->conf.subsume_threads));
     while(*simplifier->limit_to_decrease > 0
-        && wenThrough < 1.5*(double)2*simplifier->clauses.size()
+        && (double)wenThrough < max_through
         && solver->okay()
     ) {
-        *simplifier->limit_to_decrease -= 20;
-        wenThrough++;
-
-        //Print status
-        if (solver->conf.verbosity >= 5
-            && wenThrough % 10000 == 0
+        fill_batch(wenThrough, max_through, 20, 0);
+        find_for_batch(true, workers);
+
+        for(size_t i = 0
+            ; i < batch_size
+                && *simplifier->limit_to_decrease > 0
+                && solver->okay()
+            ; i++
         ) {
-            cout << "toDecrease: " << *simplifier->limit_to_decrease << endl;
+            const SubsCand& cand = batch[i];
+            *simplifier->limit_to_decrease -= cand.time_used;
+            ret += strengthen_subsume_and_unlink_and_markirred(cand);
         }
-
-        size_t num = solver->mtrand.randInt(simplifier->clauses.size()-1);
-        ClOffset offset = simplifier->clauses[num];
-        Clause* cl = solver->cl_alloc.ptr(offset);
-
-        //Has already been removed
-        if (cl->freed() || cl->getRemoved())
-            continue;
-
-        ret += strengthen_subsume_and_unlink_and_markirred(offset);
-
     }
 
     const double time_used = cpuTime() - myTime;
@@ -325,10 +412,11 @@ void inline SubsumeStrengthen::fillSubs(
     , vector<ClOffset>& out_subsumed
     , vector<Lit>& out_lits
     , const Lit lit
-) {
+    , int64_t& limit
+) const {
     Lit litSub;
     watch_subarray_const cs = solver->watches[lit.toInt()];
-    *simplifier->limit_to_decrease -= (long)cs.size()*15 + 40;
+    limit -= (long)cs.size()*15 + 40;
     for (watch_subarray_const::const_iterator
         it = cs.begin(), end = cs.end()
         ; it != end
@@ -351,8 +439,8 @@ void inline SubsumeStrengthen::fillSubs(
             continue;
         }
 
-        *simplifier->limit_to_decrease -= (long)cl.size() + (long)cl2.size();
-        litSub = subset1(cl, cl2);
+        limit -= (long)cl.size() + (long)cl2.size();
+        litSub = subset1(cl, cl2, limit);
         if (litSub != lit_Error) {
             out_subsumed.push_back(it->get_offset());
             out_lits.push_back(litSub);
@@ -389,7 +477,8 @@ void SubsumeStrengthen::findStrengthened(
     , const cl_abst_type abs
     , vector<ClOffset>& out_subsumed
     , vector<Lit>& out_lits
-)
+    , int64_t& limit
+) const
 {
     #ifdef VERBOSE_DEBUG
     cout << "findStrengthened: " << cl << endl;
@@ -408,10 +497,10 @@ void SubsumeStrengthen::findStrengthened(
         }
     }
     assert(minVar != var_Undef);
-    *simplifier->limit_to_decrease -= (long)cl.size();
+    limit -= (long)cl.size();
 
-    fillSubs(offset, cl, abs, out_subsumed, out_lits, Lit(minVar, true));
-    fillSubs(offset, cl, abs, out_subsumed, out_lits, Lit(minVar, false));
+    fillSubs(offset, cl, abs, out_subsumed, out_lits, Lit(minVar, true), limit);
+    fillSubs(offset, cl, abs, out_subsumed, out_lits, Lit(minVar, false), limit);
 }
 
 void SubsumeStrengthen::remove_literal(ClOffset offset, const Lit toRemoveLit)
@@ -446,14 +535,14 @@ For A to subsume B, everything that is in A MUST be in B. So, if (A & ~B)
 contains even one bit, it means that A contains something that B doesn't. So
 A may be a subset of B only if (A & ~B) == 0
 */
-bool SubsumeStrengthen::subsetAbst(const cl_abst_type A, const cl_abst_type B)
+bool SubsumeStrengthen::subsetAbst(const cl_abst_type A, const cl_abst_type B) const
 {
     return ((A & ~B) == 0);
 }
 
 //A subsumes B (A <= B)
 template<class T1, class T2>
-bool SubsumeStrengthen::subset(const T1& A, const T2& B)
+bool SubsumeStrengthen::subset(const T1& A, const T2& B, int64_t& limit) const
 {
     #ifdef MORE_DEUBUG
     cout << "A:" << A << endl;
@@ -494,7 +583,7 @@ bool SubsumeStrengthen::subset(const T1& A, const T2& B)
     ret = false;
 
     end:
-    *simplifier->limit_to_decrease -= (long)i2*4 + (long)i*4;
+    limit -= (long)i2*4 + (long)i*4;
     return ret;
 }
 
@@ -512,7 +601,7 @@ clause B
 and returns the literal to remove if (2) is true
 */
 template<class T1, class T2>
-Lit SubsumeStrengthen::subset1(const T1& A, const T2& B)
+Lit SubsumeStrengthen::subset1(const T1& A, const T2& B, int64_t& limit) const
 {
     Lit retLit = lit_Undef;
 
@@ -544,13 +633,15 @@ Lit SubsumeStrengthen::subset1(const T1& A, const T2& B)
     retLit = lit_Error;
 
     end:
-    *simplifier->limit_to_decrease -= (long)i2*4 + (long)i*4;
+    limit -= (long)i2*4 + (long)i*4;
     return retLit;
 }
 
 template<class T>
-size_t SubsumeStrengthen::find_smallest_watchlist_for_clause(const T& ps) const
-{
+size_t SubsumeStrengthen::find_smallest_watchlist_for_clause(
+    const T& ps
+    , int64_t& limit
+) const {
     size_t min_i = 0;
     size_t min_num = solver->watches[ps[min_i].toInt()].size();
     for (uint32_t i = 1; i < ps.size(); i++){
@@ -560,7 +651,7 @@ size_t SubsumeStrengthen::find_smallest_watchlist_for_clause(const T& ps) const
             min_num = this_num;
         }
     }
-    *simplifier->limit_to_decrease -= (long)ps.size();
+    limit -= (long)ps.size();
 
     return min_i;
 }
@@ -586,12 +677,21 @@ template<class T> void SubsumeStrengthen::find_subsumed(
     cout << endl;
     #endif
 
-    const size_t smallest = find_smallest_watchlist_for_clause(ps);
+    //Only a binary clause can subsume implicit clauses
+    if (removeImplicit && ps.size() == 2) {
+        remove_implicit_subsumed(ps);
+    }
 
-    //Go through the occur list of the literal that has the smallest occur list
-    watch_subarray occ = solver->watches[ps[smallest].toInt()];
-    *simplifier->limit_to_decrease -= (long)occ.size()*8 + 40;
+    find_subsumed_readonly(offset, ps, abs, out_subsumed, *simplifier->limit_to_decrease);
+}
+
+template<class T>
+void SubsumeStrengthen::remove_implicit_subsumed(const T& ps)
+{
+    assert(ps.size() == 2);
+    const size_t smallest = find_smallest_watchlist_for_clause(ps, *simplifier->limit_to_decrease);
 
+    watch_subarray occ = solver->watches[ps[smallest].toInt()];
     watch_subarray::iterator it = occ.begin();
     watch_subarray::iterator it2 = occ.begin();
     size_t numBinFound = 0;
@@ -600,78 +700,91 @@ template<class T> void SubsumeStrengthen::find_subsumed(
         ; it != end
         ; ++it
     ) {
-        if (removeImplicit) {
-            if (it->isBinary()
-                && ps.size() == 2
-                && ps[!smallest] == it->lit2()
-                && !it->red()
-            ) {
-                /*cout
-                << "ps " << ps << " could subsume this bin: "
-                << ps[smallest] << ", " << it->lit2()
-                << endl;*/
-                numBinFound++;
-
-                //We cannot remove ourselves
-                if (numBinFound > 1) {
-                    removeWBin(solver->watches, it->lit2(), ps[smallest], it->red());
-                    solver->binTri.irredBins--;
-                    continue;
-                }
+        if (it->isBinary()
+            && ps[!smallest] == it->lit2()
+            && !it->red()
+        ) {
+            /*cout
+            << "ps " << ps << " could subsume this bin: "
+            << ps[smallest] << ", " << it->lit2()
+            << endl;*/
+            numBinFound++;
+
+            //We cannot remove ourselves
+            if (numBinFound > 1) {
+                removeWBin(solver->watches, it->lit2(), ps[smallest], it->red());
+                solver->binTri.irredBins--;
+                continue;
             }
+        }
 
-            if (it->isTri()
-                && ps.size() == 2
-                && (ps[!smallest] == it->lit2() || ps[!smallest] == it->lit3())
-            ) {
-                /*cout
-                << "ps " << ps << " could subsume this tri: "
-                << ps[smallest] << ", " << it->lit2() << ", " << it->lit3()
-                << endl;
-                */
-                Lit lits[3];
-                lits[0] = ps[smallest];
-                lits[1] = it->lit2();
-                lits[2] = it->lit3();
-                std::sort(lits + 0, lits + 3);
-                removeTriAllButOne(solver->watches, ps[smallest], lits, it->red());
-                if (it->red()) {
-                    solver->binTri.redTris--;
-                } else {
-                    solver->binTri.irredTris--;
-                }
-                continue;
+        if (it->isTri()
+            && (ps[!smallest] == it->lit2() || ps[!smallest] == it->lit3())
+        ) {
+            /*cout
+            << "ps " << ps << " could subsume this tri: "
+            << ps[smallest] << ", " << it->lit2() << ", " << it->lit3()
+            << endl;
+            */
+            Lit lits[3];
+            lits[0] = ps[smallest];
+            lits[1] = it->lit2();
+            lits[2] = it->lit3();
+            std::sort(lits + 0, lits + 3);
+            removeTriAllButOne(solver->watches, ps[smallest], lits, it->red());
+            if (it->red()) {
+                solver->binTri.redTris--;
+            } else {
+                solver->binTri.irredTris--;
             }
+            continue;
         }
         *it2++ = *it;
+    }
+    occ.shrink(it-it2);
+}
 
-        if (!it->isClause()) {
+template<class T>
+void SubsumeStrengthen::find_subsumed_readonly(
+    const ClOffset offset
+    , const T& ps
+    , const cl_abst_type abs
+    , vector<ClOffset>& out_subsumed
+    , int64_t& limit
+) const {
+    const size_t smallest = find_smallest_watchlist_for_clause(ps, limit);
+
+    //Go through the occur list of the literal that has the smallest occur list
+    watch_subarray_const occ = solver->watches[ps[smallest].toInt()];
+    limit -= (long)occ.size()*8 + 40;
+
+    for (const Watched& w: occ) {
+        if (!w.isClause()) {
             continue;
         }
 
-        *simplifier->limit_to_decrease -= 15;
+        limit -= 15;
 
-        if (it->get_offset() == offset
-            || !subsetAbst(abs, it->getAbst())
+        if (w.get_offset() == offset
+            || !subsetAbst(abs, w.getAbst())
         ) {
             continue;
         }
 
-        const ClOffset offset2 = it->get_offset();
+        const ClOffset offset2 = w.get_offset();
         const Clause& cl2 = *solver->cl_alloc.ptr(offset2);
 
         if (ps.size() > cl2.size() || cl2.getRemoved())
             continue;
 
-        *simplifier->limit_to_decrease -= 50;
-        if (subset(ps, cl2)) {
+        limit -= 50;
+        if (subset(ps, cl2, limit)) {
             out_subsumed.push_back(offset2);
             #ifdef VERBOSE_DEBUG
             cout << "subsumed cl offset: " << offset2 << endl;
             #endif
         }
     }
-    occ.shrink(it-it2);
 }
 template void SubsumeStrengthen::find_subsumed(
     const ClOffset offset
@@ -685,7 +798,11 @@ size_t SubsumeStrengthen::mem_used() const
 {
     size_t b = 0;
     b += subs.capacity()*sizeof(ClOffset);
-    b += subsLits.capacity()*sizeof(Lit);
+    b += batch.capacity()*sizeof(SubsCand);
+    for(const SubsCand& cand: batch) {
+        b += cand.subs.capacity()*sizeof(ClOffset);
+        b += cand.lits.capacity()*sizeof(Lit);
+    }
 
     return b;
 }
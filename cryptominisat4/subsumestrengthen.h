@@ -34,6 +34,7 @@ namespace CMSat {
 class Simplifier;
 class GateFinder;
 class Solver;
+class BatchWorkers;
 
 class SubsumeStrengthen
 {
@@ -114,7 +115,20 @@ private:
     void remove_literal(ClOffset c, const Lit toRemoveLit);
 
     template<class T>
-    size_t find_smallest_watchlist_for_clause(const T& ps) const;
+    size_t find_smallest_watchlist_for_clause(const T& ps, int64_t& limit) const;
+
+    template<class T>
+    void remove_implicit_subsumed(const T& ps);
+
+    //Only reads the occur lists, may be called from many threads at once
+    template<class T>
+    void find_subsumed_readonly(
+        const ClOffset offset
+        , const T& ps
+        , const cl_abst_type abs
+        , vector<ClOffset>& out_subsumed
+        , int64_t& limit
+    ) const;
 
     template<class T>
     void findStrengthened(
@@ -123,7 +137,8 @@ private:
         , const cl_abst_type abs
         , vector<ClOffset>& out_subsumed
         , vector<Lit>& out_lits
-    );
+        , int64_t& limit
+    ) const;
 
     template<class T>
     void fillSubs(
@@ -133,18 +148,41 @@ private:
         , vector<ClOffset>& out_subsumed
         , vector<Lit>& out_lits
         , const Lit lit
-    );
+        , int64_t& limit
+    ) const;
 
     template<class T1, class T2>
-    bool subset(const T1& A, const T2& B);
+    bool subset(const T1& A, const T2& B, int64_t& limit) const;
 
     template<class T1, class T2>
-    Lit subset1(const T1& A, const T2& B);
-    bool subsetAbst(const cl_abst_type A, const cl_abst_type B);
-    Sub1Ret strengthen_subsume_and_unlink_and_markirred(ClOffset offset);
+    Lit subset1(const T1& A, const T2& B, int64_t& limit) const;
+    bool subsetAbst(const cl_abst_type A, const cl_abst_type B) const;
+
+    Sub0Ret unlink_subsumed(const vector<ClOffset>& subsumed);
+    uint32_t markirred_and_combine_stats(Clause& cl, const Sub0Ret& ret);
+
+    //Candidate clauses are picked serially, their subsumed/strengthened
+    //clauses are searched for in parallel, then the changes are made
+    //serially, in the order the candidates were picked
+    struct SubsCand {
+        ClOffset offset;
+        int64_t time_used = 0;
+        vector<ClOffset> subs;
+        vector<Lit> lits;
+    };
+    vector<SubsCand> batch;
+    size_t batch_size = 0;
+    void fill_batch(
+        size_t& wenThrough
+        , const double max_through
+        , const int64_t pick_cost
+        , const int64_t cand_cost
+    );
+    void find_for_batch(const bool strengthen, BatchWorkers& workers);
+    void find_for_cand(SubsCand& cand, const bool strengthen, const int64_t limit) const;
+    Sub1Ret strengthen_subsume_and_unlink_and_markirred(const SubsCand& cand);
 
     vector<ClOffset> subs;
-    vector<Lit> subsLits;
 };
 
 inline const SubsumeStrengthen::Stats& SubsumeStrengthen::getRunStats() const
@@ -34,14 +34,43 @@ THE SOFTWARE.
 
 #if defined (_MSC_VER) || defined(CROSS_COMPILE)
 #include <ctime>
+#include <chrono>
 static inline double cpuTime(void)
 {
     return (double)clock() / CLOCKS_PER_SEC;
 }
+
+static inline double wallTime(void)
+{
+    return std::chrono::duration<double>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
 #else //_MSC_VER
 #include <sys/time.h>
 #include <sys/resource.h>
 #include <unistd.h>
+#include <time.h>
+
+//Monotonic wall-clock time. The coarse clock is only a few milliseconds
+//precise, but it is read without a system call, so it can be checked often
+static inline double wallTime(void)
+{
+    struct timespec ts;
+    #ifdef CLOCK_MONOTONIC_COARSE
+    int ret = clock_gettime(CLOCK_MONOTONIC_COARSE, &ts);
+    #else
+    int ret = clock_gettime(CLOCK_MONOTONIC, &ts);
+    #endif
+
+    assert(ret == 0);
+
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000.0;
+}
+
+#ifdef RUSAGE_THREAD
+//cpuTime() is that of the calling thread only
+#define CPU_TIME_IS_PER_THREAD
+#endif
 
 static inline double cpuTime(void)
 {
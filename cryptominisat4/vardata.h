@@ -79,6 +79,9 @@ struct VarData
         , polarity(false)
         , is_decision(true)
         , is_bva(false)
+        , frozen(false)
+        , added_since_simp(false)
+        , in_xor(false)
     {}
 
     ///contains the decision level at which the assignment was made.
@@ -97,6 +100,15 @@ struct VarData
     bool polarity;
     bool is_decision;
     bool is_bva;
+
+    ///Never eliminated or decomposed away, as it will be used again
+    bool frozen;
+
+    ///Occurs in a clause added since the last occurrence-based simplification
+    bool added_since_simp;
+
+    ///Occurs in a native XOR, so never eliminated or decomposed away
+    bool in_xor;
 };
 
 }
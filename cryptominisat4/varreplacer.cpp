@@ -149,6 +149,9 @@ void VarReplacer::update_vardata_and_activities(
 
     solver->unset_decision_var(orig);
     solver->set_decision_var(replaced_with);
+    if (solver->varData[orig].frozen) {
+        solver->varData[replaced_with].frozen = true;
+    }
 }
 
 bool VarReplacer::enqueueDelayedEnqueue()
@@ -260,6 +263,11 @@ bool VarReplacer::perform_replace()
         goto end;
     }
 
+    //Native XORs still contain the replaced vars
+    if (!solver->clean_xors()) {
+        goto end;
+    }
+
     solver->update_assumptions_after_varreplace();
 
 end:
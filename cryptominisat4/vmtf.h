@@ -0,0 +1,207 @@
+/*
+ * CryptoMiniSat
+ *
+ * Copyright (c) 2009-2014, Mate Soos. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation
+ * version 2.0 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+*/
+
+#ifndef __VMTF_H__
+#define __VMTF_H__
+
+#include "solvertypesmini.h"
+#include "varupdatehelper.h"
+#include <vector>
+#include <algorithm>
+#include <cassert>
+using std::vector;
+
+namespace CMSat {
+
+/**
+@brief Variable move-to-front queue, as per Biere and Froehlich, SAT'15
+
+Variables are kept in a doubly linked list, ordered by the time they were
+last bumped. Bumping moves the variable to the end of the list in O(1). All
+variables after 'unassigned' are assigned or are not decision variables, so
+looking for the next decision starts there and walks towards the start of the
+list.
+*/
+class VmtfQueue
+{
+public:
+    void new_var()
+    {
+        const Var var = btab.size();
+        btab.push_back(0);
+        if (linked) {
+            links.push_back(Link());
+            enqueue(var);
+            update_unassigned(var);
+        }
+    }
+
+    //Moves the variables to the end of the queue, keeping their relative order
+    void bump(vector<Var>& vars)
+    {
+        assert(linked);
+        std::sort(vars.begin(), vars.end(), [&](const Var a, const Var b) {
+            return btab[a] < btab[b];
+        });
+        for(const Var var: vars) {
+            if (var == last) {
+                continue;
+            }
+            dequeue(var);
+            enqueue(var);
+        }
+    }
+
+    //Must be called when var becomes unassigned or a decision variable
+    void update_unassigned(const Var var)
+    {
+        if (linked
+            && (unassigned == var_Undef || btab[var] > btab[unassigned])
+        ) {
+            unassigned = var;
+        }
+    }
+
+    Var get_unassigned() const
+    {
+        return (unassigned != var_Undef) ? unassigned : last;
+    }
+
+    void set_unassigned(const Var var)
+    {
+        unassigned = var;
+    }
+
+    Var prev(const Var var) const
+    {
+        return links[var].prev;
+    }
+
+    uint64_t bumped_at(const Var var) const
+    {
+        return btab[var];
+    }
+
+    bool is_linked() const
+    {
+        return linked;
+    }
+
+    //Re-links all variables in the order of their last bump
+    void rebuild()
+    {
+        vector<Var> vars(btab.size());
+        for(size_t i = 0; i < vars.size(); i++) {
+            vars[i] = i;
+        }
+        std::stable_sort(vars.begin(), vars.end(), [&](const Var a, const Var b) {
+            return btab[a] < btab[b];
+        });
+
+        links.clear();
+        links.resize(btab.size());
+        first = last = unassigned = var_Undef;
+        stamp = 0;
+        for(const Var var: vars) {
+            enqueue(var);
+        }
+        unassigned = last;
+        linked = true;
+    }
+
+    void update_vars(const vector<uint32_t>& interToOuter)
+    {
+        updateArray(btab, interToOuter);
+        unlink();
+    }
+
+    void shrink(const size_t num_vars)
+    {
+        btab.resize(num_vars);
+        btab.shrink_to_fit();
+        unlink();
+    }
+
+    size_t mem_used() const
+    {
+        return btab.capacity()*sizeof(uint64_t)
+            + links.capacity()*sizeof(Link);
+    }
+
+private:
+    struct Link {
+        Var prev = var_Undef;
+        Var next = var_Undef;
+    };
+
+    vector<uint64_t> btab; ///<When the variable was last moved to the end
+    vector<Link> links;
+    Var first = var_Undef;
+    Var last = var_Undef;
+    Var unassigned = var_Undef;
+    uint64_t stamp = 0;
+    bool linked = false;
+
+    void unlink()
+    {
+        links.clear();
+        links.shrink_to_fit();
+        first = last = unassigned = var_Undef;
+        linked = false;
+    }
+
+    void enqueue(const Var var)
+    {
+        Link& l = links[var];
+        l.prev = last;
+        l.next = var_Undef;
+        if (last != var_Undef) {
+            links[last].next = var;
+        } else {
+            first = var;
+        }
+        last = var;
+        btab[var] = ++stamp;
+    }
+
+    void dequeue(const Var var)
+    {
+        Link& l = links[var];
+        if (unassigned == var) {
+            unassigned = (l.prev != var_Undef) ? l.prev : l.next;
+        }
+        if (l.prev != var_Undef) {
+            links[l.prev].next = l.next;
+        } else {
+            first = l.next;
+        }
+        if (l.next != var_Undef) {
+            links[l.next].prev = l.prev;
+        } else {
+            last = l.prev;
+        }
+        l.prev = l.next = var_Undef;
+    }
+};
+
+} //end namespace
+
+#endif //__VMTF_H__
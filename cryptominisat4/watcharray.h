@@ -105,6 +105,11 @@ struct watch_subarray
         array.push_back(watched);
     }
 
+    void reserve(const size_t num)
+    {
+        array.reserve(num);
+    }
+
     typedef Watched* iterator;
     typedef const Watched* const_iterator;
 };
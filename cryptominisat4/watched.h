@@ -48,6 +48,10 @@ This class contains two 32-bit datapieces. They are either used as:
 \li Two literals, in the case of tertiary clauses
 \li One blocking literal (i.e. an example literal from the clause) and a clause
 offset (as per ClauseAllocator ), in the case of normal clauses
+
+With WATCH_TWO_BLOCKERS, normal clauses also carry a second blocking literal,
+making the watch 12 bytes. The clause then only needs to be dereferenced if
+neither blocking literal is satisfied.
 */
 class Watched {
     public:
@@ -58,9 +62,25 @@ class Watched {
             data1(blockedLit.toInt())
             , type(watch_clause_t)
             , data2(offset)
+            #ifdef WATCH_TWO_BLOCKERS
+            , data3(blockedLit.toInt())
+            #endif
         {
         }
 
+        #ifdef WATCH_TWO_BLOCKERS
+        /**
+        @brief Constructor for a long (>3) clause with two blocked literals
+        */
+        Watched(const ClOffset offset, Lit blockedLit, Lit blockedLit2) :
+            data1(blockedLit.toInt())
+            , type(watch_clause_t)
+            , data2(offset)
+            , data3(blockedLit2.toInt())
+        {
+        }
+        #endif
+
         /**
         @brief Constructor for a long (>3) clause
         */
@@ -256,6 +276,24 @@ class Watched {
             return Lit::toLit(data1);
         }
 
+        #ifdef WATCH_TWO_BLOCKERS
+        Lit getBlockedLit2() const
+        {
+            #ifdef DEBUG_WATCHED
+            assert(isClause());
+            #endif
+            return Lit::toLit(data3);
+        }
+
+        void setBlockedLit2(const Lit blockedLit)
+        {
+            #ifdef DEBUG_WATCHED
+            assert(type == watch_clause_t);
+            #endif
+            data3 = blockedLit.toInt();
+        }
+        #endif
+
         cl_abst_type getAbst() const
         {
             #ifdef DEBUG_WATCHED
@@ -343,6 +381,10 @@ class Watched {
         //binary, tertiary or long, as per WatchType
         uint32_t type:2;
         uint32_t data2:30;
+        #ifdef WATCH_TWO_BLOCKERS
+        //Second blocked literal of a long clause, not part of operator==
+        uint32_t data3 = 0;
+        #endif
 };
 
 inline std::ostream& operator<<(std::ostream& os, const Watched& ws)
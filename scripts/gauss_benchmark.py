@@ -0,0 +1,135 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# Copyright (C) 2014  Mate Soos
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; version 2
+# of the License.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+from __future__ import print_function
+import subprocess
+import optparse
+import os
+import re
+import math
+import glob
+
+usage = "usage: %prog [options] CNF files or directories"
+desc = """Measures conflicts per second and total solving time on XOR-rich
+instances (XORs given as "x" lines) with Gaussian elimination on and off:
+
+   ./gauss_benchmark.py --solver ../build/cryptominisat --maxconfl 200000 \\
+       ~/cnfs/crypto/
+"""
+
+parser = optparse.OptionParser(usage=usage, description=desc)
+parser.add_option("--solver", dest="solver", default="../build/cryptominisat",
+                  help="Solver executable. Default: %default")
+parser.add_option("--maxconfl", dest="maxconfl", default=200000, type=int,
+                  help="Conflict limit for each run. Default: %default")
+parser.add_option("--repeat", dest="repeat", default=1, type=int,
+                  help="Runs per instance, the best one counts. Default: %default")
+parser.add_option("--extraopts", dest="extraopts", default="",
+                  help="Extra options to pass to the solver")
+
+# First "c conflicts" line is that of the search
+confl_re = re.compile(r"^c conflicts\s*:\s*\S+\s*\(\s*(\S+)\s*/ sec\)")
+time_re = re.compile(r"^c Total time\s*:\s*(\S+)")
+
+
+def run_solver(fname, options, gauss):
+    command = [options.solver, "--threads", "1", "--verbstat", "1",
+               "--maxconfl", str(options.maxconfl)]
+    if not gauss:
+        command += ["--gaussuntil", "0"]
+    command += options.extraopts.split()
+    command.append(fname)
+
+    best = None
+    for _ in range(options.repeat):
+        p = subprocess.Popen(command, stdout=subprocess.PIPE,
+                             universal_newlines=True)
+        out = p.communicate()[0]
+        confl_per_sec = None
+        total_time = None
+        solved = False
+        for line in out.split("\n"):
+            m = confl_re.match(line)
+            if m and confl_per_sec is None:
+                confl_per_sec = float(m.group(1))
+            m = time_re.match(line)
+            if m:
+                total_time = float(m.group(1))
+            if line.startswith("s ") and "INDETERMINATE" not in line:
+                solved = True
+
+        if total_time is None:
+            continue
+        if best is None or total_time < best[1]:
+            best = (confl_per_sec, total_time, solved)
+
+    return best
+
+
+def collect_files(args):
+    files = []
+    for arg in args:
+        if os.path.isdir(arg):
+            files += sorted(glob.glob(os.path.join(arg, "*.cnf")))
+            files += sorted(glob.glob(os.path.join(arg, "*.cnf.gz")))
+        else:
+            files.append(arg)
+    return files
+
+
+def geomean(vals):
+    vals = [v for v in vals if v is not None and v > 0]
+    if not vals:
+        return 0.0
+    return math.exp(sum(math.log(v) for v in vals) / len(vals))
+
+
+def fmt(res):
+    if res is None:
+        return "%10s %9s" % ("-", "-")
+    confl = "-" if res[0] is None else "%.0f" % res[0]
+    solved = "" if res[2] else "*"
+    return "%10s %8.2f%1s" % (confl, res[1], solved)
+
+
+if __name__ == "__main__":
+    (options, args) = parser.parse_args()
+    files = collect_files(args)
+    if not files:
+        parser.error("no CNF files given")
+
+    print("%-40s %10s %9s %10s %9s" % (
+        "", "gauss c/s", "time", "plain c/s", "time"))
+
+    results = [[], []]
+    for fname in files:
+        line = "%-40s" % os.path.basename(fname)
+        for i, gauss in enumerate([True, False]):
+            res = run_solver(fname, options, gauss)
+            results[i].append(res)
+            line += " " + fmt(res)
+        print(line)
+
+    line = "%-40s" % "geometric mean"
+    for res in results:
+        line += " %10.0f %9.2f" % (
+            geomean([r[0] for r in res if r is not None]),
+            geomean([r[1] for r in res if r is not None]))
+    print(line)
+    print("'*': conflict limit reached before solving")
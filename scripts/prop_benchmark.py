@@ -0,0 +1,119 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+# Copyright (C) 2014  Mate Soos
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU General Public License
+# as published by the Free Software Foundation; version 2
+# of the License.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA.
+
+from __future__ import print_function
+import subprocess
+import optparse
+import os
+import re
+import math
+import glob
+
+usage = "usage: %prog [options] CNF files or directories"
+desc = """Measures propagations per second during search, e.g. to compare a
+build with -DWATCH_TWO_BLOCKERS=ON against one without:
+
+   ./prop_benchmark.py --solver ../build/cryptominisat \\
+       --solver2 ../build_2blk/cryptominisat --maxconfl 50000 ~/cnfs/
+"""
+
+parser = optparse.OptionParser(usage=usage, description=desc)
+parser.add_option("--solver", dest="solver", default="../build/cryptominisat",
+                  help="Solver executable. Default: %default")
+parser.add_option("--solver2", dest="solver2", default=None,
+                  help="Second solver executable to compare against")
+parser.add_option("--maxconfl", dest="maxconfl", default=50000, type=int,
+                  help="Conflicts to run each instance for. Default: %default")
+parser.add_option("--repeat", dest="repeat", default=1, type=int,
+                  help="Runs per instance, the best one counts. Default: %default")
+parser.add_option("--extraopts", dest="extraopts", default="",
+                  help="Extra options to pass to the solver(s)")
+
+# First "c Mprops" line is that of the search, "(X / sec)" is in millions
+mprops_re = re.compile(r"^c Mprops\s*:\s*\S+\s*\(\s*(\S+)\s*/ sec\)")
+
+
+def mprops_per_sec(solver, fname, options):
+    command = [solver, "--threads", "1", "--verbstat", "1",
+               "--maxconfl", str(options.maxconfl)]
+    command += options.extraopts.split()
+    command.append(fname)
+
+    best = None
+    for _ in range(options.repeat):
+        p = subprocess.Popen(command, stdout=subprocess.PIPE,
+                             universal_newlines=True)
+        out = p.communicate()[0]
+        for line in out.split("\n"):
+            m = mprops_re.match(line)
+            if m:
+                val = float(m.group(1))
+                if best is None or val > best:
+                    best = val
+                break
+
+    return best
+
+
+def collect_files(args):
+    files = []
+    for arg in args:
+        if os.path.isdir(arg):
+            files += sorted(glob.glob(os.path.join(arg, "*.cnf")))
+            files += sorted(glob.glob(os.path.join(arg, "*.cnf.gz")))
+        else:
+            files.append(arg)
+    return files
+
+
+def geomean(vals):
+    vals = [v for v in vals if v is not None and v > 0]
+    if not vals:
+        return 0.0
+    return math.exp(sum(math.log(v) for v in vals) / len(vals))
+
+
+if __name__ == "__main__":
+    (options, args) = parser.parse_args()
+    files = collect_files(args)
+    if not files:
+        parser.error("no CNF files given")
+
+    solvers = [options.solver]
+    if options.solver2:
+        solvers.append(options.solver2)
+
+    results = [[] for _ in solvers]
+    for fname in files:
+        line = "%-40s" % os.path.basename(fname)
+        for i, solver in enumerate(solvers):
+            val = mprops_per_sec(solver, fname, options)
+            results[i].append(val)
+            line += " %10s" % ("-" if val is None else "%.2f" % val)
+
+        if len(solvers) == 2 and results[0][-1] and results[1][-1]:
+            line += " %8.3fx" % (results[1][-1] / results[0][-1])
+        print(line)
+
+    line = "%-40s" % "geometric mean (Mprops/s)"
+    for res in results:
+        line += " %10.2f" % geomean(res)
+    if len(solvers) == 2 and geomean(results[0]) > 0:
+        line += " %8.3fx" % (geomean(results[1]) / geomean(results[0]))
+    print(line)
@@ -196,6 +196,7 @@ class Tester:
         cmd += "--compsfrom %d " % random.randint(0,2)
         cmd += "--compsvar %d " % random.randint(20000,500000)
         cmd += "--compslimit %d " % random.randint(0,3000)
+        cmd += "--compthreads %d " % random.randint(1,4)
         cmd += "--implicitmanip %s " % random.randint(0,1)
         cmd += "--occsimp %s " % random.randint(0,1)
         cmd += "--occirredmaxmb %s " % random.randint(0,10)
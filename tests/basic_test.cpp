@@ -1,6 +1,9 @@
 #define BOOST_TEST_MODULE basic_interface
 #include <boost/test/unit_test.hpp>
 #include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <chrono>
 
 #include "cryptominisat4/cryptominisat.h"
 #include "cryptominisat4/solverconf.h"
@@ -88,6 +91,472 @@ BOOST_AUTO_TEST_CASE(solve_multi_thread)
     BOOST_CHECK_EQUAL(s.get_model()[1], l_True);
 }
 
+BOOST_AUTO_TEST_CASE(solve_cube_and_conquer)
+{
+    SolverConf conf;
+    conf.cube_depth = 2;
+    SATSolver s(&conf);
+    s.set_num_threads(2);
+    s.new_vars(3);
+    s.add_clause(vector<Lit>{Lit(0, false), Lit(1, false)});
+    s.add_clause(vector<Lit>{Lit(1, true), Lit(2, false)});
+    lbool ret = s.solve();
+    BOOST_CHECK_EQUAL( ret, l_True);
+
+    s.add_clause(vector<Lit>{Lit(0, true)});
+    ret = s.solve();
+    BOOST_CHECK_EQUAL( ret, l_True);
+    BOOST_CHECK_EQUAL(s.get_model()[0], l_False);
+    BOOST_CHECK_EQUAL(s.get_model()[1], l_True);
+    BOOST_CHECK_EQUAL(s.get_model()[2], l_True);
+}
+
+BOOST_AUTO_TEST_CASE(cube_and_conquer_unsat_assumps)
+{
+    SolverConf conf;
+    conf.cube_depth = 2;
+    SATSolver s(&conf);
+    s.set_num_threads(2);
+    s.new_vars(3);
+    s.add_clause(vector<Lit>{Lit(0, false), Lit(1, false)});
+    s.add_clause(vector<Lit>{Lit(0, false), Lit(1, true)});
+    vector<Lit> assumps{Lit(0, true), Lit(2, false)};
+    lbool ret = s.solve(&assumps);
+    BOOST_CHECK_EQUAL( ret, l_False);
+    BOOST_CHECK_EQUAL( s.okay(), true);
+    BOOST_CHECK_EQUAL( s.get_conflict().size(), 1);
+    BOOST_CHECK_EQUAL( s.get_conflict()[0], Lit(0, false));
+
+    ret = s.solve();
+    BOOST_CHECK_EQUAL( ret, l_True);
+    BOOST_CHECK_EQUAL(s.get_model()[0], l_True);
+}
+
+BOOST_AUTO_TEST_CASE(cube_depth_single_thread)
+{
+    //No cubes with one thread, the normal search must be used
+    SolverConf conf;
+    conf.cube_depth = 2;
+    SATSolver s(&conf);
+    s.new_vars(3);
+    s.add_clause(vector<Lit>{Lit(0, false), Lit(1, false)});
+    s.add_clause(vector<Lit>{Lit(0, false), Lit(1, true)});
+    vector<Lit> assumps{Lit(0, true), Lit(2, false)};
+    lbool ret = s.solve(&assumps);
+    BOOST_CHECK_EQUAL( ret, l_False);
+    BOOST_CHECK_EQUAL( s.get_conflict().size(), 1);
+    BOOST_CHECK_EQUAL( s.get_conflict()[0], Lit(0, false));
+
+    ret = s.solve();
+    BOOST_CHECK_EQUAL( ret, l_True);
+    BOOST_CHECK_EQUAL(s.get_model()[0], l_True);
+}
+
+BOOST_AUTO_TEST_CASE(add_clauses_flat)
+{
+    SATSolver s;
+    s.new_vars(2);
+    vector<Lit> cls{
+        Lit(0, false), Lit(1, false), lit_Undef
+        , Lit(0, true), lit_Undef
+    };
+    s.add_clauses(cls.data(), cls.size());
+    lbool ret = s.solve();
+    BOOST_CHECK_EQUAL( ret, l_True);
+    BOOST_CHECK_EQUAL( s.get_model()[0], l_False);
+    BOOST_CHECK_EQUAL( s.get_model()[1], l_True);
+}
+
+BOOST_AUTO_TEST_CASE(add_clauses_csr_unsat_multi_thread)
+{
+    SATSolver s;
+    s.set_num_threads(2);
+    s.new_vars(2);
+    vector<Lit> lits{
+        Lit(0, false), Lit(1, false)
+        , Lit(0, true), Lit(1, false)
+        , Lit(0, false), Lit(1, true)
+        , Lit(0, true), Lit(1, true)
+    };
+    vector<size_t> offsets{0, 2, 4, 6, 8};
+    s.add_clauses(lits.data(), offsets.data(), 4);
+    lbool ret = s.solve();
+    BOOST_CHECK_EQUAL( ret, l_False);
+}
+
+BOOST_AUTO_TEST_CASE(add_xor_clauses)
+{
+    SATSolver s;
+    s.new_vars(3);
+    vector<unsigned> vars{0, 1, 1, 2, 2};
+    vector<size_t> offsets{0, 2, 4, 5};
+    bool rhs[] = {true, false, true};
+    s.add_xor_clauses(vars.data(), offsets.data(), rhs, 3);
+    lbool ret = s.solve();
+    BOOST_CHECK_EQUAL( ret, l_True);
+    BOOST_CHECK_EQUAL( s.get_model()[0], l_False);
+    BOOST_CHECK_EQUAL( s.get_model()[1], l_True);
+    BOOST_CHECK_EQUAL( s.get_model()[2], l_True);
+}
+
+BOOST_AUTO_TEST_CASE(clause_group_remove)
+{
+    SATSolver s;
+    s.new_vars(2);
+    s.add_clause(vector<Lit>{Lit(0, false), Lit(1, false)});
+    unsigned g = s.new_clause_group();
+    s.add_clause(vector<Lit>{Lit(0, true)}, g);
+    s.add_clause(vector<Lit>{Lit(1, true)}, g);
+    lbool ret = s.solve();
+    BOOST_CHECK_EQUAL( ret, l_False);
+    BOOST_CHECK_EQUAL( s.get_conflict().size(), 1);
+    BOOST_CHECK_EQUAL( s.get_conflict()[0], ~s.get_clause_group_lit(g));
+    BOOST_CHECK( s.okay());
+
+    s.remove_clause_group(g);
+    ret = s.solve();
+    BOOST_CHECK_EQUAL( ret, l_True);
+}
+
+BOOST_AUTO_TEST_CASE(clause_group_many_solves)
+{
+    SATSolver s;
+    s.new_vars(10);
+    for(unsigned i = 0; i < 9; i++) {
+        s.add_clause(vector<Lit>{Lit(i, true), Lit(i+1, false)});
+    }
+    for(unsigned i = 0; i < 10; i++) {
+        unsigned g = s.new_clause_group();
+        s.add_clause(vector<Lit>{Lit(0, false)}, g);
+        s.add_clause(vector<Lit>{Lit(9-i, true)}, g);
+        lbool ret = s.solve();
+        BOOST_CHECK_EQUAL( ret, l_False);
+        s.remove_clause_group(g);
+    }
+    lbool ret = s.solve();
+    BOOST_CHECK_EQUAL( ret, l_True);
+}
+
+BOOST_AUTO_TEST_CASE(clause_group_multi_thread)
+{
+    SATSolver s;
+    s.set_num_threads(3);
+    s.new_vars(2);
+    unsigned g = s.new_clause_group();
+    unsigned g2 = s.new_clause_group();
+    s.add_clause(vector<Lit>{Lit(0, false)}, g);
+    s.add_clause(vector<Lit>{Lit(0, true)}, g2);
+    lbool ret = s.solve();
+    BOOST_CHECK_EQUAL( ret, l_False);
+
+    s.remove_clause_group(g2);
+    ret = s.solve();
+    BOOST_CHECK_EQUAL( ret, l_True);
+    BOOST_CHECK_EQUAL( s.get_model()[0], l_True);
+}
+
+BOOST_AUTO_TEST_CASE(frozen_vars_incremental)
+{
+    SolverConf conf;
+    conf.simplify_at_every_startup = true;
+    SATSolver s(&conf);
+    s.new_vars(30);
+    s.set_frozen(0);
+    for(unsigned i = 0; i < 29; i++) {
+        s.add_clause(vector<Lit>{Lit(i, true), Lit(i+1, false), Lit((i+2)%30, false)});
+        s.add_clause(vector<Lit>{Lit(i, true), Lit(i+1, false), Lit((i+2)%30, true)});
+    }
+    for(unsigned i = 0; i < 29; i++) {
+        vector<Lit> assumps{Lit(0, false), Lit(i+1, true)};
+        lbool ret = s.solve(&assumps);
+        BOOST_CHECK_EQUAL( ret, l_False);
+
+        //Adding to (possibly eliminated) vars brings them back
+        s.add_clause(vector<Lit>{Lit(i, false), Lit(29-i, false)});
+        ret = s.solve();
+        BOOST_CHECK_EQUAL( ret, l_True);
+        BOOST_CHECK( s.get_model()[i] == l_True || s.get_model()[29-i] == l_True);
+    }
+}
+
+//Adds the problem on new variables, after the ones already in the solver
+static void add_pigeonhole(SATSolver& s, const unsigned pigeons, const unsigned holes)
+{
+    const unsigned start = s.nVars();
+    s.new_vars(pigeons*holes);
+    for(unsigned p = 0; p < pigeons; p++) {
+        vector<Lit> cl;
+        for(unsigned h = 0; h < holes; h++) {
+            cl.push_back(Lit(start+p*holes+h, false));
+        }
+        s.add_clause(cl);
+    }
+    for(unsigned h = 0; h < holes; h++) {
+        for(unsigned p = 0; p < pigeons; p++) {
+            for(unsigned p2 = p+1; p2 < pigeons; p2++) {
+                s.add_clause(vector<Lit>{Lit(start+p*holes+h, true), Lit(start+p2*holes+h, true)});
+            }
+        }
+    }
+}
+
+//Same clauses for the same seed, on every platform
+static void add_random_3sat(SATSolver& s, const unsigned vars, const unsigned clauses, uint32_t seed)
+{
+    s.new_vars(vars);
+    for(unsigned i = 0; i < clauses; i++) {
+        vector<Lit> cl;
+        while(cl.size() < 3) {
+            seed = seed*1103515245U + 12345U;
+            const Lit lit((seed >> 8) % vars, (seed >> 30) & 1);
+            if (std::find(cl.begin(), cl.end(), lit) == cl.end()
+                && std::find(cl.begin(), cl.end(), ~lit) == cl.end()
+            ) {
+                cl.push_back(lit);
+            }
+        }
+        s.add_clause(cl);
+    }
+}
+
+static vector<lbool> solve_with_conf(SolverConf conf, const uint32_t seed)
+{
+    SATSolver s(&conf);
+    add_random_3sat(s, 200, 800, seed);
+    const lbool ret = s.solve();
+    vector<lbool> result(1, ret);
+    if (ret == l_True) {
+        result.insert(result.end(), s.get_model().begin(), s.get_model().end());
+    }
+    return result;
+}
+
+BOOST_AUTO_TEST_CASE(varelim_threads_same_result)
+{
+    for(uint32_t seed = 1; seed <= 3; seed++) {
+        SolverConf conf;
+        conf.varelim_threads = 1;
+        const vector<lbool> single = solve_with_conf(conf, seed);
+        conf.varelim_threads = 4;
+        conf.varelim_batch_size = 8;
+        const vector<lbool> multi_small = solve_with_conf(conf, seed);
+        conf.varelim_batch_size = 64;
+        const vector<lbool> multi = solve_with_conf(conf, seed);
+        BOOST_CHECK( single == multi);
+        BOOST_CHECK( multi_small[0] == single[0]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(subsume_threads_same_result)
+{
+    for(uint32_t seed = 1; seed <= 3; seed++) {
+        SolverConf conf;
+        conf.subsume_threads = 1;
+        const vector<lbool> single = solve_with_conf(conf, seed);
+        conf.subsume_threads = 4;
+        const vector<lbool> multi = solve_with_conf(conf, seed);
+        conf.subsume_batch_size = 5;
+        const vector<lbool> multi_small = solve_with_conf(conf, seed);
+        BOOST_CHECK( single == multi);
+        BOOST_CHECK( multi_small[0] == single[0]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(probe_threads)
+{
+    for(int hyperbin_and_cache = 0; hyperbin_and_cache < 2; hyperbin_and_cache++) {
+        vector<vector<lbool> > models;
+        for(unsigned threads: {1, 2, 4}) {
+            SolverConf conf;
+            conf.probe_threads = threads;
+            conf.full_simplify_at_startup = true;
+            conf.doIntreeProbe = false; //Would find the failed literals first
+            conf.otfHyperbin = hyperbin_and_cache;
+            conf.doCache = hyperbin_and_cache;
+            SATSolver s(&conf);
+            add_random_3sat(s, 200, 700, 5);
+
+            //Each of these 'a' is a failed literal: a -> b, c -> d -> ~a
+            s.new_vars(40);
+            for(unsigned a = 200; a < 240; a += 4) {
+                s.add_clause(vector<Lit>{Lit(a, true), Lit(a+1, false)});
+                s.add_clause(vector<Lit>{Lit(a, true), Lit(a+2, false)});
+                s.add_clause(vector<Lit>{Lit(a+1, true), Lit(a+2, true), Lit(a+3, false)});
+                s.add_clause(vector<Lit>{Lit(a+3, true), Lit(a, true), Lit(a-200, false)});
+                s.add_clause(vector<Lit>{Lit(a+3, true), Lit(a, true), Lit(a-200, true)});
+            }
+            BOOST_CHECK_EQUAL( s.solve(), l_True);
+            for(unsigned a = 200; a < 240; a += 4) {
+                BOOST_CHECK_EQUAL( s.get_model()[a], l_False);
+            }
+            models.push_back(s.get_model());
+        }
+
+        //The parallel pass does not depend on the number of threads
+        BOOST_CHECK( models[1] == models[2]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(branch_strategies)
+{
+    for(BranchStrategy strategy: {branch_vsids, branch_vmtf, branch_chb}) {
+        SolverConf conf;
+        conf.branch_strategy = strategy;
+        SATSolver s(&conf);
+        add_pigeonhole(s, 7, 6);
+        BOOST_CHECK_EQUAL( s.solve(), l_False);
+
+        SATSolver s2(&conf);
+        add_pigeonhole(s2, 6, 6);
+        BOOST_CHECK_EQUAL( s2.solve(), l_True);
+        for(unsigned p = 0; p < 6; p++) {
+            unsigned in_holes = 0;
+            for(unsigned h = 0; h < 6; h++) {
+                in_holes += s2.get_model()[p*6+h] == l_True;
+            }
+            BOOST_CHECK_EQUAL( in_holes >= 1, true);
+        }
+
+        //New variables after search are picked up by the heuristic, too
+        s2.new_vars(10);
+        for(unsigned i = 0; i < 9; i++) {
+            s2.add_clause(vector<Lit>{Lit(36+i, true), Lit(36+i+1, false)});
+        }
+        vector<Lit> assumps{Lit(36, false)};
+        BOOST_CHECK_EQUAL( s2.solve(&assumps), l_True);
+        BOOST_CHECK_EQUAL( s2.get_model()[45], l_True);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(trail_reuse_restarts)
+{
+    for(Restart rest: {restart_type_glue, restart_type_agility, restart_type_glue_agility}) {
+        SolverConf conf;
+        conf.restartType = rest;
+        conf.do_trail_reuse = true;
+        conf.trail_reuse_max_in_row = 5;
+        SATSolver s(&conf);
+        add_pigeonhole(s, 7, 6);
+        BOOST_CHECK_EQUAL( s.solve(), l_False);
+
+        for(uint32_t seed = 1; seed <= 3; seed++) {
+            SATSolver s2(&conf);
+            add_random_3sat(s2, 200, 800, seed);
+            conf.do_trail_reuse = false;
+            const vector<lbool> without = solve_with_conf(conf, seed);
+            conf.do_trail_reuse = true;
+            BOOST_CHECK_EQUAL( s2.solve(), without[0]);
+
+            //Assumptions are kept at the bottom of the reused trail
+            vector<Lit> assumps{Lit(0, false), Lit(1, true), Lit(2, false)};
+            const lbool ret = s2.solve(&assumps);
+            if (ret == l_True) {
+                BOOST_CHECK_EQUAL( s2.get_model()[0], l_True);
+                BOOST_CHECK_EQUAL( s2.get_model()[1], l_False);
+                BOOST_CHECK_EQUAL( s2.get_model()[2], l_True);
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(components_multi_thread)
+{
+    for(unsigned threads: {1, 4}) {
+        SolverConf conf;
+        conf.comp_threads = threads;
+        conf.full_simplify_at_startup = true;
+
+        //Disconnected 6-pigeon problems with more and more holes
+        SATSolver s(&conf);
+        for(unsigned i = 0; i < 8; i++) {
+            add_pigeonhole(s, 6, 6+i%3);
+        }
+        BOOST_CHECK_EQUAL( s.solve(), l_True);
+        unsigned start = 0;
+        for(unsigned i = 0; i < 8; i++) {
+            const unsigned holes = 6+i%3;
+            for(unsigned h = 0; h < holes; h++) {
+                unsigned in_hole = 0;
+                for(unsigned p = 0; p < 6; p++) {
+                    in_hole += s.get_model()[start+p*holes+h] == l_True;
+                }
+                BOOST_CHECK( in_hole <= 1);
+            }
+            for(unsigned p = 0; p < 6; p++) {
+                unsigned in_holes = 0;
+                for(unsigned h = 0; h < holes; h++) {
+                    in_holes += s.get_model()[start+p*holes+h] == l_True;
+                }
+                BOOST_CHECK( in_holes >= 1);
+            }
+            start += 6*holes;
+        }
+
+        //One component is UNSAT
+        SATSolver s2(&conf);
+        for(unsigned i = 0; i < 8; i++) {
+            add_pigeonhole(s2, 6, (i == 5) ? 5 : 6);
+        }
+        BOOST_CHECK_EQUAL( s2.solve(), l_False);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(max_time_wall)
+{
+    SolverConf conf;
+    conf.maxTime = 1;
+    conf.maxTimeIsWall = true;
+    SATSolver s(&conf);
+    add_pigeonhole(s, 13, 12);
+    const auto start = std::chrono::steady_clock::now();
+    BOOST_CHECK_EQUAL( s.solve(), l_Undef);
+    const double took = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    BOOST_CHECK( took < 20);
+}
+
+BOOST_AUTO_TEST_CASE(max_time_multi_thread_undef)
+{
+    SolverConf conf;
+    conf.maxTime = 1;
+    SATSolver s(&conf);
+    s.set_num_threads(2);
+    add_pigeonhole(s, 13, 12);
+    BOOST_CHECK_EQUAL( s.solve(), l_Undef);
+}
+
+BOOST_AUTO_TEST_CASE(cube_and_conquer_unsat)
+{
+    //All cubes refuted without assumptions: the instance itself is UNSAT
+    SolverConf conf;
+    conf.cube_depth = 3;
+    SATSolver s(&conf);
+    s.set_num_threads(2);
+    add_pigeonhole(s, 7, 6);
+    BOOST_CHECK_EQUAL( s.solve(), l_False);
+    BOOST_CHECK_EQUAL( s.okay(), false);
+    BOOST_CHECK_EQUAL( s.solve(), l_False);
+}
+
+BOOST_AUTO_TEST_CASE(chrono_backtrack)
+{
+    SolverConf conf;
+    conf.diff_declev_for_chrono = 0;
+    SATSolver s(&conf);
+    add_pigeonhole(s, 7, 6);
+    BOOST_CHECK_EQUAL( s.solve(), l_False);
+
+    SATSolver s2(&conf);
+    add_pigeonhole(s2, 7, 7);
+    vector<Lit> assumps{Lit(0, false), Lit(8, false)};
+    BOOST_CHECK_EQUAL( s2.solve(&assumps), l_True);
+    BOOST_CHECK_EQUAL( s2.get_model()[0], l_True);
+    BOOST_CHECK_EQUAL( s2.get_model()[8], l_True);
+
+    assumps.push_back(Lit(14, false));
+    assumps.push_back(Lit(21, false));
+    BOOST_CHECK_EQUAL( s2.solve(&assumps), l_False);
+}
+
 BOOST_AUTO_TEST_CASE(logfile)
 {
     SATSolver* s = new SATSolver();
@@ -486,6 +955,108 @@ BOOST_AUTO_TEST_CASE(xor_norm_mix_unsat_multi_thread)
     BOOST_CHECK_EQUAL( s.nVars(), 3);
 }
 
+BOOST_AUTO_TEST_CASE(xor_gauss_chain)
+{
+    SolverConf conf;
+    conf.gaussconf.minMatrixRows = 1;
+    SATSolver s(&conf);
+    const unsigned n = 41;
+    s.new_vars(n);
+    for(unsigned i = 0; i+2 < n; i++) {
+        s.add_xor_clause(vector<Var>{i, i+1, i+2}, i % 3 == 0);
+    }
+    lbool ret = s.solve();
+    BOOST_CHECK_EQUAL( ret, l_True);
+    for(unsigned i = 0; i+2 < n; i++) {
+        const bool par = (s.get_model()[i] == l_True)
+            ^ (s.get_model()[i+1] == l_True)
+            ^ (s.get_model()[i+2] == l_True);
+        BOOST_CHECK_EQUAL( par, i % 3 == 0);
+    }
+
+    //Odd cycle of inequalities
+    for(unsigned i = 0; i < n; i++) {
+        s.add_xor_clause(vector<Var>{i, (i+1) % n}, true);
+    }
+    ret = s.solve();
+    BOOST_CHECK_EQUAL( ret, l_False);
+}
+
+BOOST_AUTO_TEST_CASE(xor_native_long)
+{
+    SolverConf conf;
+    conf.gaussconf.decision_until = 0;
+    SATSolver s(&conf);
+    s.new_vars(10);
+    s.add_xor_clause(vector<Var>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}, true);
+    s.add_xor_clause(vector<Var>{0, 2, 4, 6, 8}, true);
+    vector<Lit> assumps;
+    for(unsigned i = 0; i < 9; i++) {
+        assumps.push_back(Lit(i, i % 4 != 0));
+    }
+    lbool ret = s.solve(&assumps);
+    BOOST_CHECK_EQUAL( ret, l_True);
+    BOOST_CHECK_EQUAL( s.get_model()[9], l_False);
+
+    //An even number of the even vars cannot be TRUE
+    assumps.clear();
+    for(unsigned i = 0; i < 10; i += 2) {
+        assumps.push_back(Lit(i, i > 2));
+    }
+    ret = s.solve(&assumps);
+    BOOST_CHECK_EQUAL( ret, l_False);
+
+    s.add_clause(vector<Lit>{Lit(9, false)});
+    s.add_xor_clause(vector<Var>{1, 3, 5, 7}, false);
+    ret = s.solve();
+    BOOST_CHECK_EQUAL( ret, l_False);
+}
+
+BOOST_AUTO_TEST_CASE(xor_native_dump_irred)
+{
+    SolverConf conf;
+    conf.do_bva = 0;
+    SATSolver s(&conf);
+    s.new_vars(12);
+    s.add_xor_clause(vector<Var>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10}, true);
+    s.add_clause(vector<Lit>{Lit(11, false), Lit(0, false)});
+    BOOST_CHECK_EQUAL( s.solve(), l_True);
+    s.open_file_and_dump_irred_clauses("testfile");
+
+    //The dump must be equisatisfiable: re-solve it
+    SATSolver s2;
+    std::ifstream infile("testfile");
+    std::string line;
+    vector<Lit> cl;
+    while(std::getline(infile, line)) {
+        if (line.empty() || line[0] == 'c' || line[0] == 'p') {
+            continue;
+        }
+        std::istringstream ss(line);
+        int lit;
+        cl.clear();
+        while(ss >> lit && lit != 0) {
+            const unsigned var = std::abs(lit)-1;
+            if (var >= s2.nVars()) {
+                s2.new_vars(var+1-s2.nVars());
+            }
+            cl.push_back(Lit(var, lit < 0));
+        }
+        s2.add_clause(cl);
+    }
+    BOOST_REQUIRE( s2.nVars() >= 12);
+
+    vector<Lit> assumps;
+    for(unsigned i = 0; i < 11; i++) {
+        assumps.push_back(Lit(i, i != 3));
+    }
+    BOOST_CHECK_EQUAL( s2.solve(&assumps), l_True);
+
+    //Even number of TRUE vars
+    assumps[4] = Lit(4, false);
+    BOOST_CHECK_EQUAL( s2.solve(&assumps), l_False);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE( learnt_interface )